@@ -6,6 +6,7 @@ Demonstrates:
   - Connecting to a hub
   - Requesting a user's file list
   - Browsing the file list directory structure
+  - Listing a whole subtree in one walk
   - Downloading individual files or entire directories from the list
   - Managing file list lifecycle (open/close)
 
@@ -68,6 +69,7 @@ def browse_interactive(client: DCClient, file_list_id: str) -> None:
         print("  /            — Go to root")
         print("  dl <number>  — Download a file")
         print("  dldir <num>  — Download entire directory")
+        print("  tree         — List everything under this directory")
         print("  q            — Quit browser")
         print()
 
@@ -83,6 +85,13 @@ def browse_interactive(client: DCClient, file_list_id: str) -> None:
                 cwd = "/".join(cwd.rstrip("/").split("/")[:-1]) or "/"
         elif cmd == "/":
             cwd = "/"
+        elif cmd == "tree":
+            count = 0
+            for entry in client.walk_file_list(file_list_id, cwd):
+                suffix = "/" if entry.isDirectory else ""
+                print(f"  {entry.path}{suffix}  ({format_size(entry.size)})")
+                count += 1
+            print(f"\n  {count} entries")
         elif cmd.startswith("dl "):
             try:
                 idx = int(cmd[3:]) - 1
@@ -475,6 +475,21 @@ class RemoteDCClient:
         except httpx.HTTPStatusError:
             return False
 
+    async def queue_search_async(self, query: str, file_type: int = 0,
+                                 size_mode: int = 0, size: int = 0,
+                                 hub_url: str = "",
+                                 priority: int = 0) -> str:
+        """Queue a search paced by hub search intervals; returns its token."""
+        try:
+            data = await self._post("/api/search", {
+                "query": query, "file_type": file_type,
+                "size_mode": size_mode, "size": size, "hub_url": hub_url,
+                "queued": True, "priority": priority,
+            })
+            return data.get("token", "")
+        except httpx.HTTPStatusError:
+            return ""
+
     def get_search_results(self, hub_url: str = "") -> list[SearchResultInfo]:
         raise TypeError("Use await get_search_results_async()")
 
@@ -93,6 +93,26 @@ class HubList(BaseModel):
     total: int
 
 
+class HubMemory(BaseModel):
+    """Approximate memory held by one hub's users, chat and results."""
+    url: str
+    hub_id: int = 0
+    user_count: int = 0
+    users_dropped: int = 0
+    user_bytes: int = 0
+    chat_lines: int = 0
+    chat_bytes: int = 0
+    search_results: int = 0
+    search_bytes: int = 0
+    total_bytes: int = 0
+
+
+class HubMemoryList(BaseModel):
+    """Per-hub memory usage."""
+    hubs: list[HubMemory]
+    total_bytes: int
+
+
 # ============================================================================
 # Chat models
 # ============================================================================
@@ -116,6 +136,24 @@ class ChatHistory(BaseModel):
     messages: list[str]
 
 
+class ChatEntry(BaseModel):
+    """One structured chat line."""
+    seq: int
+    timestamp: int = 0
+    nick: str = ""
+    text: str
+    third_person: bool = False
+    is_private: bool = False
+
+
+class ChatHistorySince(BaseModel):
+    """Chat lines after a sequence number."""
+    hub_url: str
+    last_seq: int
+    gap: bool = False
+    entries: list[ChatEntry]
+
+
 # ============================================================================
 # User (DC user on hub) models
 # ============================================================================
@@ -153,6 +191,26 @@ class SearchRequest(BaseModel):
                            description="0=any,1=at least,2=at most,3=exact")
     size: int = Field(0, ge=0, description="Size filter in bytes")
     hub_url: str = Field("", description="Search only this hub (empty=all)")
+    queued: bool = Field(False, description="Pace by hub search intervals "
+                                            "instead of sending now")
+    priority: int = Field(0, description="Queued searches: higher goes first")
+
+
+class SearchStarted(BaseModel):
+    """A search was sent or queued."""
+    ok: bool = True
+    message: str = ""
+    token: str = Field("", description="Result token (queued searches)")
+
+
+class QueuedSearch(BaseModel):
+    """A search waiting for hubs' search intervals."""
+    token: str
+    query: str
+    file_type: int
+    priority: int
+    pending_hubs: list[str]
+    sent_hubs: int
 
 
 class SearchResult(BaseModel):
@@ -260,6 +318,11 @@ class SettingsBatch(BaseModel):
     settings: list[SettingSet]
 
 
+class SettingsValues(BaseModel):
+    """Several settings by name."""
+    settings: dict[str, str]
+
+
 # ============================================================================
 # Transfer / Status models
 # ============================================================================
@@ -272,6 +335,23 @@ class TransferStatsResponse(BaseModel):
     uploaded: int = 0
 
 
+class ActiveTransfer(BaseModel):
+    """One upload or download in progress."""
+    filename: str
+    nick: str = ""
+    hub_url: str = ""
+    size: int = 0
+    pos: int = 0
+    speed: int = 0
+    is_download: bool = True
+
+
+class ActiveTransferList(BaseModel):
+    """Transfers in progress."""
+    transfers: list[ActiveTransfer]
+    total: int
+
+
 class HashStatusResponse(BaseModel):
     """File hashing status."""
     current_file: str = ""
@@ -284,6 +364,8 @@ class SystemStatus(BaseModel):
     """Overall system status."""
     version: str
     initialized: bool
+    init_phase: str = "ready"      # none, loading, ready or failed
+    init_step: str = ""            # what is loading, or why it failed
     connected_hubs: int
     queue_size: int
     share_size: int
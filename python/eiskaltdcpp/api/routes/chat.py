@@ -4,6 +4,7 @@ Chat and messaging API routes.
 POST /api/chat/message — Send public chat message (admin)
 POST /api/chat/pm      — Send private message (admin)
 GET  /api/chat/history — Get chat history for a hub (readonly+)
+GET  /api/chat/history/since — Chat lines after a seq, for tailing (readonly+)
 """
 from __future__ import annotations
 
@@ -12,7 +13,9 @@ from fastapi import APIRouter, Depends, HTTPException, Query, status
 from eiskaltdcpp.api.auth import UserRecord
 from eiskaltdcpp.api.dependencies import get_dc_client, require_admin, require_readonly
 from eiskaltdcpp.api.models import (
+    ChatEntry,
     ChatHistory,
+    ChatHistorySince,
     ChatMessage,
     PrivateMessage,
     SuccessResponse,
@@ -77,3 +80,33 @@ async def get_chat_history(
     client = _require_client(client)
     messages = client.get_chat_history(hub_url, max_lines)
     return ChatHistory(hub_url=hub_url, messages=messages)
+
+
+@router.get(
+    "/history/since",
+    response_model=ChatHistorySince,
+    summary="Get chat lines after a sequence number",
+)
+async def get_chat_history_since(
+    hub_url: str = Query(..., description="Hub URL"),
+    since: int = Query(0, ge=0, description="last_seq of the previous call"),
+    max_entries: int = Query(0, ge=0, le=10000, description="0 = all"),
+    _user: UserRecord = Depends(require_readonly),
+    client=Depends(get_dc_client),
+) -> ChatHistorySince:
+    """Tail a hub's chat: pass the returned last_seq back as since."""
+    client = _require_client(client)
+    page = client.get_chat_history_since(hub_url, since, max_entries)
+    entries = [
+        ChatEntry(
+            seq=e.seq,
+            timestamp=e.timestamp,
+            nick=e.nick,
+            text=e.text,
+            third_person=e.thirdPerson,
+            is_private=e.isPrivate,
+        )
+        for e in page.entries
+    ]
+    return ChatHistorySince(hub_url=hub_url, last_seq=page.lastSeq,
+                            gap=page.gap, entries=entries)
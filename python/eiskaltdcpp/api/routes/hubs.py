@@ -4,6 +4,7 @@ Hub connection management API routes.
 POST   /api/hubs/connect    — Connect to a hub (admin)
 POST   /api/hubs/disconnect — Disconnect from a hub (admin)
 GET    /api/hubs            — List connected hubs (readonly+)
+GET    /api/hubs/memory     — Per-hub memory usage (readonly+)
 GET    /api/hubs/{url}/users — List users on a hub (readonly+)
 """
 from __future__ import annotations
@@ -20,6 +21,8 @@ from eiskaltdcpp.api.models import (
     HubConnect,
     HubDisconnect,
     HubList,
+    HubMemory,
+    HubMemoryList,
     HubStatus,
     SuccessResponse,
 )
@@ -92,6 +95,35 @@ async def list_hubs(
     return HubList(hubs=hubs, total=len(hubs))
 
 
+@router.get(
+    "/memory",
+    response_model=HubMemoryList,
+    summary="Per-hub memory usage",
+)
+async def hub_memory(
+    _user: UserRecord = Depends(require_readonly),
+    client=Depends(get_dc_client),
+) -> HubMemoryList:
+    """Approximate bytes each hub holds (any authenticated user)."""
+    client = _require_client(client)
+    hubs = []
+    for m in client.get_hub_memory_stats():
+        hubs.append(HubMemory(
+            url=getattr(m, "hubUrl", ""),
+            hub_id=getattr(m, "hubId", 0),
+            user_count=getattr(m, "userCount", 0),
+            users_dropped=getattr(m, "usersDropped", 0),
+            user_bytes=getattr(m, "userBytes", 0),
+            chat_lines=getattr(m, "chatLines", 0),
+            chat_bytes=getattr(m, "chatBytes", 0),
+            search_results=getattr(m, "searchResults", 0),
+            search_bytes=getattr(m, "searchBytes", 0),
+            total_bytes=getattr(m, "totalBytes", 0),
+        ))
+    return HubMemoryList(hubs=hubs,
+                         total_bytes=sum(h.total_bytes for h in hubs))
+
+
 @router.get(
     "/users",
     response_model=DCUserList,
@@ -3,7 +3,7 @@ Download queue management API routes.
 
 POST   /api/queue           — Add file to download queue (admin)
 POST   /api/queue/magnet    — Add magnet link (admin)
-GET    /api/queue           — List download queue (readonly+)
+GET    /api/queue           — List download queue, paged (readonly+)
 DELETE /api/queue/{target}  — Remove from queue (admin)
 PUT    /api/queue/{target}/priority — Set priority (admin)
 DELETE /api/queue           — Clear entire queue (admin)
@@ -87,14 +87,21 @@ async def add_magnet(
     summary="List download queue",
 )
 async def list_queue(
+    offset: int = Query(0, ge=0, description="Index of the first item"),
+    limit: int = Query(0, ge=0, description="Page size (0 = all)"),
     _user: UserRecord = Depends(require_readonly),
     client=Depends(get_dc_client),
 ) -> QueueList:
-    """List all items in the download queue (any authenticated user)."""
+    """List items in the download queue (any authenticated user).
+
+    Served from the bridge's queue mirror, so large queues never hold
+    up the core's download scheduling.  ``total`` is the size of the
+    whole queue, not of the page.
+    """
     client = _require_client(client)
-    raw = client.list_queue()
+    page = client.list_queue_page(offset, limit)
     items = []
-    for q in raw:
+    for q in page.items:
         items.append(QueueItemInfo(
             target=getattr(q, "target", str(q)),
             size=getattr(q, "size", 0),
@@ -102,7 +109,7 @@ async def list_queue(
             priority=getattr(q, "priority", 0),
             tth=getattr(q, "tth", ""),
         ))
-    return QueueList(items=items, total=len(items))
+    return QueueList(items=items, total=page.total)
 
 
 @router.delete(
@@ -1,7 +1,9 @@
 """
 Search API routes.
 
-POST   /api/search         — Start a search (admin)
+POST   /api/search         — Start or queue a search (admin)
+GET    /api/search/queue    — List queued searches (readonly+)
+DELETE /api/search/queue/{token} — Cancel a queued search (admin)
 GET    /api/search/results  — Get search results (readonly+)
 DELETE /api/search/results  — Clear search results (admin)
 """
@@ -12,9 +14,11 @@ from fastapi import APIRouter, Depends, HTTPException, Query, status
 from eiskaltdcpp.api.auth import UserRecord
 from eiskaltdcpp.api.dependencies import get_dc_client, require_admin, require_readonly
 from eiskaltdcpp.api.models import (
+    QueuedSearch,
     SearchRequest,
     SearchResult,
     SearchResults,
+    SearchStarted,
     SuccessResponse,
 )
 
@@ -32,16 +36,37 @@ def _require_client(client):
 
 @router.post(
     "",
-    response_model=SuccessResponse,
+    response_model=SearchStarted,
     summary="Start a search",
 )
 async def start_search(
     body: SearchRequest,
     _admin: UserRecord = Depends(require_admin),
     client=Depends(get_dc_client),
-) -> SuccessResponse:
-    """Start a search across connected hubs (admin only)."""
+) -> SearchStarted:
+    """Start a search across connected hubs (admin only).
+
+    With ``queued`` the search waits for each hub's search interval and
+    the response carries the token its results are filed under.
+    """
     client = _require_client(client)
+    if body.queued:
+        token = client.queue_search(
+            body.query,
+            file_type=body.file_type,
+            size_mode=body.size_mode,
+            size=body.size,
+            hub_url=body.hub_url,
+            priority=body.priority,
+        )
+        if not token:
+            raise HTTPException(
+                status_code=status.HTTP_400_BAD_REQUEST,
+                detail="Search not queued — no such hub?",
+            )
+        return SearchStarted(message=f"Search queued: {body.query}",
+                             token=token)
+
     ok = client.search(
         body.query,
         file_type=body.file_type,
@@ -54,7 +79,51 @@ async def start_search(
             status_code=status.HTTP_400_BAD_REQUEST,
             detail="Search failed — not connected to any hub?",
         )
-    return SuccessResponse(message=f"Search started: {body.query}")
+    return SearchStarted(message=f"Search started: {body.query}")
+
+
+@router.get(
+    "/queue",
+    response_model=list[QueuedSearch],
+    summary="List queued searches",
+)
+async def list_queued(
+    _user: UserRecord = Depends(require_readonly),
+    client=Depends(get_dc_client),
+) -> list[QueuedSearch]:
+    """Searches still waiting for a hub, in sending order."""
+    client = _require_client(client)
+    return [
+        QueuedSearch(
+            token=q.token,
+            query=q.query,
+            file_type=q.fileType,
+            priority=q.priority,
+            pending_hubs=list(q.pendingHubs),
+            sent_hubs=q.sentHubs,
+        )
+        for q in client.list_queued_searches()
+    ]
+
+
+@router.delete(
+    "/queue/{token}",
+    response_model=SuccessResponse,
+    summary="Cancel a queued search",
+)
+async def cancel_queued(
+    token: str,
+    _admin: UserRecord = Depends(require_admin),
+    client=Depends(get_dc_client),
+) -> SuccessResponse:
+    """Stop a queued search from reaching the remaining hubs (admin only)."""
+    client = _require_client(client)
+    if not client.cancel_queued_search(token):
+        raise HTTPException(
+            status_code=status.HTTP_404_NOT_FOUND,
+            detail=f"No queued search {token}",
+        )
+    return SuccessResponse(message=f"Cancelled {token}")
 
 
 @router.get(
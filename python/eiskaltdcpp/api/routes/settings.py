@@ -1,6 +1,7 @@
 """
 DC client settings API routes.
 
+GET  /api/settings        — Get several settings (readonly+)
 GET  /api/settings/{name} — Get a setting (readonly+)
 PUT  /api/settings/{name} — Set a setting (admin)
 POST /api/settings/batch  — Set multiple settings (admin)
@@ -9,7 +10,7 @@ POST /api/settings/networking — Rebind network listeners (admin)
 """
 from __future__ import annotations
 
-from fastapi import APIRouter, Depends, HTTPException, status
+from fastapi import APIRouter, Depends, HTTPException, Query, status
 
 from eiskaltdcpp.api.auth import UserRecord
 from eiskaltdcpp.api.dependencies import get_dc_client, require_admin, require_readonly
@@ -17,6 +18,7 @@ from eiskaltdcpp.api.models import (
     SettingGet,
     SettingSet,
     SettingsBatch,
+    SettingsValues,
     SuccessResponse,
 )
 
@@ -32,6 +34,21 @@ def _require_client(client):
     return client
 
 
+@router.get(
+    "",
+    response_model=SettingsValues,
+    summary="Get several DC client settings",
+)
+async def get_settings(
+    names: list[str] = Query(..., description="Setting names"),
+    _user: UserRecord = Depends(require_readonly),
+    client=Depends(get_dc_client),
+) -> SettingsValues:
+    """Get several settings in one call; unknown names are left out."""
+    client = _require_client(client)
+    return SettingsValues(settings=client.get_settings(names))
+
+
 @router.get(
     "/{name}",
     response_model=SettingGet,
@@ -61,7 +78,11 @@ async def set_setting(
 ) -> SuccessResponse:
     """Set a DC client setting (admin only)."""
     client = _require_client(client)
-    client.set_setting(name, body.value)
+    if not client.set_setting(name, body.value):
+        raise HTTPException(
+            status_code=status.HTTP_400_BAD_REQUEST,
+            detail=f"Unknown setting '{name}' or invalid value",
+        )
     return SuccessResponse(message=f"Setting '{name}' updated")
 
 
@@ -75,12 +96,15 @@ async def batch_settings(
     _admin: UserRecord = Depends(require_admin),
     client=Depends(get_dc_client),
 ) -> SuccessResponse:
-    """Set multiple DC client settings at once (admin only)."""
+    """Set multiple DC client settings at once (admin only).
+
+    Applied together with a single config write; unknown names and
+    invalid values are skipped.
+    """
     client = _require_client(client)
-    for s in body.settings:
-        client.set_setting(s.name, s.value)
+    applied = client.set_settings({s.name: s.value for s in body.settings})
     return SuccessResponse(
-        message=f"Updated {len(body.settings)} settings"
+        message=f"Updated {applied} of {len(body.settings)} settings"
     )
 
 
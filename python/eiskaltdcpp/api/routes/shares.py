@@ -4,10 +4,12 @@ Share management API routes.
 POST   /api/shares          — Add share directory (admin)
 DELETE /api/shares           — Remove share directory (admin)
 GET    /api/shares           — List shared directories (readonly+)
-POST   /api/shares/refresh   — Refresh file hash list (admin)
+POST   /api/shares/refresh   — Refresh the share, or one directory (admin)
 """
 from __future__ import annotations
 
+import asyncio
+
 from fastapi import APIRouter, Depends, HTTPException, status
 
 from eiskaltdcpp.api.auth import UserRecord
@@ -108,10 +110,22 @@ async def list_shares(
     summary="Refresh shared file lists",
 )
 async def refresh_share(
+    path: str = "",
     _admin: UserRecord = Depends(require_admin),
     client=Depends(get_dc_client),
 ) -> SuccessResponse:
-    """Refresh shared file hash lists (admin only)."""
+    """Refresh shared file hash lists (admin only).
+
+    With ``path``, only the share root holding it is rescanned.
+    """
     client = _require_client(client)
+    if path:
+        # Walks the root on the calling thread; keep it off the loop
+        if not await asyncio.to_thread(client.refresh_share_dir, path):
+            raise HTTPException(
+                status_code=status.HTTP_404_NOT_FOUND,
+                detail=f"Not in share: {path}",
+            )
+        return SuccessResponse(message=f"Refreshing {path}")
     client.refresh_share()
     return SuccessResponse(message="Share refresh started")
@@ -3,8 +3,10 @@ System status and health API routes.
 
 GET /api/status         — System status overview (readonly+)
 GET /api/status/transfers — Transfer statistics (readonly+)
+GET /api/status/transfers/active — Transfers in progress (readonly+)
 GET /api/status/hashing  — Hashing status (readonly+)
 POST /api/status/hashing/pause — Pause/resume hashing (admin)
+GET /api/status/metrics  — Bridge metrics, Prometheus text format (readonly+)
 POST /api/shutdown       — Graceful server shutdown (admin)
 GET /api/health          — Health check (public, no auth)
 """
@@ -16,6 +18,7 @@ import signal
 import time
 
 from fastapi import APIRouter, Depends, HTTPException, status
+from fastapi.responses import PlainTextResponse
 
 from eiskaltdcpp.api.auth import UserRecord
 from eiskaltdcpp.api.dependencies import (
@@ -25,6 +28,8 @@ from eiskaltdcpp.api.dependencies import (
     require_readonly,
 )
 from eiskaltdcpp.api.models import (
+    ActiveTransfer,
+    ActiveTransferList,
     HashStatusResponse,
     SuccessResponse,
     SystemStatus,
@@ -68,6 +73,7 @@ async def get_status(
         return SystemStatus(
             version="unknown",
             initialized=False,
+            init_phase="none",
             connected_hubs=0,
             queue_size=0,
             share_size=0,
@@ -75,6 +81,34 @@ async def get_status(
             uptime_seconds=time.time() - start_time if start_time else 0,
         )
 
+    if not client.is_initialized:
+        # Still loading in the background (or failed): answer without
+        # waiting on the core
+        return SystemStatus(
+            version=client.version,
+            initialized=False,
+            init_phase=client.init_phase,
+            init_step=client.init_step,
+            connected_hubs=0,
+            queue_size=0,
+            share_size=0,
+            shared_files=0,
+            uptime_seconds=time.time() - start_time if start_time else 0,
+        )
+
+    snap = client.status_snapshot
+    if getattr(snap, "seq", 0):
+        return SystemStatus(
+            version=client.version,
+            initialized=client.is_initialized,
+            connected_hubs=snap.connectedHubs,
+            queue_size=snap.queueItems,
+            share_size=snap.shareSize,
+            shared_files=snap.sharedFiles,
+            uptime_seconds=time.time() - start_time if start_time else 0,
+        )
+
+    # No timer tick yet since initialize()
     hubs = client.list_hubs()
     queue = client.list_queue()
     return SystemStatus(
@@ -108,6 +142,32 @@ async def get_transfers(
     )
 
 
+@router.get(
+    "/api/status/transfers/active",
+    response_model=ActiveTransferList,
+    summary="Transfers in progress",
+)
+async def get_active_transfers(
+    _user: UserRecord = Depends(require_readonly),
+    client=Depends(get_dc_client),
+) -> ActiveTransferList:
+    """List every upload and download in progress (any authenticated user)."""
+    client = _require_client(client)
+    transfers = [
+        ActiveTransfer(
+            filename=getattr(t, "filename", ""),
+            nick=getattr(t, "nick", ""),
+            hub_url=getattr(t, "hubUrl", ""),
+            size=getattr(t, "size", 0),
+            pos=getattr(t, "pos", 0),
+            speed=getattr(t, "speed", 0),
+            is_download=getattr(t, "isDownload", True),
+        )
+        for t in client.active_transfers
+    ]
+    return ActiveTransferList(transfers=transfers, total=len(transfers))
+
+
 @router.get(
     "/api/status/hashing",
     response_model=HashStatusResponse,
@@ -145,6 +205,136 @@ async def pause_hashing(
     return SuccessResponse(message=f"Hashing {action}")
 
 
+def _prom_labels(**labels: str) -> str:
+    if not labels:
+        return ""
+    parts = []
+    for key, value in labels.items():
+        value = str(value).replace("\\", "\\\\").replace('"', '\\"')
+        parts.append(f'{key}="{value}"')
+    return "{" + ",".join(parts) + "}"
+
+
+def _prom_bound(bound: float) -> str:
+    return "+Inf" if bound == float("inf") else repr(bound)
+
+
+class _PromWriter:
+    """Accumulates metric families in the Prometheus text format."""
+
+    def __init__(self) -> None:
+        self.lines: list[str] = []
+
+    def family(self, name: str, kind: str, help_text: str) -> None:
+        self.lines.append(f"# HELP {name} {help_text}")
+        self.lines.append(f"# TYPE {name} {kind}")
+
+    def sample(self, name: str, value, **labels: str) -> None:
+        self.lines.append(f"{name}{_prom_labels(**labels)} {value}")
+
+    def histogram(self, name: str, hist: dict, **labels: str) -> None:
+        for bound, count in hist.get("buckets", []):
+            self.sample(f"{name}_bucket", count,
+                        **labels, le=_prom_bound(bound))
+        self.sample(f"{name}_sum", hist.get("sum", 0), **labels)
+        self.sample(f"{name}_count", hist.get("count", 0), **labels)
+
+    def text(self) -> str:
+        return "\n".join(self.lines) + "\n"
+
+
+def _render_metrics(m: dict) -> str:
+    w = _PromWriter()
+    events = m.get("events", {})
+    locks = m.get("locks", {})
+
+    for key, name, help_text in (
+        ("raised", "eiskaltdcpp_events_raised_total",
+         "Events produced by the core's listener callbacks."),
+        ("skipped", "eiskaltdcpp_events_skipped_total",
+         "Events dropped because they were masked or nobody listened."),
+        ("callbacks", "eiskaltdcpp_event_callbacks_total",
+         "Direct-mode callback invocations."),
+    ):
+        w.family(name, "counter", help_text)
+        for event, e in events.items():
+            w.sample(name, e.get(key, 0), event=event)
+
+    w.family("eiskaltdcpp_event_callback_duration_seconds", "histogram",
+             "Time spent in direct-mode event callbacks.")
+    for event, e in events.items():
+        w.histogram("eiskaltdcpp_event_callback_duration_seconds",
+                    e.get("callback_latency", {}), event=event)
+
+    w.family("eiskaltdcpp_lock_acquisitions_total", "counter",
+             "Bridge mutex acquisitions.")
+    for lock, lk in locks.items():
+        w.sample("eiskaltdcpp_lock_acquisitions_total",
+                 lk.get("acquisitions", 0), lock=lock)
+    w.family("eiskaltdcpp_lock_contended_total", "counter",
+             "Bridge mutex acquisitions that had to wait.")
+    for lock, lk in locks.items():
+        w.sample("eiskaltdcpp_lock_contended_total",
+                 lk.get("contended", 0), lock=lock)
+    w.family("eiskaltdcpp_lock_wait_seconds", "histogram",
+             "Time contended acquisitions waited for a bridge mutex.")
+    for lock, lk in locks.items():
+        w.histogram("eiskaltdcpp_lock_wait_seconds",
+                    lk.get("wait", {}), lock=lock)
+
+    ring = m.get("ring", {})
+    for key, name, kind, help_text in (
+        ("capacity", "eiskaltdcpp_event_ring_capacity", "gauge",
+         "Queued-dispatch ring capacity (0 in direct mode)."),
+        ("depth", "eiskaltdcpp_event_ring_depth", "gauge",
+         "Records waiting to be polled."),
+        ("queued", "eiskaltdcpp_event_ring_queued_total", "counter",
+         "Records accepted into the ring."),
+        ("dropped", "eiskaltdcpp_event_ring_dropped_total", "counter",
+         "Records rejected because the ring was full."),
+        ("polled", "eiskaltdcpp_event_ring_polled_total", "counter",
+         "Records handed out by poll_events."),
+    ):
+        w.family(name, kind, help_text)
+        w.sample(name, ring.get(key, 0))
+
+    for key, name, help_text in (
+        ("pending_user_events", "eiskaltdcpp_pending_user_events",
+         "Coalesced user events waiting for the next flush."),
+        ("held_coalesced_events", "eiskaltdcpp_held_coalesced_events",
+         "Events held back by a coalesce policy."),
+        ("search_results", "eiskaltdcpp_search_results",
+         "Search results kept across all sessions."),
+        ("queue_items", "eiskaltdcpp_queue_items",
+         "Items in the download queue."),
+        ("pending_file_list_loads", "eiskaltdcpp_pending_file_list_loads",
+         "File lists being parsed in the background."),
+        ("hubs", "eiskaltdcpp_hubs", "Hubs added to the bridge."),
+    ):
+        w.family(name, "gauge", help_text)
+        w.sample(name, m.get(key, 0))
+
+    return w.text()
+
+
+@router.get(
+    "/api/status/metrics",
+    response_class=PlainTextResponse,
+    summary="Bridge metrics (Prometheus)",
+)
+async def get_metrics(
+    _user: UserRecord = Depends(require_readonly),
+    client=Depends(get_dc_client),
+) -> PlainTextResponse:
+    """Event counters, callback latency and lock contention in the
+    Prometheus text exposition format (any authenticated user)."""
+    client = _require_client(client)
+    return PlainTextResponse(
+        _render_metrics(client.get_metrics()),
+        media_type="text/plain; version=0.0.4",
+    )
+
+
 logger = logging.getLogger(__name__)
 
 
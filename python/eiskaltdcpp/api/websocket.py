@@ -63,20 +63,31 @@ EVENT_CHANNELS: dict[str, set[Channel]] = {
     "user_connected": {Channel.hubs, Channel.events},
     "user_disconnected": {Channel.hubs, Channel.events},
     "user_updated": {Channel.hubs, Channel.events},
+    "users_updated": {Channel.hubs, Channel.events},
+    "users_connected": {Channel.hubs, Channel.events},
+    "users_removed": {Channel.hubs, Channel.events},
     # Search events
     "search_result": {Channel.search, Channel.events},
     # Queue events
     "queue_item_added": {Channel.transfers, Channel.events},
     "queue_item_finished": {Channel.transfers, Channel.events},
     "queue_item_removed": {Channel.transfers, Channel.events},
+    "queue_items_added": {Channel.transfers, Channel.events},
+    "queue_items_removed": {Channel.transfers, Channel.events},
     # Transfer events
     "download_starting": {Channel.transfers, Channel.events},
     "download_complete": {Channel.transfers, Channel.events},
     "download_failed": {Channel.transfers, Channel.events},
     "upload_starting": {Channel.transfers, Channel.events},
     "upload_complete": {Channel.transfers, Channel.events},
+    "transfer_progress": {Channel.transfers, Channel.events},
+    # File list events
+    "file_list_progress": {Channel.transfers, Channel.events},
+    "file_list_loaded": {Channel.transfers, Channel.events},
     # Hash events
     "hash_progress": {Channel.transfers, Channel.events},
+    # Lifecycle events
+    "core_ready": {Channel.status, Channel.events},
 }
 
 # Argument names for each event type (for serialization)
@@ -95,17 +106,26 @@ EVENT_ARG_NAMES: dict[str, tuple[str, ...]] = {
     "user_connected": ("hub_url", "nick"),
     "user_disconnected": ("hub_url", "nick"),
     "user_updated": ("hub_url", "nick"),
+    "users_updated": ("hub_url", "nicks"),
+    "users_connected": ("hub_url", "nicks"),
+    "users_removed": ("hub_url", "nicks"),
     "search_result": ("hub_url", "file", "size", "free_slots", "total_slots",
                        "tth", "nick", "is_directory"),
     "queue_item_added": ("target", "size", "tth"),
     "queue_item_finished": ("target", "size"),
     "queue_item_removed": ("target",),
+    "queue_items_added": ("targets",),
+    "queue_items_removed": ("targets",),
     "download_starting": ("target", "nick", "size"),
     "download_complete": ("target", "nick", "size", "speed"),
     "download_failed": ("target", "reason"),
     "upload_starting": ("file", "nick", "size"),
     "upload_complete": ("file", "nick", "size"),
+    "transfer_progress": ("transfers",),
+    "file_list_progress": ("file_list_id", "percent"),
+    "file_list_loaded": ("file_list_id", "success", "error"),
     "hash_progress": ("current_file", "files_left", "bytes_left"),
+    "core_ready": ("success", "error"),
 }
 
 
@@ -254,18 +274,23 @@ class ConnectionManager:
             while True:
                 await asyncio.sleep(5)
                 try:
-                    hubs = dc_client.list_hubs()
-                    queue = dc_client.list_queue()
-                    stats = dc_client.transfer_stats
+                    # One wait-free read of the bridge's per-second
+                    # snapshot, however many clients are subscribed
+                    snap = dc_client.status_snapshot
+                    if not getattr(snap, "seq", 0):
+                        continue
+                    stats = snap.transfers
                     message = {
                         "type": "status",
                         "data": {
-                            "connected_hubs": len(hubs),
-                            "queue_size": len(queue),
-                            "share_size": dc_client.share_size,
-                            "shared_files": dc_client.shared_files,
+                            "connected_hubs": snap.connectedHubs,
+                            "queue_size": snap.queueItems,
+                            "share_size": snap.shareSize,
+                            "shared_files": snap.sharedFiles,
                             "download_speed": getattr(stats, "downloadSpeed", 0),
                             "upload_speed": getattr(stats, "uploadSpeed", 0),
+                            "active_transfers": snap.activeTransfers,
+                            "hash_files_left": snap.hashing.filesLeft,
                         },
                         "timestamp": datetime.now(timezone.utc).isoformat(),
                     }
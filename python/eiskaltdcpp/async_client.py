@@ -23,7 +23,7 @@ import asyncio
 import logging
 import threading
 from pathlib import Path
-from typing import Any, Callable, Optional
+from typing import Any, AsyncIterator, Callable, Iterable, Mapping, Optional
 
 from eiskaltdcpp import dc_core
 from eiskaltdcpp.dc_client import EVENT_TYPES, DCClient
@@ -36,9 +36,12 @@ class AsyncDCClient:
     Async wrapper around DCClient.
 
     Bridges the C++ threaded callback model (SWIG directors) to asyncio.
-    All C++ callbacks are dispatched to the asyncio event loop via
-    ``loop.call_soon_threadsafe``, ensuring handlers run in the event
-    loop's thread without blocking.
+    By default events are queued in C++ and the loop watches the
+    bridge's wakeup descriptor (``loop.add_reader``), draining every
+    queued event in one call when it fires.  Without native dispatch
+    (or on loops that cannot watch descriptors) each C++ callback is
+    hopped into the loop via ``loop.call_soon_threadsafe`` instead.
+    Either way handlers run in the event loop's thread.
 
     The underlying C++ library manages its own threads for network I/O,
     timers, and hashing. This wrapper does NOT run those in an executor —
@@ -48,15 +51,31 @@ class AsyncDCClient:
         config_dir: Configuration directory for DC++ settings.
         loop: Event loop to dispatch callbacks to. Defaults to the
               running loop at initialization time.
+        native_dispatch: Deliver events through the C++ queue and its
+              wakeup descriptor rather than one loop wakeup per event.
+        queue_capacity: Ring size for native dispatch.  Events arriving
+              while it is full are dropped and counted.
     """
 
+    # Events drained per wakeup, so a flood cannot starve other tasks;
+    # the descriptor stays readable while more are queued.
+    DRAIN_BATCH = 5000
+
     def __init__(
         self,
         config_dir: str | Path = "",
         loop: Optional[asyncio.AbstractEventLoop] = None,
+        *,
+        native_dispatch: bool = True,
+        queue_capacity: int = 65536,
     ) -> None:
         self._sync_client = DCClient(config_dir)
         self._loop = loop
+        self._native_dispatch = native_dispatch
+        self._queue_capacity = queue_capacity
+        self._reader_fd = -1
+        self._drain_thread: Optional[int] = None
+        self._wired = False
         self._handlers: dict[str, list[Callable[..., Any]]] = {
             ev: [] for ev in EVENT_TYPES
         }
@@ -90,34 +109,67 @@ class AsyncDCClient:
     # Lifecycle
     # ------------------------------------------------------------------
 
-    async def initialize(self, *, timeout: float = 60.0) -> bool:
+    async def initialize(
+        self, *, timeout: float = 60.0, wait: bool = True
+    ) -> bool:
         """Initialize the DC core. Must be called before other operations.
 
+        The core loads on a C++ thread, so the loop keeps running (and an
+        API server keeps answering) meanwhile.
+
         Args:
             timeout: Maximum seconds to wait for C++ initialization.
                      Prevents hanging if dcpp::startup() blocks.
+            wait: If False, return once loading has started; watch
+                  ``core_ready`` or :attr:`init_phase` for the outcome.
         """
+        if self._sync_client.is_initialized:
+            return True
         loop = self._ensure_loop()
 
         # Wire up the internal sync client's callbacks to our async dispatch
-        self._wire_callbacks()
+        if not self._wired:
+            self._wire_callbacks()
+            self._wired = True
+        if self._native_dispatch:
+            self._start_native_dispatch(loop)
 
-        # initialize() does I/O (disk) so run in executor
-        ok = await asyncio.wait_for(
-            loop.run_in_executor(None, self._sync_client.initialize),
-            timeout=timeout,
-        )
-        return ok
+        ready: asyncio.Future[bool] = loop.create_future()
+
+        def _on_ready(success: bool, error: str) -> None:
+            if not ready.done():
+                ready.set_result(success)
+
+        self.on("core_ready", _on_ready)
+        try:
+            if not self._sync_client.initialize(background=True):
+                return False
+            if not wait:
+                return True
+            return await asyncio.wait_for(ready, timeout=timeout)
+        finally:
+            self.off("core_ready", _on_ready)
 
     async def shutdown(self) -> None:
         """Shut down the DC core — disconnects all hubs, saves state."""
         loop = self._ensure_loop()
         await loop.run_in_executor(None, self._sync_client.shutdown)
+        self._stop_native_dispatch(loop)
 
     @property
     def is_initialized(self) -> bool:
         return self._sync_client.is_initialized
 
+    @property
+    def init_phase(self) -> str:
+        """``none``, ``loading``, ``ready`` or ``failed``."""
+        return self._sync_client.init_phase
+
+    @property
+    def init_step(self) -> str:
+        """What startup is loading now, or why it failed."""
+        return self._sync_client.init_step
+
     @property
     def version(self) -> str:
         return self._sync_client.version
@@ -175,11 +227,59 @@ class AsyncDCClient:
             except (KeyError, ValueError):
                 pass
 
+    def set_event_mask(self, events: Optional[Iterable[str]] = None) -> None:
+        """Only let ``events`` cross from C++ into Python.
+
+        The async client subscribes to every event internally (waiters,
+        event streams), so nothing is masked unless set here.
+        ``None`` restores that default.
+        """
+        self._sync_client.set_event_mask(events)
+
+    def _start_native_dispatch(self, loop: asyncio.AbstractEventLoop) -> None:
+        """Switch the bridge to queued dispatch drained on readability."""
+        if self._reader_fd >= 0:
+            return
+        fd = self._sync_client.event_fd
+        if fd < 0:
+            return
+        try:
+            loop.add_reader(fd, self._drain_events)
+        except NotImplementedError:
+            # e.g. the Windows proactor loop
+            return
+        self._reader_fd = fd
+        self._sync_client.set_queued_dispatch(True, self._queue_capacity)
+
+    def _stop_native_dispatch(self, loop: asyncio.AbstractEventLoop) -> None:
+        """Deliver what is still queued and go back to direct dispatch."""
+        if self._reader_fd < 0:
+            return
+        loop.remove_reader(self._reader_fd)
+        self._reader_fd = -1
+        self._sync_client.set_queued_dispatch(False)
+        self._drain_events(0)
+
+    def _drain_events(self, max_events: int = DRAIN_BATCH) -> None:
+        """Reader callback: run queued events' handlers in this loop."""
+        self._drain_thread = threading.get_ident()
+        try:
+            self._sync_client.poll_events(max_events)
+        except Exception:
+            logger.exception("Error draining queued events")
+        finally:
+            self._drain_thread = None
+
     def _dispatch_event(self, event: str, *args: Any) -> None:
         """
-        Called from C++ callback threads. Schedules handler execution
-        in the asyncio event loop thread via call_soon_threadsafe.
+        Called from C++ callback threads, or from the loop thread while
+        draining queued events.  Off the loop, schedules handler
+        execution in the asyncio event loop thread via
+        call_soon_threadsafe.
         """
+        if self._drain_thread == threading.get_ident():
+            self._run_handlers(event, args)
+            return
         try:
             loop = self._ensure_loop()
         except RuntimeError:
@@ -313,6 +413,18 @@ class AsyncDCClient:
         def _on_user_upd(hub_url, nick):
             self._dispatch_event("user_updated", hub_url, nick)
 
+        @self._sync_client.on("users_updated")
+        def _on_users_upd(hub_url, nicks):
+            self._dispatch_event("users_updated", hub_url, nicks)
+
+        @self._sync_client.on("users_connected")
+        def _on_users_conn(hub_url, nicks):
+            self._dispatch_event("users_connected", hub_url, nicks)
+
+        @self._sync_client.on("users_removed")
+        def _on_users_rem(hub_url, nicks):
+            self._dispatch_event("users_removed", hub_url, nicks)
+
         @self._sync_client.on("search_result")
         def _on_search(hub_url, file, size, free, total, tth, nick, is_dir):
             self._dispatch_event(
@@ -336,6 +448,14 @@ class AsyncDCClient:
         def _on_qa(target, size, tth):
             self._dispatch_event("queue_item_added", target, size, tth)
 
+        @self._sync_client.on("queue_items_added")
+        def _on_qa_batch(targets):
+            self._dispatch_event("queue_items_added", targets)
+
+        @self._sync_client.on("queue_items_removed")
+        def _on_qr_batch(targets):
+            self._dispatch_event("queue_items_removed", targets)
+
         @self._sync_client.on("queue_item_finished")
         def _on_qf(target, size):
             self._dispatch_event("queue_item_finished", target, size)
@@ -390,12 +510,30 @@ class AsyncDCClient:
         def _on_uc(file, nick, size):
             self._dispatch_event("upload_complete", file, nick, size)
 
+        @self._sync_client.on("transfer_progress")
+        def _on_tp(transfers):
+            self._dispatch_event("transfer_progress", transfers)
+
+        @self._sync_client.on("file_list_progress")
+        def _on_flp(file_list_id, percent):
+            self._dispatch_event("file_list_progress", file_list_id, percent)
+
+        @self._sync_client.on("file_list_loaded")
+        def _on_fll(file_list_id, success, error):
+            self._dispatch_event(
+                "file_list_loaded", file_list_id, success, error
+            )
+
         @self._sync_client.on("hash_progress")
         def _on_hash(current_file, files_left, bytes_left):
             self._dispatch_event(
                 "hash_progress", current_file, files_left, bytes_left
             )
 
+        @self._sync_client.on("core_ready")
+        def _on_core_ready(success, error):
+            self._dispatch_event("core_ready", success, error)
+
     # ------------------------------------------------------------------
     # Hub connections (async)
     # ------------------------------------------------------------------
@@ -489,6 +627,34 @@ class AsyncDCClient:
         """List connected hubs."""
         return self._sync_client.list_hubs()
 
+    def get_hub_memory_stats(self) -> list:
+        """Approximate bytes each hub holds in users, chat and results."""
+        return self._sync_client.get_hub_memory_stats()
+
+    def set_hub_limits(
+        self,
+        max_users: int = 0,
+        max_chat_lines: int = 500,
+        max_results: int = 0,
+    ) -> None:
+        """Cap the users, chat lines and search results kept per hub."""
+        self._sync_client.set_hub_limits(
+            max_users, max_chat_lines, max_results)
+
+    @property
+    def hub_limits(self) -> Any:
+        """Current per-hub caps."""
+        return self._sync_client.hub_limits
+
+    def get_metrics(self) -> dict:
+        """Event, callback-latency and lock counters as plain data."""
+        return self._sync_client.get_metrics()
+
+    @property
+    def event_queue_stats(self) -> Any:
+        """Native-dispatch ring depth and queued/dropped/polled counters."""
+        return self._sync_client.event_queue_stats
+
     # ------------------------------------------------------------------
     # Chat (async)
     # ------------------------------------------------------------------
@@ -545,6 +711,48 @@ class AsyncDCClient:
         """Get recent chat history."""
         return self._sync_client.get_chat_history(hub_url, max_lines)
 
+    def get_chat_history_since(
+        self, hub_url: str, since: int = 0, max_entries: int = 0
+    ) -> Any:
+        """Get chat lines newer than ``since`` (a ChatHistoryPage)."""
+        return self._sync_client.get_chat_history_since(
+            hub_url, since, max_entries)
+
+    def set_chat_history_capacity(self, lines: int) -> None:
+        """Lines of chat kept per hub (default 500; 0 disables)."""
+        self._sync_client.set_chat_history_capacity(lines)
+
+    def enable_chat_log(
+        self,
+        directory: str | Path = "",
+        max_segment_bytes: int = 64 << 20,
+        max_segments: int = 0,
+        fsync_interval_ms: int = 1000,
+    ) -> bool:
+        """Log chat, PMs and status messages to disk in C++."""
+        return self._sync_client.enable_chat_log(
+            directory, max_segment_bytes, max_segments, fsync_interval_ms)
+
+    def disable_chat_log(self) -> None:
+        self._sync_client.disable_chat_log()
+
+    @property
+    def chat_log_enabled(self) -> bool:
+        return self._sync_client.chat_log_enabled
+
+    async def query_chat_log(
+        self,
+        hub_url: str = "",
+        since: int = 0,
+        until: int = 0,
+        max_entries: int = 0,
+    ) -> list:
+        """Logged lines received in ``[since, until)`` (runs in executor)."""
+        loop = self._ensure_loop()
+        return await loop.run_in_executor(
+            None, self._sync_client.query_chat_log,
+            hub_url, since, until, max_entries)
+
     # ------------------------------------------------------------------
     # Users
     # ------------------------------------------------------------------
@@ -557,6 +765,10 @@ class AsyncDCClient:
         """Get info about a specific user."""
         return self._sync_client.get_user(nick, hub_url)
 
+    def get_user_changes(self, hub_url: str, since: int = 0) -> Any:
+        """Get user joins, parts and updates since a revision."""
+        return self._sync_client.get_user_changes(hub_url, since)
+
     async def wait_user(
         self,
         hub_url: str,
@@ -657,10 +869,59 @@ class AsyncDCClient:
 
         return results
 
+    def start_search(
+        self,
+        query: str,
+        file_type: int = 0,
+        size_mode: int = 0,
+        size: int = 0,
+        hub_url: str = "",
+    ) -> str:
+        """Start a search and return its token."""
+        return self._sync_client.start_search(
+            query, file_type, size_mode, size, hub_url
+        )
+
+    def queue_search(
+        self,
+        query: str,
+        file_type: int = 0,
+        size_mode: int = 0,
+        size: int = 0,
+        hub_url: str = "",
+        priority: int = 0,
+    ) -> str:
+        """Queue a search paced by hub search intervals; returns its token."""
+        return self._sync_client.queue_search(
+            query, file_type, size_mode, size, hub_url, priority
+        )
+
+    def cancel_queued_search(self, token: str) -> bool:
+        """Drop a queued search."""
+        return self._sync_client.cancel_queued_search(token)
+
+    def list_queued_searches(self) -> list:
+        """Searches still waiting for a hub."""
+        return self._sync_client.list_queued_searches()
+
+    @property
+    def search_interval(self) -> int:
+        return self._sync_client.search_interval
+
+    def set_search_interval(self, seconds: int) -> None:
+        """Minimum seconds between queued searches to one hub."""
+        self._sync_client.set_search_interval(seconds)
+
     def get_search_results(self, hub_url: str = "") -> list:
         """Get accumulated search results."""
         return self._sync_client.get_search_results(hub_url)
 
+    def get_search_page(
+        self, token: str, offset: int = 0, limit: int = 100
+    ) -> list:
+        """Get one page of the results for a search token."""
+        return self._sync_client.get_search_page(token, offset, limit)
+
     def clear_search_results(self, hub_url: str = "") -> None:
         """Clear search results."""
         self._sync_client.clear_search_results(hub_url)
@@ -681,6 +942,16 @@ class AsyncDCClient:
         """Add a magnet link to the download queue."""
         return self._sync_client.download_magnet(magnet, download_dir)
 
+    def download_batch(self, items: Any) -> int:
+        """Add many (directory, name, size, tth) files in one call."""
+        return self._sync_client.download_batch(items)
+
+    def download_magnets(
+        self, magnets: list[str], download_dir: str = ""
+    ) -> int:
+        """Add many magnet links in one call."""
+        return self._sync_client.download_magnets(magnets, download_dir)
+
     async def download_and_wait(
         self,
         directory: str,
@@ -715,14 +986,34 @@ class AsyncDCClient:
         """Remove from download queue."""
         self._sync_client.remove_download(target)
 
+    def remove_downloads(self, targets: list[str]) -> int:
+        """Remove many items from the download queue."""
+        return self._sync_client.remove_downloads(targets)
+
+    def set_priority_batch(self, targets: list[str], priority: int) -> int:
+        """Set one priority on many queued items."""
+        return self._sync_client.set_priority_batch(targets, priority)
+
     def list_queue(self) -> list:
         """List download queue."""
         return self._sync_client.list_queue()
 
+    def list_queue_page(self, offset: int = 0, limit: int = 0) -> Any:
+        """Get one page of the download queue."""
+        return self._sync_client.list_queue_page(offset, limit)
+
+    def get_queue_changes(self, since: int = 0) -> Any:
+        """Get queue changes since a revision."""
+        return self._sync_client.get_queue_changes(since)
+
     def clear_queue(self) -> None:
         """Clear download queue."""
         self._sync_client.clear_queue()
 
+    def match_all_lists(self) -> int:
+        """Add indexed file lists as sources for queued files."""
+        return self._sync_client.match_all_lists()
+
     # ------------------------------------------------------------------
     # File lists (async)
     # ------------------------------------------------------------------
@@ -800,15 +1091,91 @@ class AsyncDCClient:
         return (fl_id, entries)
 
     def browse_file_list(
-        self, file_list_id: str, directory: str = "/"
+        self,
+        file_list_id: str,
+        directory: str = "/",
+        offset: int = 0,
+        limit: int = 0,
     ) -> list:
-        """Browse a directory in an opened file list."""
-        return self._sync_client.browse_file_list(file_list_id, directory)
+        """Browse a directory in an opened file list (optionally paged)."""
+        return self._sync_client.browse_file_list(
+            file_list_id, directory, offset, limit)
+
+    async def walk_file_list(
+        self,
+        file_list_id: str,
+        root: str = "/",
+        chunk_size: int = 1000,
+    ) -> AsyncIterator[list]:
+        """Yield chunks of every entry under ``root``, depth-first.
+
+        Each chunk is fetched on the default executor so a huge list does
+        not stall the event loop.
+        """
+        loop = self._ensure_loop()
+        chunks = self._sync_client.walk_file_list_chunks(
+            file_list_id, root, chunk_size)
+        while True:
+            chunk = await loop.run_in_executor(None, next, chunks, None)
+            if chunk is None:
+                return
+            yield chunk
+
+    async def search_file_lists(
+        self,
+        query: str,
+        file_type: int = 0,
+        size_mode: int = 0,
+        size: int = 0,
+        offset: int = 0,
+        limit: int = 100,
+        file_list_ids: Optional[Iterable[str]] = None,
+    ) -> Any:
+        """Search the names in opened file lists (runs in executor)."""
+        loop = self._ensure_loop()
+        return await loop.run_in_executor(
+            None, self._sync_client.search_file_lists,
+            query, file_type, size_mode, size, offset, limit, file_list_ids)
 
     def list_local_file_lists(self) -> list[str]:
         """List locally stored file lists."""
         return self._sync_client.list_local_file_lists()
 
+    async def load_file_list(
+        self, file_list_id: str, *, timeout: float = 120.0
+    ) -> None:
+        """
+        Open a file list on a background loader thread and wait for it.
+
+        The event loop keeps running while the list is parsed, and several
+        ``load_file_list`` calls may be awaited together (e.g. with
+        ``asyncio.gather``) to parse lists in parallel.
+
+        Raises:
+            RuntimeError: the list could not be loaded
+            asyncio.TimeoutError: not loaded within *timeout* seconds
+        """
+        loop = self._ensure_loop()
+        done: asyncio.Future = loop.create_future()
+
+        # Register before submitting — an already-open list reports
+        # file_list_loaded from inside open_file_list_async itself.
+        def _on_loaded(fl_id: str, success: bool, error: str) -> None:
+            if fl_id == file_list_id and not done.done():
+                done.set_result((success, error))
+
+        self.on("file_list_loaded", _on_loaded)
+        try:
+            if not self._sync_client.open_file_list_async(file_list_id):
+                raise RuntimeError("Client is not initialized")
+            success, error = await asyncio.wait_for(done, timeout=timeout)
+        finally:
+            self.off("file_list_loaded", _on_loaded)
+        if not success:
+            raise RuntimeError(
+                f"Failed to open file list {file_list_id}: {error}"
+            )
+
     def open_file_list(self, file_list_id: str) -> bool:
         """Open/parse a local file list."""
         return self._sync_client.open_file_list(file_list_id)
@@ -835,10 +1202,25 @@ class AsyncDCClient:
             file_list_id, dir_path, download_to
         )
 
+    def download_files_from_list(
+        self,
+        file_list_id: str,
+        paths: list[str],
+        download_to: str = "",
+    ) -> int:
+        """Queue many files and/or directories from one file list."""
+        return self._sync_client.download_files_from_list(
+            file_list_id, paths, download_to
+        )
+
     def close_file_list(self, file_list_id: str) -> None:
         """Close an opened file list."""
         self._sync_client.close_file_list(file_list_id)
 
+    def find_sources(self, tths: list[str]) -> dict[str, list[str]]:
+        """Look up TTHs across every downloaded file list."""
+        return self._sync_client.find_sources(tths)
+
     def close_all_file_lists(self) -> None:
         """Close all opened file lists."""
         self._sync_client.close_all_file_lists()
@@ -859,6 +1241,9 @@ class AsyncDCClient:
     def refresh_share(self) -> None:
         self._sync_client.refresh_share()
 
+    def refresh_share_dir(self, real_path: str) -> bool:
+        return self._sync_client.refresh_share_dir(real_path)
+
     @property
     def share_size(self) -> int:
         return self._sync_client.share_size
@@ -874,8 +1259,20 @@ class AsyncDCClient:
     def get_setting(self, name: str) -> str:
         return self._sync_client.get_setting(name)
 
-    def set_setting(self, name: str, value: str) -> None:
-        self._sync_client.set_setting(name, value)
+    def set_setting(self, name: str, value: str) -> bool:
+        return self._sync_client.set_setting(name, value)
+
+    def get_settings(self, names: Iterable[str]) -> dict[str, str]:
+        return self._sync_client.get_settings(names)
+
+    def set_settings(self, values: Mapping[str, Any]) -> int:
+        """Apply several settings with a single config write."""
+        return self._sync_client.set_settings(values)
+
+    async def save_settings(self) -> None:
+        """Write pending setting changes to disk now."""
+        loop = self._ensure_loop()
+        await loop.run_in_executor(None, self._sync_client.save_settings)
 
     def start_networking(self) -> None:
         """(Re)start the networking stack (connection listeners)."""
@@ -889,6 +1286,17 @@ class AsyncDCClient:
     def transfer_stats(self) -> Any:
         return self._sync_client.transfer_stats
 
+    @property
+    def status_snapshot(self) -> Any:
+        return self._sync_client.status_snapshot
+
+    @property
+    def active_transfers(self) -> list:
+        return self._sync_client.active_transfers
+
+    def set_transfer_progress_interval(self, interval_ms: int) -> None:
+        self._sync_client.set_transfer_progress_interval(interval_ms)
+
     @property
     def hash_status(self) -> Any:
         return self._sync_client.hash_status
@@ -896,6 +1304,16 @@ class AsyncDCClient:
     def pause_hashing(self, pause: bool = True) -> None:
         self._sync_client.pause_hashing(pause)
 
+    @property
+    def hash_speed_limit(self) -> int:
+        return self._sync_client.hash_speed_limit
+
+    def set_hash_speed_limit(self, mb_per_sec: int) -> None:
+        self._sync_client.set_hash_speed_limit(mb_per_sec)
+
+    def set_hash_progress_interval(self, interval_ms: int) -> None:
+        self._sync_client.set_hash_progress_interval(interval_ms)
+
     # ------------------------------------------------------------------
     # Lua scripting
     # ------------------------------------------------------------------
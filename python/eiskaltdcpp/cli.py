@@ -292,24 +292,13 @@ def _run_both(
 
         logger.info("Starting DC daemon + API (config: %s)", config_dir or "(default)")
 
-        async with AsyncDCClient(config_dir) as client:
-            if nick:
-                client.set_setting("Nick", nick)
-            if dc_password:
-                client.set_setting("Password", dc_password)
-
-            for hub_url in hubs:
-                logger.info("Connecting to %s", hub_url)
-                await client.connect(hub_url)
-
-            @client.on("hub_connected")
-            def on_connected(url, name):
-                logger.info("Connected to %s (%s)", name, url)
-
-            @client.on("hub_disconnected")
-            def on_disconnected(url, reason):
-                logger.warning("Disconnected from %s: %s", url, reason)
-
+        # Load the core in the background and start the API at once, so
+        # health checks answer during a long hash-index / queue load
+        client = AsyncDCClient(config_dir)
+        if not await client.initialize(wait=False):
+            logger.error("DC core failed to start")
+            return
+        try:
             # Start API server in a background thread
             api_thread = threading.Thread(
                 target=_run_api,
@@ -331,6 +320,27 @@ def _run_both(
             api_thread.start()
             logger.info("API server starting on %s:%d", host, port)
 
+            if not await client.initialize(timeout=600.0):
+                logger.error("DC core failed to start: %s", client.init_step)
+                return
+
+            if nick:
+                client.set_setting("Nick", nick)
+            if dc_password:
+                client.set_setting("Password", dc_password)
+
+            for hub_url in hubs:
+                logger.info("Connecting to %s", hub_url)
+                await client.connect(hub_url)
+
+            @client.on("hub_connected")
+            def on_connected(url, name):
+                logger.info("Connected to %s (%s)", name, url)
+
+            @client.on("hub_disconnected")
+            def on_disconnected(url, reason):
+                logger.warning("Disconnected from %s: %s", url, reason)
+
             # Wait for shutdown signal
             stop = asyncio.Event()
 
@@ -344,6 +354,8 @@ def _run_both(
 
             logger.info("DC daemon + API running — Ctrl-C or SIGTERM to stop")
             await stop.wait()
+        finally:
+            await client.shutdown()
 
         logger.info("Shutdown complete")
 
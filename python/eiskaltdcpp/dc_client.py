@@ -22,7 +22,7 @@ from __future__ import annotations
 import logging
 import threading
 from pathlib import Path
-from typing import Any, Callable, Optional
+from typing import Any, Callable, Iterable, Iterator, Mapping, Optional
 
 # Import SWIG module (built by CMake)
 try:
@@ -58,23 +58,233 @@ EVENT_TYPES = frozenset({
     "user_connected",
     "user_disconnected",
     "user_updated",
+    "users_updated",
+    "users_connected",
+    "users_removed",
     # Search events
     "search_result",
     # Queue events
     "queue_item_added",
     "queue_item_finished",
     "queue_item_removed",
+    "queue_items_added",
+    "queue_items_removed",
     # Transfer events
     "download_starting",
     "download_complete",
     "download_failed",
     "upload_starting",
     "upload_complete",
+    "transfer_progress",
+    # File list events
+    "file_list_progress",
+    "file_list_loaded",
     # Hash events
     "hash_progress",
+    # Lifecycle events
+    "core_ready",
 })
 
 
+def _transfer_dict(t: Any) -> dict:
+    """A TransferInfo as the plain dict ``transfer_progress`` hands out."""
+    return {
+        "filename": t.filename, "nick": t.nick, "hub_url": t.hubUrl,
+        "size": t.size, "pos": t.pos, "speed": t.speed,
+        "is_download": t.isDownload,
+    }
+
+
+def _transfer_dict_from_record(e: Any) -> dict:
+    return {
+        "filename": e.text, "nick": e.nick, "hub_url": e.hubUrl,
+        "size": e.size, "pos": e.pos, "speed": e.value,
+        "is_download": e.flag,
+    }
+
+
+def _latency_dict(stats: Any) -> dict:
+    # Bucket i covers samples under 2^i us; the last one is open-ended
+    buckets, total = [], 0
+    last = len(stats.buckets) - 1
+    for i, n in enumerate(stats.buckets):
+        total += n
+        bound = float("inf") if i == last else (1 << i) * 1e-6
+        buckets.append((bound, total))
+    return {
+        "count": stats.count,
+        "sum": stats.sumNs / 1e9,
+        "max": stats.maxNs / 1e9,
+        "buckets": buckets,
+    }
+
+
+# Queued-dispatch records (dc_core.BridgeEvent) → (event name, arg builder).
+# Argument order matches the corresponding director callback exactly, so a
+# handler sees the same arguments whichever dispatch mode is active.
+_RECORD_DECODERS: dict[int, tuple[str, Callable[[Any], tuple]]] = {
+    dc_core.EVENT_HUB_CONNECTING: (
+        "hub_connecting", lambda e: (e.hubUrl,)),
+    dc_core.EVENT_HUB_CONNECTED: (
+        "hub_connected", lambda e: (e.hubUrl, e.text)),
+    dc_core.EVENT_HUB_DISCONNECTED: (
+        "hub_disconnected", lambda e: (e.hubUrl, e.text)),
+    dc_core.EVENT_HUB_REDIRECT: (
+        "hub_redirect", lambda e: (e.hubUrl, e.text)),
+    dc_core.EVENT_HUB_PASSWORD_REQUEST: (
+        "hub_get_password", lambda e: (e.hubUrl,)),
+    dc_core.EVENT_HUB_UPDATED: (
+        "hub_updated", lambda e: (e.hubUrl, e.text)),
+    dc_core.EVENT_NICK_TAKEN: (
+        "hub_nick_taken", lambda e: (e.hubUrl,)),
+    dc_core.EVENT_HUB_FULL: (
+        "hub_full", lambda e: (e.hubUrl,)),
+    dc_core.EVENT_CHAT_MESSAGE: (
+        "chat_message", lambda e: (e.hubUrl, e.nick, e.text, e.flag)),
+    dc_core.EVENT_PRIVATE_MESSAGE: (
+        "private_message", lambda e: (e.hubUrl, e.nick, e.extra, e.text)),
+    dc_core.EVENT_STATUS_MESSAGE: (
+        "status_message", lambda e: (e.hubUrl, e.text)),
+    dc_core.EVENT_USER_CONNECTED: (
+        "user_connected", lambda e: (e.hubUrl, e.nick)),
+    dc_core.EVENT_USER_DISCONNECTED: (
+        "user_disconnected", lambda e: (e.hubUrl, e.nick)),
+    dc_core.EVENT_USER_UPDATED: (
+        "user_updated", lambda e: (e.hubUrl, e.nick)),
+    dc_core.EVENT_SEARCH_RESULT: (
+        "search_result", lambda e: (e.hubUrl, e.text, e.size, e.freeSlots,
+                                    e.totalSlots, e.extra, e.nick, e.flag)),
+    dc_core.EVENT_DOWNLOAD_STARTING: (
+        "download_starting", lambda e: (e.text, e.nick, e.size)),
+    dc_core.EVENT_DOWNLOAD_COMPLETE: (
+        "download_complete", lambda e: (e.text, e.nick, e.size, e.value)),
+    dc_core.EVENT_DOWNLOAD_FAILED: (
+        "download_failed", lambda e: (e.text, e.extra)),
+    dc_core.EVENT_UPLOAD_STARTING: (
+        "upload_starting", lambda e: (e.text, e.nick, e.size)),
+    dc_core.EVENT_UPLOAD_COMPLETE: (
+        "upload_complete", lambda e: (e.text, e.nick, e.size)),
+    dc_core.EVENT_QUEUE_ITEM_ADDED: (
+        "queue_item_added", lambda e: (e.text, e.size, e.extra)),
+    dc_core.EVENT_QUEUE_ITEM_FINISHED: (
+        "queue_item_finished", lambda e: (e.text, e.size)),
+    dc_core.EVENT_QUEUE_ITEM_REMOVED: (
+        "queue_item_removed", lambda e: (e.text,)),
+    dc_core.EVENT_HASH_PROGRESS: (
+        "hash_progress", lambda e: (e.text, e.value, e.size)),
+    dc_core.EVENT_FILE_LIST_PROGRESS: (
+        "file_list_progress", lambda e: (e.text, e.value)),
+    dc_core.EVENT_FILE_LIST_LOADED: (
+        "file_list_loaded", lambda e: (e.text, e.flag, e.extra)),
+    # One record per transfer; each arrives as a one-element batch
+    dc_core.EVENT_TRANSFER_PROGRESS: (
+        "transfer_progress", lambda e: ([_transfer_dict_from_record(e)],)),
+    dc_core.EVENT_CORE_READY: (
+        "core_ready", lambda e: (e.flag, e.text)),
+}
+
+# Event name → EventType, for per-type dispatch policies
+_EVENT_TYPE_IDS: dict[str, int] = {
+    name: etype for etype, (name, _) in _RECORD_DECODERS.items()
+}
+
+# EventType → event name, for labelling per-type metrics
+EVENT_TYPE_NAMES: dict[int, str] = {
+    etype: name for name, etype in _EVENT_TYPE_IDS.items()
+}
+
+EVENT_POLICIES: dict[str, int] = {
+    "deliver": dc_core.POLICY_DELIVER,
+    "drop": dc_core.POLICY_DROP,
+    "coalesce": dc_core.POLICY_COALESCE,
+    "rate_limit": dc_core.POLICY_RATE_LIMIT,
+}
+_POLICY_NAMES = {v: k for k, v in EVENT_POLICIES.items()}
+
+_INIT_PHASE_NAMES = {
+    dc_core.INIT_NONE: "none",
+    dc_core.INIT_LOADING: "loading",
+    dc_core.INIT_READY: "ready",
+    dc_core.INIT_FAILED: "failed",
+}
+
+# Event name → EventType bit in the bridge's event mask.  Batch events
+# share the bit of the per-item event they are built from.
+_EVENT_MASK_BITS: dict[str, int] = {
+    **_EVENT_TYPE_IDS,
+    "users_updated": dc_core.EVENT_USER_UPDATED,
+    "users_connected": dc_core.EVENT_USER_CONNECTED,
+    "users_removed": dc_core.EVENT_USER_DISCONNECTED,
+    "queue_items_added": dc_core.EVENT_QUEUE_ITEM_ADDED,
+    "queue_items_removed": dc_core.EVENT_QUEUE_ITEM_REMOVED,
+}
+
+# DCClientCallback method → event name, for callback_event_mask()
+_CALLBACK_METHODS: dict[str, str] = {
+    "onHubConnecting": "hub_connecting",
+    "onHubConnected": "hub_connected",
+    "onHubDisconnected": "hub_disconnected",
+    "onHubRedirect": "hub_redirect",
+    "onHubPasswordRequest": "hub_get_password",
+    "onHubUpdated": "hub_updated",
+    "onNickTaken": "hub_nick_taken",
+    "onHubFull": "hub_full",
+    "onChatMessage": "chat_message",
+    "onPrivateMessage": "private_message",
+    "onStatusMessage": "status_message",
+    "onUserConnected": "user_connected",
+    "onUserDisconnected": "user_disconnected",
+    "onUserUpdated": "user_updated",
+    "onUsersUpdatedBatch": "users_updated",
+    "onUsersConnectedBatch": "users_connected",
+    "onUsersRemovedBatch": "users_removed",
+    "onSearchResult": "search_result",
+    "onQueueItemAdded": "queue_item_added",
+    "onQueueItemFinished": "queue_item_finished",
+    "onQueueItemRemoved": "queue_item_removed",
+    "onQueueItemsAddedBatch": "queue_items_added",
+    "onQueueItemsRemovedBatch": "queue_items_removed",
+    "onDownloadStarting": "download_starting",
+    "onDownloadComplete": "download_complete",
+    "onDownloadFailed": "download_failed",
+    "onUploadStarting": "upload_starting",
+    "onUploadComplete": "upload_complete",
+    "onTransferProgress": "transfer_progress",
+    "onFileListProgress": "file_list_progress",
+    "onFileListLoaded": "file_list_loaded",
+    "onHashProgress": "hash_progress",
+    "onCoreReady": "core_ready",
+}
+
+
+def event_mask(events: Iterable[str]) -> int:
+    """Bridge event mask (for DCBridge.setEventMask) covering ``events``.
+
+    Raises:
+        ValueError: An unknown event name.
+    """
+    mask = 0
+    for event in events:
+        if event not in _EVENT_MASK_BITS:
+            raise ValueError(f"Unknown event type: {event!r}")
+        mask |= 1 << _EVENT_MASK_BITS[event]
+    return mask
+
+
+def callback_event_mask(callback: dc_core.DCClientCallback) -> int:
+    """Event mask for a raw DCClientCallback subclass: only the events
+    whose ``on*`` methods it overrides.
+
+    Use with ``DCBridge.setEventMask`` when driving the bridge directly,
+    so events nobody handles never cross into Python.
+    """
+    cls = type(callback)
+    return event_mask(
+        event for method, event in _CALLBACK_METHODS.items()
+        if getattr(cls, method, None)
+        is not getattr(dc_core.DCClientCallback, method, None))
+
+
 # ============================================================================
 # Callback router — bridges SWIG director calls to Python event handlers
 # ============================================================================
@@ -112,6 +322,11 @@ class _CallbackRouter(dc_core.DCClientCallback):
             except (KeyError, ValueError):
                 pass
 
+    def subscribed_events(self) -> list[str]:
+        """Events with at least one registered handler."""
+        with self._lock:
+            return [event for event, hs in self._handlers.items() if hs]
+
     def _dispatch(self, event: str, *args: Any) -> None:
         """Dispatch an event to all registered handlers."""
         with self._lock:
@@ -122,6 +337,18 @@ class _CallbackRouter(dc_core.DCClientCallback):
             except Exception:
                 logger.exception("Error in event handler for '%s'", event)
 
+    def dispatch_records(self, records: Any) -> int:
+        """Dispatch queued dc_core.BridgeEvent records to handlers."""
+        count = 0
+        for rec in records:
+            decoder = _RECORD_DECODERS.get(rec.type)
+            if decoder is None:
+                continue
+            event, build = decoder
+            self._dispatch(event, *build(rec))
+            count += 1
+        return count
+
     # -------------------------------------------------------------------
     # C++ callback overrides (called from C++ threads via SWIG directors)
     # -------------------------------------------------------------------
@@ -173,6 +400,32 @@ class _CallbackRouter(dc_core.DCClientCallback):
     def onUserUpdated(self, hubUrl: str, nick: str) -> None:
         self._dispatch("user_updated", hubUrl, nick)
 
+    # Batched user events — one director call per user-list update.  The
+    # batch is delivered as a list of nicks, then fanned out to per-user
+    # handlers so existing "user_updated" / "user_disconnected" handlers
+    # keep working unchanged.
+    def onUsersUpdatedBatch(self, hubUrl: str, users: Any) -> None:
+        nicks = [u.nick for u in users]
+        self._dispatch("users_updated", hubUrl, nicks)
+        self._fan_out("user_updated", hubUrl, nicks)
+
+    def onUsersConnectedBatch(self, hubUrl: str, users: Any) -> None:
+        nicks = [u.nick for u in users]
+        self._dispatch("users_connected", hubUrl, nicks)
+        self._fan_out("user_connected", hubUrl, nicks)
+
+    def onUsersRemovedBatch(self, hubUrl: str, nicks: Any) -> None:
+        nicks = list(nicks)
+        self._dispatch("users_removed", hubUrl, nicks)
+        self._fan_out("user_disconnected", hubUrl, nicks)
+
+    def _fan_out(self, event: str, hubUrl: str, nicks: list[str]) -> None:
+        with self._lock:
+            if not self._handlers.get(event):
+                return
+        for nick in nicks:
+            self._dispatch(event, hubUrl, nick)
+
     # Search events
     def onSearchResult(self, hubUrl: str, file: str, size: int,
                        freeSlots: int, totalSlots: int, tth: str,
@@ -190,6 +443,27 @@ class _CallbackRouter(dc_core.DCClientCallback):
     def onQueueItemRemoved(self, target: str) -> None:
         self._dispatch("queue_item_removed", target)
 
+    # Batched queue events — one director call per batch operation
+    # (download_batch, remove_downloads, clear_queue, ...), fanned out to
+    # per-item handlers like the user batches above.
+    def onQueueItemsAddedBatch(self, items: Any) -> None:
+        items = [(q.target, q.size, q.tth) for q in items]
+        self._dispatch("queue_items_added", [t for t, _, _ in items])
+        with self._lock:
+            if not self._handlers.get("queue_item_added"):
+                return
+        for target, size, tth in items:
+            self._dispatch("queue_item_added", target, size, tth)
+
+    def onQueueItemsRemovedBatch(self, targets: Any) -> None:
+        targets = list(targets)
+        self._dispatch("queue_items_removed", targets)
+        with self._lock:
+            if not self._handlers.get("queue_item_removed"):
+                return
+        for target in targets:
+            self._dispatch("queue_item_removed", target)
+
     # Transfer events
     def onDownloadStarting(self, target: str, nick: str, size: int) -> None:
         self._dispatch("download_starting", target, nick, size)
@@ -207,12 +481,28 @@ class _CallbackRouter(dc_core.DCClientCallback):
     def onUploadComplete(self, file: str, nick: str, size: int) -> None:
         self._dispatch("upload_complete", file, nick, size)
 
+    def onTransferProgress(self, transfers: Any) -> None:
+        self._dispatch("transfer_progress",
+                       [_transfer_dict(t) for t in transfers])
+
+    # File list events
+    def onFileListProgress(self, fileListId: str, percent: int) -> None:
+        self._dispatch("file_list_progress", fileListId, percent)
+
+    def onFileListLoaded(self, fileListId: str, success: bool,
+                         error: str) -> None:
+        self._dispatch("file_list_loaded", fileListId, success, error)
+
     # Hash events
     def onHashProgress(
-        self, currentFile: str, filesLeft: int, bytesLeft: int
+        self, currentFile: str, bytesLeft: int, filesLeft: int
     ) -> None:
         self._dispatch("hash_progress", currentFile, filesLeft, bytesLeft)
 
+    # Lifecycle events
+    def onCoreReady(self, success: bool, error: str) -> None:
+        self._dispatch("core_ready", success, error)
+
 
 # ============================================================================
 # DCClient — High-level Pythonic wrapper
@@ -247,28 +537,82 @@ class DCClient:
         self._router = _CallbackRouter()
         self._config_dir = str(config_dir) if config_dir else ""
         self._initialized = False
-
-    def initialize(self) -> bool:
-        """Initialize the DC core library. Must be called before any other ops."""
+        self._starting = False      # callback set, start under way
+        self._ready = threading.Event()
+        self._event_mask: Optional[int] = None     # None = from handlers
+        self._router.register("core_ready", self._on_core_ready)
+
+    def initialize(self, background: bool = False) -> bool:
+        """Initialize the DC core library. Must be called before any other ops.
+
+        With ``background``, return as soon as loading has started; the
+        settings, hash database, share and queue load on a C++ thread and
+        ``core_ready`` (success, error) fires when they are done.  Use
+        :meth:`wait_ready` or that event before anything else.
+        """
         if self._initialized:
             return True
-        ok = self._bridge.initialize(self._config_dir)
-        if ok:
-            self._bridge.setCallback(self._router)
-            self._initialized = True
+        # Set first, so core_ready is not missed; the bridge installs it
+        # only once it has the core
+        self._bridge.setCallback(self._router)
+        self._starting = True
+        self._ready.clear()
+        if background:
+            ok = self._bridge.initializeAsync(self._config_dir)
+        else:
+            # core_ready may still be queued (queued dispatch)
+            ok = self._bridge.initialize(self._config_dir)
+            if ok:
+                self._initialized = True
+                self._apply_event_mask()
+                self._ready.set()
+        if not ok or not background:
+            self._starting = False
         return ok
 
+    def _on_core_ready(self, success: bool, error: str) -> None:
+        self._starting = False
+        self._initialized = success
+        if success:
+            self._apply_event_mask()
+        else:
+            logger.error("DC core failed to start: %s", error)
+        self._ready.set()
+
+    def wait_ready(self, timeout: Optional[float] = None) -> bool:
+        """Block until a background start finishes.
+
+        Returns whether the core is ready; False on timeout or failure.
+        """
+        if not self._ready.wait(timeout):
+            return False
+        return self._initialized
+
     def shutdown(self) -> None:
-        """Shut down the DC core — disconnects all hubs, saves state."""
-        if self._initialized:
+        """Shut down the DC core — disconnects all hubs, saves state.
+
+        Waits for a background start to finish first.
+        """
+        if self._initialized or self._starting:
             self._bridge.shutdown()
             self._initialized = False
+            self._starting = False
 
     @property
     def is_initialized(self) -> bool:
         """Whether the core has been initialized."""
         return self._initialized
 
+    @property
+    def init_phase(self) -> str:
+        """Startup progress: ``none``, ``loading``, ``ready`` or ``failed``."""
+        return _INIT_PHASE_NAMES.get(self._bridge.getInitPhase(), "none")
+
+    @property
+    def init_step(self) -> str:
+        """What a background start is loading now, or why it failed."""
+        return self._bridge.getInitStep()
+
     @property
     def version(self) -> str:
         """Get libeiskaltdcpp version string."""
@@ -298,16 +642,199 @@ class DCClient:
         """
         if handler is not None:
             self._router.register(event, handler)
+            self._apply_event_mask()
             return handler
 
         def decorator(fn: Callable[..., Any]) -> Callable[..., Any]:
             self._router.register(event, fn)
+            self._apply_event_mask()
             return fn
         return decorator
 
     def off(self, event: str, handler: Callable[..., Any]) -> None:
         """Unregister an event handler."""
         self._router.unregister(event, handler)
+        self._apply_event_mask()
+
+    def set_event_mask(self, events: Optional[Iterable[str]] = None) -> None:
+        """Only let ``events`` cross from C++ into Python.
+
+        By default the mask follows the registered handlers: events with
+        no handler are discarded in the listener thread, before any
+        string conversion or GIL acquisition.  Pass an explicit list to
+        override that, or ``None`` to go back to following handlers.
+
+        Raises:
+            ValueError: An unknown event name.
+        """
+        self._event_mask = None if events is None else event_mask(events)
+        self._apply_event_mask()
+
+    @property
+    def event_mask(self) -> int:
+        """Event mask currently applied by the bridge."""
+        return self._bridge.getEventMask()
+
+    def _apply_event_mask(self) -> None:
+        if not self._initialized:
+            return
+        mask = self._event_mask
+        if mask is None:
+            mask = event_mask(self._router.subscribed_events())
+        self._bridge.setEventMask(mask)
+
+    # ------------------------------------------------------------------
+    # Queued dispatch
+    # ------------------------------------------------------------------
+
+    def set_queued_dispatch(
+        self, enabled: bool = True, capacity: int = 65536
+    ) -> None:
+        """Queue events in C++ instead of calling handlers on dcpp threads.
+
+        While enabled, handlers only run from :meth:`poll_events`.
+        ``capacity`` sizes the ring the first time it is enabled.
+        """
+        mode = dc_core.DISPATCH_QUEUED if enabled else dc_core.DISPATCH_DIRECT
+        self._bridge.setDispatchMode(mode, capacity)
+
+    def poll_events(self, max_events: int = 1000) -> int:
+        """Drain queued events and run their handlers on this thread.
+
+        Returns the number of events dispatched.
+        """
+        return self._router.dispatch_records(
+            self._bridge.pollEvents(max_events))
+
+    @property
+    def event_fd(self) -> int:
+        """Descriptor that turns readable when queued events arrive.
+
+        Wait on it with ``select`` or ``loop.add_reader`` and call
+        :meth:`poll_events` when it fires, instead of polling on a
+        timer.  -1 if the platform has no eventfd or pipe.
+        """
+        return self._bridge.getEventFd()
+
+    @property
+    def event_queue_stats(self) -> Any:
+        """Queued-dispatch ring depth and queued/dropped/polled counters."""
+        return self._bridge.getEventQueueStats()
+
+    def get_metrics(self) -> dict[str, Any]:
+        """Snapshot the bridge's always-on hot-path instrumentation.
+
+        Returns plain data, so callers such as the Prometheus endpoint do
+        not need ``dc_core``::
+
+            {"events": {name: {"raised", "skipped", "callbacks",
+                               "callback_latency"}},
+             "locks": {name: {"acquisitions", "contended", "wait"}},
+             "ring": {"capacity", "depth", "queued", "dropped", "polled"},
+             "pending_user_events", "held_coalesced_events",
+             "search_results", "queue_items",
+             "pending_file_list_loads", "hubs"}
+
+        Latencies are ``{"count", "sum", "max", "buckets"}`` in seconds;
+        ``buckets`` is a list of cumulative ``(upper_bound, count)`` pairs
+        ending with ``inf``.
+        """
+        m = self._bridge.getMetrics()
+        ring = m.ring
+        return {
+            "events": {
+                EVENT_TYPE_NAMES.get(e.type, str(e.type)): {
+                    "raised": e.raised,
+                    "skipped": e.skipped,
+                    "callbacks": e.callbacks,
+                    "callback_latency": _latency_dict(e.callbackLatency),
+                }
+                for e in m.events
+            },
+            "locks": {
+                lk.name: {
+                    "acquisitions": lk.acquisitions,
+                    "contended": lk.contended,
+                    "wait": _latency_dict(lk.wait),
+                }
+                for lk in m.locks
+            },
+            "ring": {
+                "capacity": ring.capacity,
+                "depth": ring.depth,
+                "queued": ring.queued,
+                "dropped": ring.dropped,
+                "polled": ring.polled,
+            },
+            "pending_user_events": m.pendingUserEvents,
+            "held_coalesced_events": m.heldCoalescedEvents,
+            "search_results": m.searchResults,
+            "queue_items": m.queueItems,
+            "pending_file_list_loads": m.pendingFileListLoads,
+            "hubs": m.hubs,
+        }
+
+    def set_user_event_coalescing(self, enabled: bool = True) -> None:
+        """Coalesce user join/update/part bursts into once-a-second batches.
+
+        While enabled, ``users_connected`` / ``users_removed`` fire with the
+        latest state per nick instead of one event per protocol message.
+        A nick that joins and parts within the same second is dropped
+        rather than reported as removed.  Each entry is still fanned out to ``user_connected`` /
+        ``user_disconnected`` handlers, so joins keep reaching code that
+        only listens for those.
+        """
+        self._bridge.setUserEventCoalescing(enabled)
+
+    def set_event_policy(
+        self, event: str, policy: str, rate: int = 0
+    ) -> None:
+        """Limit what reaches Python for one event type, before the GIL.
+
+        ``policy`` is ``"deliver"`` (default), ``"drop"``, ``"coalesce"``
+        (latest per hub and nick, once a second) or ``"rate_limit"``
+        (at most ``rate`` per second per hub).  Batched events follow the
+        policy of their per-item event (e.g. ``users_updated`` follows
+        ``user_updated``): ``"drop"`` drops the batch, while
+        ``"coalesce"`` and ``"rate_limit"`` split it into per-item events
+        so the limit applies to each.  ``core_ready`` is always delivered
+        and the event mask does not apply to it.
+
+        Raises:
+            ValueError: Unknown event or policy, a missing rate, or a
+                policy other than ``"deliver"`` for ``core_ready``.
+        """
+        if event not in _EVENT_TYPE_IDS:
+            raise ValueError(f"Unknown event type: {event!r}")
+        if policy not in EVENT_POLICIES:
+            raise ValueError(
+                f"Unknown policy {policy!r}; use one of "
+                f"{sorted(EVENT_POLICIES)}")
+        if not self._bridge.setEventPolicy(
+                _EVENT_TYPE_IDS[event], EVENT_POLICIES[policy], rate):
+            raise ValueError(
+                f"Policy {policy!r} (rate {rate}) not allowed for {event!r}")
+
+    def reset_event_policies(self) -> None:
+        """Deliver every event again and zero the policy counters."""
+        self._bridge.resetEventPolicies()
+
+    @property
+    def event_policy_stats(self) -> dict[str, dict]:
+        """Policy and delivered/dropped/coalesced counts per event name."""
+        stats = {}
+        for st in self._bridge.getEventPolicyStats():
+            name = _RECORD_DECODERS.get(st.type, (None,))[0]
+            if name is None:
+                continue
+            stats[name] = {
+                "policy": _POLICY_NAMES.get(st.policy, "deliver"),
+                "rate": st.ratePerSecond,
+                "delivered": st.delivered,
+                "dropped": st.dropped,
+                "coalesced": st.coalesced,
+            }
+        return stats
 
     # ------------------------------------------------------------------
     # Hub connections
@@ -331,6 +858,35 @@ class DCClient:
         """Check if connected to a specific hub."""
         return self._bridge.isHubConnected(url)
 
+    def get_hub_memory_stats(self) -> list:
+        """Approximate bytes each hub holds in users, chat and results.
+
+        One ``HubMemoryStats`` per hub: ``hubUrl``, ``hubId``,
+        ``userCount``, ``usersDropped``, ``userBytes``, ``chatLines``,
+        ``chatBytes``, ``searchResults``, ``searchBytes`` and
+        ``totalBytes``.
+        """
+        return list(self._bridge.getHubMemoryStats())
+
+    def set_hub_limits(
+        self,
+        max_users: int = 0,
+        max_chat_lines: int = 500,
+        max_results: int = 0,
+    ) -> None:
+        """Cap the users, chat lines and search results kept per hub.
+
+        0 means unlimited for users and results; ``max_chat_lines`` is
+        the chat history capacity (0 keeps no history).  Users beyond
+        the cap are left out of the user list but still reported.
+        """
+        self._bridge.setHubLimits(max_users, max_chat_lines, max_results)
+
+    @property
+    def hub_limits(self) -> Any:
+        """Current per-hub caps (``maxUsers``, ``maxChatLines``, ``maxResults``)."""
+        return self._bridge.getHubLimits()
+
     # ------------------------------------------------------------------
     # Chat
     # ------------------------------------------------------------------
@@ -349,6 +905,70 @@ class DCClient:
         """Get recent chat history for a hub."""
         return list(self._bridge.getChatHistory(hub_url, max_lines))
 
+    def get_chat_history_since(
+        self, hub_url: str, since: int = 0, max_entries: int = 0
+    ) -> Any:
+        """Get chat lines newer than ``since``, oldest first.
+
+        Returns a ``ChatHistoryPage`` with ``entries`` (``seq``,
+        ``timestamp``, ``nick``, ``text``, ``thirdPerson``, ``isPrivate``),
+        ``lastSeq`` (pass it back next time) and ``gap``, set when lines
+        were evicted before they could be read.
+        """
+        return self._bridge.getChatHistorySince(hub_url, since, max_entries)
+
+    def set_chat_history_capacity(self, lines: int) -> None:
+        """Lines of chat kept per hub (default 500; 0 disables)."""
+        self._bridge.setChatHistoryCapacity(lines)
+
+    def enable_chat_log(
+        self,
+        directory: str | Path = "",
+        max_segment_bytes: int = 64 << 20,
+        max_segments: int = 0,
+        fsync_interval_ms: int = 1000,
+    ) -> bool:
+        """Log chat, PMs and status messages of every hub to disk in C++.
+
+        Lines never pass through Python on the way.  ``directory``
+        defaults to ``<config>/ChatLog``; segments rotate at
+        ``max_segment_bytes`` and the oldest beyond ``max_segments`` are
+        deleted (0 = keep all).  Returns False if it cannot be opened.
+        """
+        return self._bridge.enableChatLog(
+            str(directory) if directory else "", max_segment_bytes,
+            max_segments, fsync_interval_ms)
+
+    def disable_chat_log(self) -> None:
+        """Flush, fsync and stop the on-disk chat log."""
+        self._bridge.disableChatLog()
+
+    @property
+    def chat_log_enabled(self) -> bool:
+        """Whether the on-disk chat log is being written."""
+        return self._bridge.isChatLogEnabled()
+
+    def flush_chat_log(self) -> None:
+        """Write out and fsync buffered chat log lines now."""
+        self._bridge.flushChatLog()
+
+    def query_chat_log(
+        self,
+        hub_url: str = "",
+        since: int = 0,
+        until: int = 0,
+        max_entries: int = 0,
+    ) -> list:
+        """Logged lines received in ``[since, until)`` (Unix seconds).
+
+        ``hub_url=""`` covers every hub and ``until=0`` has no upper
+        bound.  Entries have ``timestamp``, ``kind`` (``CHAT_LOG_CHAT``,
+        ``CHAT_LOG_PRIVATE`` or ``CHAT_LOG_STATUS``), ``hubUrl``,
+        ``nick``, ``to``, ``text`` and ``thirdPerson``.
+        """
+        return list(self._bridge.queryChatLog(hub_url, since, until,
+                                              max_entries))
+
     # ------------------------------------------------------------------
     # Users
     # ------------------------------------------------------------------
@@ -361,6 +981,15 @@ class DCClient:
         """Get information about a specific user."""
         return self._bridge.getUserInfo(nick, hub_url)
 
+    def get_user_changes(self, hub_url: str, since: int = 0) -> Any:
+        """Get user joins, parts and updates since a revision.
+
+        Returns a ``UserChanges`` with ``revision`` (pass it back next
+        time), ``updated``, ``removed`` and ``fullResync``.  ``since=0``
+        or a revision that is too old returns the full list.
+        """
+        return self._bridge.getHubUserChanges(hub_url, since)
+
     # ------------------------------------------------------------------
     # Search
     # ------------------------------------------------------------------
@@ -386,10 +1015,103 @@ class DCClient:
         """
         return self._bridge.search(query, file_type, size_mode, size, hub_url)
 
+    def start_search(
+        self,
+        query: str,
+        file_type: int = 0,
+        size_mode: int = 0,
+        size: int = 0,
+        hub_url: str = "",
+    ) -> str:
+        """Start a search and return its token ("" if it was not sent).
+
+        Results are kept per token; fetch them with
+        :meth:`get_search_page`.
+        """
+        return self._bridge.startSearch(
+            query, file_type, size_mode, size, hub_url)
+
+    def queue_search(
+        self,
+        query: str,
+        file_type: int = 0,
+        size_mode: int = 0,
+        size: int = 0,
+        hub_url: str = "",
+        priority: int = 0,
+    ) -> str:
+        """Queue a search to go out as each hub's search interval allows.
+
+        Higher ``priority`` searches go first.  A TTH search already
+        queued, or sent to the same hubs within the last minute, is not
+        repeated and its token is returned instead.  Returns "" if there
+        is no hub to search.
+        """
+        return self._bridge.queueSearch(
+            query, file_type, size_mode, size, hub_url, priority)
+
+    def cancel_queued_search(self, token: str) -> bool:
+        """Stop a queued search from reaching the hubs it has not yet."""
+        return self._bridge.cancelQueuedSearch(token)
+
+    def list_queued_searches(self) -> list:
+        """Searches still waiting for a hub, in the order they will go."""
+        return list(self._bridge.listQueuedSearches())
+
+    @property
+    def search_interval(self) -> int:
+        """Minimum seconds between queued searches to one hub."""
+        return self._bridge.getSearchInterval()
+
+    def set_search_interval(self, seconds: int) -> None:
+        """Space queued searches to each hub at least ``seconds`` apart.
+
+        Hubs that report a search flood get a longer interval of their
+        own until they have taken ten searches without complaint.
+        """
+        self._bridge.setSearchInterval(seconds)
+
     def get_search_results(self, hub_url: str = "") -> list:
         """Get accumulated search results."""
         return list(self._bridge.getSearchResults(hub_url))
 
+    def get_search_page(
+        self, token: str, offset: int = 0, limit: int = 100
+    ) -> list:
+        """Get one page of the results for a search token."""
+        return list(self._bridge.getSearchResults(token, offset, limit))
+
+    def search_snapshot(self, token: str) -> Any:
+        """Immutable, zero-copy view of a search's results.
+
+        Supports ``len()``, indexing, slicing and iteration; ``columns()``
+        returns typed memoryviews (size, slots, isDirectory) plus raw TTH
+        bytes for bulk analysis.
+        """
+        return self._bridge.getSearchSnapshot(token)
+
+    def search_result_count(self, token: str) -> int:
+        """Number of results stored for a search token."""
+        return self._bridge.getSearchResultCount(token)
+
+    def list_searches(self) -> list[str]:
+        """Tokens of the searches still held, most recent first."""
+        return list(self._bridge.listSearches())
+
+    def forget_search(self, token: str) -> bool:
+        """Drop a search and its results."""
+        return self._bridge.forgetSearch(token)
+
+    def set_search_limits(
+        self,
+        max_results_per_search: int = 5000,
+        max_searches: int = 64,
+        ttl_seconds: int = 1800,
+    ) -> None:
+        """Bound the search result store (ttl_seconds=0: never expire)."""
+        self._bridge.setSearchLimits(
+            max_results_per_search, max_searches, ttl_seconds)
+
     def clear_search_results(self, hub_url: str = "") -> None:
         """Clear search results."""
         self._bridge.clearSearchResults(hub_url)
@@ -414,10 +1136,43 @@ class DCClient:
         """Add a magnet link to the download queue."""
         return self._bridge.addMagnet(magnet, download_dir)
 
+    def download_batch(self, items: Any) -> int:
+        """Add many files to the download queue in one call.
+
+        ``items`` is an iterable of ``(directory, name, size, tth)``
+        tuples.  Fires one ``queue_items_added`` event (also fanned out
+        to ``queue_item_added`` handlers).  Returns how many were added.
+        """
+        batch = dc_core.QueueAddItemVector()
+        for directory, name, size, tth in items:
+            item = dc_core.QueueAddItem()
+            item.directory = directory
+            item.name = name
+            item.size = size
+            item.tth = tth
+            batch.append(item)
+        return self._bridge.addToQueueBatch(batch)
+
+    def download_magnets(
+        self, magnets: list[str], download_dir: str = ""
+    ) -> int:
+        """Add many magnet links; malformed ones are skipped.
+
+        Returns how many were added.
+        """
+        return self._bridge.addMagnetBatch(list(magnets), download_dir)
+
     def remove_download(self, target: str) -> None:
         """Remove an item from the download queue."""
         self._bridge.removeFromQueue(target)
 
+    def remove_downloads(self, targets: list[str]) -> int:
+        """Remove many items; fires one ``queue_items_removed`` event.
+
+        Returns how many were in the queue.
+        """
+        return self._bridge.removeFromQueueBatch(list(targets))
+
     def move_download(self, source: str, target: str) -> None:
         """Move a queued download to a new location."""
         self._bridge.moveQueueItem(source, target)
@@ -426,10 +1181,38 @@ class DCClient:
         """Set download priority (0=paused, 1=lowest..5=highest)."""
         self._bridge.setPriority(target, priority)
 
+    def set_priority_batch(self, targets: list[str], priority: int) -> int:
+        """Set one priority on many items.  Returns how many were queued."""
+        return self._bridge.setPriorityBatch(list(targets), priority)
+
     def list_queue(self) -> list:
         """List all items in the download queue."""
         return list(self._bridge.listQueue())
 
+    def list_queue_page(self, offset: int = 0, limit: int = 0) -> Any:
+        """Get one page of the download queue, in target order.
+
+        Returns a ``QueuePage`` with ``items``, ``total`` and the
+        ``revision`` it was taken at.  ``limit=0`` runs to the end.
+        """
+        return self._bridge.listQueuePage(offset, limit)
+
+    def get_queue_changes(self, since: int = 0) -> Any:
+        """Get queue additions, changes and removals since a revision.
+
+        Returns a ``QueueChanges`` with ``revision`` (pass it back next
+        time), ``updated``, ``removed`` and ``fullResync``.  ``since=0``
+        or a revision that is too old returns the whole queue.
+        """
+        return self._bridge.getQueueChanges(since)
+
+    def match_all_lists(self) -> int:
+        """
+        Add every downloaded file list that has a queued file as a source
+        for it.  Returns the number of sources added.
+        """
+        return self._bridge.matchAllLists()
+
     def clear_queue(self) -> None:
         """Clear the entire download queue."""
         self._bridge.clearQueue()
@@ -452,11 +1235,97 @@ class DCClient:
         """Open/parse a local file list."""
         return self._bridge.openFileList(file_list_id)
 
+    def open_file_list_async(self, file_list_id: str) -> bool:
+        """
+        Parse a local file list on a background loader thread.
+
+        Returns immediately; ``file_list_progress`` (list id, percent)
+        events follow, then ``file_list_loaded`` (list id, success,
+        error).  A failed load reports percent -1 first; a list larger
+        than the ``MaxFilelistSize`` setting fails rather than opening
+        truncated.  Several lists load in parallel, up to
+        :meth:`set_file_list_load_threads` at a time.
+        """
+        return self._bridge.openFileListAsync(file_list_id)
+
+    def set_file_list_load_threads(self, threads: int = 0) -> None:
+        """Cap concurrent background list loads (0 = one per CPU core)."""
+        self._bridge.setFileListLoadThreads(threads)
+
+    @property
+    def pending_file_list_loads(self) -> int:
+        """Background list loads queued or running."""
+        return self._bridge.getPendingFileListLoads()
+
     def browse_file_list(
-        self, file_list_id: str, directory: str = "/"
+        self,
+        file_list_id: str,
+        directory: str = "/",
+        offset: int = 0,
+        limit: int = 0,
     ) -> list:
-        """Browse a directory in an opened file list."""
-        return list(self._bridge.browseFileList(file_list_id, directory))
+        """Browse a directory in an opened file list.
+
+        Subdirectories come first, then files.  ``offset``/``limit`` page
+        through large directories (``limit=0`` returns everything from
+        ``offset`` on); a short page means the end was reached.
+        """
+        return list(self._bridge.browseFileList(
+            file_list_id, directory, offset, limit))
+
+    def walk_file_list(
+        self,
+        file_list_id: str,
+        root: str = "/",
+        chunk_size: int = 1000,
+    ) -> Iterator[Any]:
+        """Yield every entry under ``root``, depth-first.
+
+        The walk runs in C++ and is fetched ``chunk_size`` entries at a
+        time, so a whole list costs a handful of calls instead of one per
+        directory.  Each entry's ``path`` is relative to the list root and
+        can be passed to :meth:`download_from_list`.  Yields nothing if
+        the list is not open or ``root`` does not exist.
+        """
+        for chunk in self.walk_file_list_chunks(
+                file_list_id, root, chunk_size):
+            yield from chunk
+
+    def walk_file_list_chunks(
+        self,
+        file_list_id: str,
+        root: str = "/",
+        chunk_size: int = 1000,
+    ) -> Iterator[list]:
+        """Like :meth:`walk_file_list`, one list per fetched chunk."""
+        walker = self._bridge.walkFileList(file_list_id, root)
+        yield from walker.chunks(chunk_size)
+
+    def search_file_lists(
+        self,
+        query: str,
+        file_type: int = 0,
+        size_mode: int = 0,
+        size: int = 0,
+        offset: int = 0,
+        limit: int = 100,
+        file_list_ids: Optional[Iterable[str]] = None,
+    ) -> Any:
+        """Search the names in opened file lists without leaving C++.
+
+        Every query word must be a prefix of a word in the name, so
+        ``"beat"`` finds ``"The Beatles"``.  ``file_type``, ``size_mode``
+        and ``size`` filter as for :meth:`search`; type 8 looks up a TTH.
+        ``file_list_ids`` limits the search to those lists (default: all
+        open ones).
+
+        Returns a ``FileListSearchPage`` with ``total`` hits and one page
+        of ``hits``: entries with ``fileListId`` and ``path`` set, ready
+        for :meth:`download_from_list`.
+        """
+        return self._bridge.searchFileLists(
+            query, file_type, size_mode, size, offset, limit,
+            list(file_list_ids or []))
 
     def download_from_list(
         self,
@@ -480,10 +1349,47 @@ class DCClient:
             file_list_id, dir_path, download_to
         )
 
+    def download_files_from_list(
+        self,
+        file_list_id: str,
+        paths: list[str],
+        download_to: str = "",
+    ) -> int:
+        """
+        Queue many files and/or directories from one file list.
+
+        Each entry is saved under its own name inside *download_to* (the
+        default download directory when empty).  Returns how many of
+        *paths* were found and queued.
+        """
+        return self._bridge.downloadFilesFromList(
+            file_list_id, list(paths), download_to
+        )
+
     def close_file_list(self, file_list_id: str) -> None:
         """Close an opened file list."""
         self._bridge.closeFileList(file_list_id)
 
+    def find_sources(self, tths: list[str]) -> dict[str, list[str]]:
+        """
+        Look up TTHs in the index over every downloaded file list.
+
+        Returns ``{tth: [file_list_id, ...]}`` for the TTHs that any list
+        contains; unknown or malformed TTHs are left out.
+        """
+        found: dict[str, list[str]] = {}
+        for src in self._bridge.findSources(list(tths)):
+            found.setdefault(src.tth, []).append(src.fileListId)
+        return found
+
+    def refresh_tth_index(self) -> int:
+        """
+        Re-index file lists that were added or changed on disk outside
+        the client.  Runs on the loader pool; returns how many lists were
+        queued.
+        """
+        return self._bridge.refreshTTHIndex()
+
     def close_all_file_lists(self) -> None:
         """Close all opened file lists."""
         self._bridge.closeAllFileLists()
@@ -512,6 +1418,18 @@ class DCClient:
         """Refresh shared file lists."""
         self._bridge.refreshShare()
 
+    def refresh_share_dir(self, real_path: str) -> bool:
+        """Rescan the share root holding ``real_path`` and nothing else.
+
+        Files whose TTH is already known are not hashed again.  Returns
+        False if ``real_path`` is not shared, its root cannot be read, or
+        the core refuses to add the root back (it is then unshared); the
+        last two also raise ``status_message`` with the reason.  The
+        directory walk runs on the calling thread before this returns,
+        and the root's files are out of the share while it does.
+        """
+        return self._bridge.refreshShareDir(real_path)
+
     @property
     def share_size(self) -> int:
         """Total share size in bytes."""
@@ -531,6 +1449,29 @@ class DCClient:
         """Get aggregate transfer statistics."""
         return self._bridge.getTransferStats()
 
+    @property
+    def status_snapshot(self) -> Any:
+        """Hub, share, queue, transfer and hashing totals in one read.
+
+        The bridge rebuilds the ``StatusSnapshot`` once a second on the
+        core's timer thread, so reading it never touches the core and
+        costs the same however many clients poll.  ``seq`` is 0 until
+        the first tick after :meth:`initialize`.
+        """
+        return self._bridge.getStatusSnapshot()
+
+    @property
+    def active_transfers(self) -> list:
+        """Uploads and downloads in progress (``TransferInfo`` objects)."""
+        return list(self._bridge.getActiveTransfers())
+
+    def set_transfer_progress_interval(self, interval_ms: int) -> None:
+        """Fire ``transfer_progress`` with every active transfer at most
+        once per ``interval_ms`` (0 turns it off).  The core updates
+        transfers once a second.
+        """
+        self._bridge.setTransferProgressInterval(interval_ms)
+
     # ------------------------------------------------------------------
     # Hashing
     # ------------------------------------------------------------------
@@ -544,6 +1485,25 @@ class DCClient:
         """Pause or resume file hashing."""
         self._bridge.pauseHashing(pause)
 
+    @property
+    def hash_speed_limit(self) -> int:
+        """Hashing read limit in MiB/s (0 = unlimited)."""
+        return self._bridge.getHashSpeedLimit()
+
+    def set_hash_speed_limit(self, mb_per_sec: int) -> None:
+        """Cap hashing reads at ``mb_per_sec`` MiB/s (0 = unlimited).
+
+        Saved as the core's ``MaxHashSpeed`` setting.
+        """
+        self._bridge.setHashSpeedLimit(mb_per_sec)
+
+    def set_hash_progress_interval(self, interval_ms: int) -> None:
+        """Fire ``hash_progress`` at most once per ``interval_ms`` while
+        files are queued for hashing, and once when the queue empties
+        (0 turns it off).
+        """
+        self._bridge.setHashProgressInterval(interval_ms)
+
     # ------------------------------------------------------------------
     # Settings
     # ------------------------------------------------------------------
@@ -552,9 +1512,32 @@ class DCClient:
         """Get a DC client setting by name."""
         return self._bridge.getSetting(name)
 
-    def set_setting(self, name: str, value: str) -> None:
-        """Set a DC client setting."""
-        self._bridge.setSetting(name, value)
+    def set_setting(self, name: str, value: str) -> bool:
+        """Set a DC client setting.
+
+        Returns False for an unknown name or a value that does not parse
+        as the setting's type.  The config file is rewritten once
+        settings have been left alone for two seconds; call
+        :meth:`save_settings` to write it now.
+        """
+        return self._bridge.setSetting(name, value)
+
+    def get_settings(self, names: Iterable[str]) -> dict[str, str]:
+        """Values of several settings; unknown names are left out."""
+        return dict(self._bridge.getSettings(list(names)))
+
+    def set_settings(self, values: Mapping[str, Any]) -> int:
+        """Apply several settings with a single config write.
+
+        Values are converted with ``str()``.  Returns how many were
+        applied; unknown names and unparsable values are skipped.
+        """
+        return self._bridge.setSettings(
+            {name: str(value) for name, value in values.items()})
+
+    def save_settings(self) -> None:
+        """Write pending setting changes to disk now."""
+        self._bridge.saveSettings()
 
     def start_networking(self) -> None:
         """(Re)start the networking stack (connection listeners).
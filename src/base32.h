@@ -0,0 +1,74 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * base32.h — RFC 4648 base32 (unpadded, as dcpp::Encoder) for the
+ *            fixed-size CIDs and TTHs the bridge stores as raw bytes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace eiskaltdcpp_py {
+
+/// Encoded length of n raw bytes.
+constexpr size_t base32Length(size_t n) { return (n * 8 + 4) / 5; }
+
+/// Encode len bytes.
+inline std::string base32Encode(const uint8_t* data, size_t len) {
+    static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+    std::string out;
+    out.reserve(base32Length(len));
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (size_t i = 0; i < len; ++i) {
+        buffer = (buffer << 8) | data[i];
+        bits += 8;
+        while (bits >= 5) {
+            bits -= 5;
+            out.push_back(ALPHABET[(buffer >> bits) & 0x1F]);
+        }
+    }
+    if (bits > 0) {
+        out.push_back(ALPHABET[(buffer << (5 - bits)) & 0x1F]);
+    }
+    return out;
+}
+
+/// Decode exactly len bytes.  Returns false (out zeroed) if text is not
+/// the canonical encoding of len bytes — anything else would not survive
+/// a round trip.
+inline bool base32Decode(const std::string& text, uint8_t* out, size_t len) {
+    for (size_t i = 0; i < len; ++i) out[i] = 0;
+    if (text.size() != base32Length(len)) return false;
+
+    uint32_t buffer = 0;
+    int bits = 0;
+    size_t pos = 0;
+    for (char ch : text) {
+        int v;
+        if (ch >= 'A' && ch <= 'Z') v = ch - 'A';
+        else if (ch >= 'a' && ch <= 'z') v = ch - 'a';
+        else if (ch >= '2' && ch <= '7') v = ch - '2' + 26;
+        else break;
+
+        buffer = (buffer << 5) | static_cast<uint32_t>(v);
+        bits += 5;
+        if (bits >= 8) {
+            bits -= 8;
+            if (pos < len) out[pos++] = static_cast<uint8_t>(buffer >> bits);
+        }
+    }
+    if (pos != len || (buffer & ((1u << bits) - 1)) != 0) {
+        for (size_t i = 0; i < len; ++i) out[i] = 0;
+        return false;
+    }
+    return true;
+}
+
+} // namespace eiskaltdcpp_py
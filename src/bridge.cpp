@@ -13,6 +13,7 @@
 #include "bridge.h"
 #include "bridge_listeners.h"
 #include "callbacks.h"
+#include "file_list_index.h"
 #include "dcpp_compat.h"  // must precede dcpp headers (provides STL + using decls)
 
 #include <dcpp/DCPlusPlus.h>
@@ -31,11 +32,14 @@
 #include <dcpp/SearchResult.h>
 #include <dcpp/SettingsManager.h>
 #include <dcpp/ShareManager.h>
-#include <dcpp/StringTokenizer.h>
 #include <dcpp/TimerManager.h>
 #include <dcpp/Transfer.h>
 #include <dcpp/UploadManager.h>
 #include <dcpp/DirectoryListing.h>
+#include <dcpp/BZUtils.h>
+#include <dcpp/File.h>
+#include <dcpp/FilteredFile.h>
+#include <dcpp/Streams.h>
 
 // dcpp/version.h pulls in VersionGlobal.h which is a build-time generated
 // file not installed by libeiskaltdcpp-dev.  We only need DCVERSIONSTRING.
@@ -44,9 +48,14 @@
 #endif
 
 #include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <thread>
 
 #include <dlfcn.h>   // dlsym — for runtime ScriptInstance::L resolution
 #include <unistd.h>  // getpid — for default nick generation
@@ -157,14 +166,6 @@ static void initLuaScriptingIfPresent() {
 #endif
 }
 
-// =========================================================================
-// Startup callback (called by dcpp::startup)
-// =========================================================================
-
-static void startupCallback(void*, const std::string& msg) {
-    // Could log this if desired
-}
-
 // =========================================================================
 // Global init guard — dcpp::startup() creates global singletons and must
 // only be called ONCE per process.  A second call would double-construct
@@ -181,9 +182,7 @@ static std::mutex        g_dcppStartupMutex;
 DCBridge::DCBridge() = default;
 
 DCBridge::~DCBridge() {
-    if (m_initialized.load()) {
-        shutdown();
-    }
+    shutdown();     // also joins a background start
 }
 
 // =========================================================================
@@ -194,12 +193,46 @@ bool DCBridge::initialize(const std::string& configDir) {
     if (m_initialized.load()) {
         return true; // Already initialized
     }
+    if (!prepareInit(configDir)) {
+        return false;
+    }
+    runStartup();
+    return m_initialized.load();
+}
+
+bool DCBridge::initializeAsync(const std::string& configDir) {
+    if (m_initialized.load() || m_initPhase.load() == INIT_LOADING) {
+        return true;
+    }
+    if (!prepareInit(configDir)) {
+        // Lost a race with another start, or the core runs elsewhere
+        return m_initPhase.load() == INIT_LOADING || m_initialized.load();
+    }
+
+    std::lock_guard<std::mutex> lock(m_initMutex);
+    // An earlier failed start; it is past everything that takes
+    // m_initMutex
+    if (m_initThread.joinable()) m_initThread.join();
+    m_initThread = std::thread(&DCBridge::runStartup, this);
+    return true;
+}
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+bool DCBridge::prepareInit(const std::string& configDir) {
+    auto lock = lockCounted(m_mutex, m_mutexCounters);
+
+    int phase = m_initPhase.load();
+    if (phase != INIT_NONE && phase != INIT_FAILED) {
+        return false;
+    }
+    if (m_coreStarted.load()) {
+        // A start that failed after dcpp::startup(); shutdown() first
+        return false;
+    }
 
     // Prevent a second DCBridge from calling dcpp::startup() in the same
     // process — the singleton managers already exist and re-constructing
-    // them causes hangs / undefined behaviour.
+    // them causes hangs / undefined behaviour.  Claimed here, before the
+    // (possibly background) startup, so two starts cannot both pass.
     {
         std::lock_guard<std::mutex> glock(g_dcppStartupMutex);
         if (g_dcppStarted.load()) {
@@ -207,8 +240,14 @@ bool DCBridge::initialize(const std::string& configDir) {
             // bridge instance rather than risking UB.
             return false;
         }
+        g_dcppStarted.store(true);
     }
 
+    auto release = [] {
+        std::lock_guard<std::mutex> glock(g_dcppStartupMutex);
+        g_dcppStarted.store(false);
+    };
+
     // Set up config directory
     std::string cfgDir = configDir;
     if (cfgDir.empty()) {
@@ -232,6 +271,7 @@ bool DCBridge::initialize(const std::string& configDir) {
     try {
         std::filesystem::create_directories(cfgDir);
     } catch (const std::exception& e) {
+        release();
         return false;
     }
 
@@ -243,43 +283,130 @@ bool DCBridge::initialize(const std::string& configDir) {
     pathOverrides[Util::PATH_USER_LOCAL] = cfgDir;
     Util::initialize(pathOverrides);
 
-    // Start the core library — creates all singleton managers, loads
-    // settings, favorites, certificates, hashing, share refresh, and queue.
-    dcpp::startup(startupCallback, nullptr);
+    {
+        std::lock_guard<std::mutex> ilock(m_initMutex);
+        m_initStep.clear();
+    }
+    // Set before the start, so onCoreReady reaches it
+    BridgeListeners::getInstance().setCallback(m_callback);
+    m_initPhase.store(INIT_LOADING);
+    return true;
+}
+
+void DCBridge::onStartupStep(void* bridge, const std::string& step) {
+    auto* self = static_cast<DCBridge*>(bridge);
+    std::lock_guard<std::mutex> lock(self->m_initMutex);
+    self->m_initStep = step;
+}
 
-    // Mark as globally started (must come after startup() succeeds)
-    g_dcppStarted.store(true);
+void DCBridge::runStartup() {
+    // The TTH index is our own file and needs nothing from the core, so
+    // it loads while dcpp::startup() reads settings, hashes and queue.
+    // Nothing else touches m_tthIndex before m_initialized is set.
+    std::thread tthLoader([this] {
+        auto tlock = lockCounted(m_tthMutex, m_tthMutexCounters);
+        m_tthIndex.load(tthIndexPath());
+    });
 
-    // Ensure a nick is set — without one the NMDC handshake sends an empty
-    // $ValidateNick which the hub rejects, leaving connected=false forever.
-    {
-        auto* sm = SettingsManager::getInstance();
-        std::string currentNick = sm->get(SettingsManager::NICK, true);
-        if (currentNick.empty()) {
-            // Generate a default nick: "dcpy-<pid>"
-            std::string defaultNick = "dcpy-" + std::to_string(getpid());
-            sm->set(SettingsManager::NICK, defaultNick);
+    std::string error;
+    try {
+        // Start the core library — creates all singleton managers, loads
+        // settings, favorites, certificates, hashing, share refresh, and
+        // queue.  dcpp::startup() does these in order and in one call.
+        dcpp::startup(&DCBridge::onStartupStep, this);
+        m_coreStarted.store(true);
+
+        // Ensure a nick is set — without one the NMDC handshake sends an
+        // empty $ValidateNick which the hub rejects, leaving
+        // connected=false forever.
+        {
+            auto* sm = SettingsManager::getInstance();
+            std::string currentNick = sm->get(SettingsManager::NICK, true);
+            if (currentNick.empty()) {
+                // Generate a default nick: "dcpy-<pid>"
+                std::string defaultNick =
+                    "dcpy-" + std::to_string(getpid());
+                sm->set(SettingsManager::NICK, defaultNick);
+            }
         }
-    }
 
-    // Initialize the Lua scripting state if the library was compiled with
-    // Lua support.  Without this, NMDC hub callbacks that pass through the
-    // Lua script layer will crash because the lua_State* is null.
-    initLuaScriptingIfPresent();
+        // Initialize the Lua scripting state if the library was compiled
+        // with Lua support.  Without this, NMDC hub callbacks that pass
+        // through the Lua script layer will crash because the lua_State*
+        // is null.
+        initLuaScriptingIfPresent();
 
-    // Start the timer (drives periodic events) — not done by startup()
-    TimerManager::getInstance()->start();
+        // Start the timer (drives periodic events) — not done by startup()
+        TimerManager::getInstance()->start();
 
-    // Subscribe listeners to global managers
-    BridgeListeners::getInstance().setBridge(this);
-    BridgeListeners::getInstance().subscribeGlobal();
+        // Subscribe listeners to global managers
+        BridgeListeners::getInstance().setBridge(this);
+        BridgeListeners::getInstance().subscribeGlobal();
 
-    m_initialized.store(true);
-    return true;
+        seedQueueMirror();
+    } catch (const std::exception& e) {
+        error = e.what();
+    } catch (...) {
+        error = "unknown error";
+    }
+
+    // Reloaded from the last session; refreshTTHIndex() then re-indexes
+    // (in the background) only lists that changed meanwhile.
+    tthLoader.join();
+
+    if (error.empty()) {
+        m_initialized.store(true);
+        {
+            std::lock_guard<std::mutex> lock(m_initMutex);
+            m_initPhase.store(INIT_READY);
+        }
+        m_initDone.notify_all();
+        refreshTTHIndex();
+    } else {
+        if (!m_coreStarted.load()) {
+            // Nothing to shut down; let a later start try again
+            std::lock_guard<std::mutex> glock(g_dcppStartupMutex);
+            g_dcppStarted.store(false);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_initMutex);
+            m_initStep = error;
+            m_initPhase.store(INIT_FAILED);
+        }
+        m_initDone.notify_all();
+    }
+    BridgeListeners::getInstance().coreReady(error.empty(), error);
+}
+
+void DCBridge::joinInitThread() {
+    std::thread t;
+    {
+        std::lock_guard<std::mutex> lock(m_initMutex);
+        t = std::move(m_initThread);
+    }
+    if (!t.joinable()) return;
+    if (t.get_id() == std::this_thread::get_id()) {
+        t.detach();     // shutdown() from an onCoreReady handler
+    } else {
+        t.join();
+    }
 }
 
 void DCBridge::shutdown() {
-    if (!m_initialized.load()) {
+    // initializeAsync() claims the core (INIT_LOADING) before it stores
+    // m_initThread, so an empty m_initThread does not mean no start is
+    // coming.  Wait the start out; otherwise it would bring the core up
+    // after we return.  (onCoreReady fires after the phase has moved
+    // on, so a handler calling shutdown() does not wait on itself.)
+    {
+        std::unique_lock<std::mutex> lock(m_initMutex);
+        m_initDone.wait(lock, [this] {
+            return m_initPhase.load() != INIT_LOADING;
+        });
+    }
+    joinInitThread();
+    if (!m_coreStarted.load()) {
+        m_initPhase.store(INIT_NONE);
         return;
     }
 
@@ -288,28 +415,54 @@ void DCBridge::shutdown() {
     BridgeListeners::getInstance().unsubscribeGlobal();
     BridgeListeners::getInstance().setBridge(nullptr);
     BridgeListeners::getInstance().setCallback(nullptr);
+    BridgeListeners::getInstance().clearActiveTransfers();
+    m_status.store(nullptr, std::memory_order_release);
+    saveSettings();     // timer is gone; write any deferred change now
+
+    // Let running background loads finish (they only touch m_fileLists)
+    // and drop queued ones before the lists and dcpp go away.
+    m_fileListLoader.stop();
+    m_fileListSearchPool.stop();
+
+    {
+        auto lock = lockCounted(m_tthMutex, m_tthMutexCounters);
+        if (m_tthIndex.dirty() && !m_tthIndex.save(tthIndexPath())) {
+            fprintf(stderr, "DCBridge::shutdown: could not save %s\n",
+                    tthIndexPath().c_str());
+        }
+        m_tthIndex.clear();
+    }
+    {
+        auto lock = lockCounted(m_queueMutex, m_queueMutexCounters);
+        m_queue.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_schedulerMutex);
+        m_scheduler.clear();
+    }
+    m_chatLog.close();
 
     // Collect hub clients and file lists under the lock, then release
     std::vector<Client*> clients;
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
         // Close all file lists
-        for (auto& [id, listing] : m_fileLists) {
-            delete listing;
-        }
+        auto lock = lockCounted(m_fileListMutex, m_fileListMutexCounters);
         m_fileLists.clear();
-
+    }
+    {
         // Collect hub clients
+        auto lock = lockCounted(m_hubsMutex, m_hubsMutexCounters);
         for (auto& [url, data] : m_hubs) {
-            if (data.client) {
-                clients.push_back(data.client);
+            if (data->client) {
+                clients.push_back(data->client);
             }
         }
         m_hubs.clear();
+        m_hubsByClient.clear();
+        m_hubsGeneration.fetch_add(1, std::memory_order_release);
     }
 
-    // m_mutex released — safe to call into dcpp (avoids ABBA deadlock)
+    // Locks released — safe to call into dcpp (avoids ABBA deadlock)
     for (auto* client : clients) {
         client->disconnect(true);
         ClientManager::getInstance()->putClient(client);
@@ -352,20 +505,111 @@ void DCBridge::shutdown() {
     }
 
     m_initialized.store(false);
+    m_coreStarted.store(false);
+    m_initPhase.store(INIT_NONE);
 }
 
 bool DCBridge::isInitialized() const {
     return m_initialized.load();
 }
 
+int DCBridge::getInitPhase() const {
+    return m_initPhase.load();
+}
+
+std::string DCBridge::getInitStep() const {
+    std::lock_guard<std::mutex> lock(m_initMutex);
+    return m_initStep;
+}
+
 // =========================================================================
 // Callbacks
 // =========================================================================
 
 void DCBridge::setCallback(DCClientCallback* cb) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    auto lock = lockCounted(m_mutex, m_mutexCounters);
     m_callback = cb;
-    BridgeListeners::getInstance().setCallback(cb);
+    // Before initialize() it is installed by prepareInit(), so a bridge
+    // refused the core never takes over the running one's events
+    if (m_initPhase.load() != INIT_NONE) {
+        BridgeListeners::getInstance().setCallback(cb);
+    }
+}
+
+void DCBridge::setDispatchMode(int mode, size_t queueCapacity) {
+    BridgeListeners::getInstance().setDispatchMode(mode, queueCapacity);
+}
+
+int DCBridge::getDispatchMode() const {
+    return BridgeListeners::getInstance().getDispatchMode();
+}
+
+std::vector<BridgeEvent> DCBridge::pollEvents(int maxEvents) {
+    return BridgeListeners::getInstance().pollEvents(maxEvents);
+}
+
+int DCBridge::getEventFd() {
+    return BridgeListeners::getInstance().getEventFd();
+}
+
+EventQueueStats DCBridge::getEventQueueStats() const {
+    return BridgeListeners::getInstance().getEventQueueStats();
+}
+
+void DCBridge::setUserEventCoalescing(bool enable) {
+    BridgeListeners::getInstance().setUserEventCoalescing(enable);
+}
+
+bool DCBridge::getUserEventCoalescing() const {
+    return BridgeListeners::getInstance().getUserEventCoalescing();
+}
+
+bool DCBridge::setEventPolicy(int eventType, int policy, int ratePerSecond) {
+    return BridgeListeners::getInstance().setEventPolicy(eventType, policy,
+                                                         ratePerSecond);
+}
+
+int DCBridge::getEventPolicy(int eventType) const {
+    return BridgeListeners::getInstance().getEventPolicy(eventType);
+}
+
+std::vector<EventPolicyStats> DCBridge::getEventPolicyStats() const {
+    return BridgeListeners::getInstance().getEventPolicyStats();
+}
+
+void DCBridge::resetEventPolicies() {
+    BridgeListeners::getInstance().resetEventPolicies();
+}
+
+void DCBridge::setEventMask(uint64_t mask) {
+    BridgeListeners::getInstance().setEventMask(mask);
+}
+
+uint64_t DCBridge::getEventMask() const {
+    return BridgeListeners::getInstance().getEventMask();
+}
+
+BridgeMetrics DCBridge::getMetrics() {
+    BridgeMetrics m;
+    BridgeListeners::getInstance().fillMetrics(m);
+    for (const LockCounters* c : {&m_mutexCounters, &m_hubsMutexCounters,
+                                  &m_hubMutexCounters, &m_searchMutexCounters,
+                                  &m_fileListMutexCounters, &m_tthMutexCounters,
+                                  &m_queueMutexCounters}) {
+        m.locks.push_back(c->snapshot());
+    }
+    {
+        auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+        m.searchResults = m_searches.size();
+    }
+    {
+        auto lock = lockCounted(m_queueMutex, m_queueMutexCounters);
+        m.queueItems = m_queue.size();
+    }
+    m.pendingFileListLoads = static_cast<int>(m_fileListLoader.pending());
+    auto lock = lockCountedShared(m_hubsMutex, m_hubsMutexCounters);
+    m.hubs = static_cast<int>(m_hubs.size());
+    return m;
 }
 
 // =========================================================================
@@ -376,13 +620,10 @@ void DCBridge::connectHub(const std::string& url,
                           const std::string& encoding) {
     if (!m_initialized.load()) return;
 
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        // Don't connect twice
-        if (m_hubs.count(url) > 0) return;
-    }
+    // Don't connect twice
+    if (findHub(url)) return;
 
-    // m_mutex released — safe to call into dcpp (avoids ABBA deadlock
+    // No bridge lock held — safe to call into dcpp (avoids ABBA deadlock
     // with ClientManager::cs / NmdcHub::cs held by hub socket threads)
     Client* client = ClientManager::getInstance()->getClient(url);
     if (!client) return;
@@ -397,11 +638,16 @@ void DCBridge::connectHub(const std::string& url,
     client->connect();
 
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        HubData hd;
-        hd.client = client;
-        hd.cachedInfo.url = url;
+        auto hd = std::make_shared<HubData>();
+        hd->client = client;
+        hd->chatHistory.setCapacity(m_chatCapacity.load());
+        hd->cachedInfo.url = url;
+        auto lock = lockCounted(m_hubsMutex, m_hubsMutexCounters);
+        hd->id = m_nextHubId++;
+        hd->cachedInfo.hubId = hd->id;
+        m_hubsByClient[client] = hd;
         m_hubs[url] = std::move(hd);
+        m_hubsGeneration.fetch_add(1, std::memory_order_release);
     }
 }
 
@@ -410,14 +656,16 @@ void DCBridge::disconnectHub(const std::string& url) {
 
     Client* client = nullptr;
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        auto lock = lockCounted(m_hubsMutex, m_hubsMutexCounters);
         auto it = m_hubs.find(url);
         if (it == m_hubs.end()) return;
-        client = it->second.client;
+        client = it->second->client;
+        m_hubsByClient.erase(client);
         m_hubs.erase(it);
+        m_hubsGeneration.fetch_add(1, std::memory_order_release);
     }
 
-    // m_mutex released — safe to call into dcpp (avoids ABBA deadlock)
+    // m_hubsMutex released — safe to call into dcpp (avoids ABBA deadlock)
     if (client) {
         BridgeListeners::getInstance().detach(client);
         client->disconnect(true);
@@ -429,16 +677,20 @@ std::vector<HubInfo> DCBridge::listHubs() {
     std::vector<HubInfo> result;
     if (!m_initialized.load()) return result;
 
-    // Read entirely from the cached HubInfo snapshots under m_mutex.
+    // Read entirely from the cached HubInfo snapshots.
     // The cache is populated by socket-thread callbacks (Connected,
     // HubUpdated, UserUpdated, etc.) where Client* access is safe.
     // This avoids data-race reads on Client* GETSET members from the
-    // API thread, and sidesteps ABBA deadlock between m_mutex and
-    // NmdcHub::cs.
-    std::lock_guard<std::mutex> lock(m_mutex);
-    result.reserve(m_hubs.size());
-    for (auto& [url, data] : m_hubs) {
-        result.push_back(data.cachedInfo);
+    // API thread, and sidesteps ABBA deadlock with NmdcHub::cs.  Only
+    // the shared map lock and each hub's infoMutex are taken, so this
+    // never waits behind chat or user-list ingestion.  The map lock is
+    // released before the first infoMutex, so connects and disconnects
+    // are not held up by a walk over many hubs either.
+    auto hubs = allHubs();
+    result.reserve(hubs.size());
+    for (const auto& hd : hubs) {
+        std::lock_guard<std::mutex> ilock(hd->infoMutex);
+        result.push_back(hd->cachedInfo);
     }
     return result;
 }
@@ -446,9 +698,95 @@ std::vector<HubInfo> DCBridge::listHubs() {
 bool DCBridge::isHubConnected(const std::string& hubUrl) {
     if (!m_initialized.load()) return false;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto* hd = findHub(hubUrl);
-    return hd && hd->cachedInfo.connected;
+    auto hd = findHub(hubUrl);
+    if (!hd) return false;
+    std::lock_guard<std::mutex> lock(hd->infoMutex);
+    return hd->cachedInfo.connected;
+}
+
+void DCBridge::HubData::admitUser(const UserInfo& ui, size_t cap) {
+    auto refused = refusedUsers.find(ui.nick);
+    if (cap && users.size() >= cap && !users.contains(ui.nick)) {
+        if (refused == refusedUsers.end()) {
+            refusedUsers.emplace(ui.nick, ui.shareSize);
+            ++usersDropped;
+        } else {
+            refusedShare -= refused->second;
+            refused->second = ui.shareSize;
+        }
+        refusedShare += ui.shareSize;
+        return;
+    }
+    if (refused != refusedUsers.end()) {
+        // A slot has opened since it was refused
+        refusedShare -= refused->second;
+        refusedUsers.erase(refused);
+    }
+    users.upsert(ui);
+}
+
+std::vector<HubMemoryStats> DCBridge::getHubMemoryStats() {
+    std::vector<HubMemoryStats> result;
+    if (!m_initialized.load()) return result;
+
+    auto hubs = allHubs();
+    result.reserve(hubs.size());
+    for (const auto& hd : hubs) {
+        HubMemoryStats st;
+        st.hubId = hd->id;
+        {
+            std::lock_guard<std::mutex> ilock(hd->infoMutex);
+            st.hubUrl = hd->cachedInfo.url;
+        }
+        {
+            auto lock = lockCounted(hd->mutex, m_hubMutexCounters);
+            st.userCount = static_cast<int>(hd->users.size());
+            st.usersDropped = hd->usersDropped;
+            st.userBytes = static_cast<int64_t>(hd->users.memoryUsage());
+            for (const auto& [nick, share] : hd->refusedUsers) {
+                st.userBytes += static_cast<int64_t>(
+                    sizeof(nick) + sizeof(share) + 2 * sizeof(void*) +
+                    (nick.capacity() > 15 ? nick.capacity() + 1 : 0));
+            }
+            st.chatLines = static_cast<int>(hd->chatHistory.size());
+            st.chatBytes = static_cast<int64_t>(hd->chatHistory.memoryUsage());
+        }
+        result.push_back(std::move(st));
+    }
+
+    // One pass over the search store for every hub
+    {
+        auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+        for (auto& st : result) {
+            auto used = m_searches.hubUsage(st.hubUrl);
+            st.searchResults = static_cast<int>(used.count);
+            st.searchBytes = static_cast<int64_t>(used.bytes);
+        }
+    }
+    for (auto& st : result) {
+        st.totalBytes = st.userBytes + st.chatBytes + st.searchBytes;
+    }
+    return result;
+}
+
+void DCBridge::setHubLimits(int maxUsers, int maxChatLines, int maxResults) {
+    m_maxHubUsers.store(static_cast<size_t>(std::max(maxUsers, 0)));
+    setChatHistoryCapacity(maxChatLines);
+
+    auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+    SearchResultStore::Limits limits = m_searches.limits();
+    limits.maxResultsPerHub = static_cast<size_t>(std::max(maxResults, 0));
+    m_searches.setLimits(limits);
+}
+
+HubLimits DCBridge::getHubLimits() const {
+    HubLimits limits;
+    limits.maxUsers = static_cast<int>(m_maxHubUsers.load());
+    limits.maxChatLines = static_cast<int>(m_chatCapacity.load());
+    auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+    limits.maxResults =
+        static_cast<int>(m_searches.limits().maxResultsPerHub);
+    return limits;
 }
 
 // =========================================================================
@@ -459,14 +797,10 @@ void DCBridge::sendMessage(const std::string& hubUrl,
                            const std::string& message) {
     if (!m_initialized.load()) return;
 
-    Client* client;
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        client = findClient(hubUrl);
-        if (!client) return;
-    }
-    // m_mutex released — safe to call into dcpp (avoids ABBA deadlock
-    // with NmdcHub::cs held by the hub socket thread)
+    // No bridge lock is held here — safe to call into dcpp (avoids ABBA
+    // deadlock with NmdcHub::cs held by the hub socket thread)
+    Client* client = findClient(hubUrl);
+    if (!client) return;
     client->hubMessage(message);
 }
 
@@ -475,12 +809,9 @@ void DCBridge::sendPM(const std::string& hubUrl,
                       const std::string& message) {
     if (!m_initialized.load()) return;
 
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        auto* client = findClient(hubUrl);
-        if (!client) return;
-    }
-    // m_mutex released — safe to call into dcpp (avoids ABBA deadlock
+    if (!findClient(hubUrl)) return;
+
+    // No bridge lock is held — safe to call into dcpp (avoids ABBA deadlock
     // with NmdcHub::cs / ClientManager::cs held by the hub socket thread)
     UserPtr user = ClientManager::getInstance()->findUser(nick, hubUrl);
     if (user) {
@@ -494,18 +825,76 @@ std::vector<std::string> DCBridge::getChatHistory(
     std::vector<std::string> result;
     if (!m_initialized.load()) return result;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto* hd = findHub(hubUrl);
+    auto hd = findHub(hubUrl);
     if (!hd) return result;
+    auto lock = lockCounted(hd->mutex, m_hubMutexCounters);
+    hd->chatHistory.recentLines(
+        static_cast<size_t>(std::max(maxLines, 0)), result);
+    return result;
+}
+
+ChatHistoryPage DCBridge::getChatHistorySince(const std::string& hubUrl,
+                                              uint64_t sinceSeq,
+                                              int maxEntries) {
+    ChatHistoryPage page;
+    page.lastSeq = sinceSeq;
+    if (!m_initialized.load()) return page;
+
+    auto hd = findHub(hubUrl);
+    if (!hd) return page;
+    auto lock = lockCounted(hd->mutex, m_hubMutexCounters);
+    hd->chatHistory.since(sinceSeq,
+                          static_cast<size_t>(std::max(maxEntries, 0)), page);
+    return page;
+}
+
+void DCBridge::setChatHistoryCapacity(int lines) {
+    size_t capacity = static_cast<size_t>(std::max(lines, 0));
+    m_chatCapacity.store(capacity);
 
-    int start = 0;
-    if (maxLines > 0 && static_cast<int>(hd->chatHistory.size()) > maxLines) {
-        start = static_cast<int>(hd->chatHistory.size()) - maxLines;
+    for (const auto& hd : allHubs()) {
+        auto lock = lockCounted(hd->mutex, m_hubMutexCounters);
+        hd->chatHistory.setCapacity(capacity);
     }
-    for (int i = start; i < static_cast<int>(hd->chatHistory.size()); ++i) {
-        result.push_back(hd->chatHistory[i]);
+}
+
+int DCBridge::getChatHistoryCapacity() const {
+    return static_cast<int>(m_chatCapacity.load());
+}
+
+bool DCBridge::enableChatLog(const std::string& directory,
+                             int64_t maxSegmentBytes, int maxSegments,
+                             int fsyncIntervalMs) {
+    ChatLog::Options opts;
+    opts.directory = directory;
+    if (opts.directory.empty()) {
+        if (!m_initialized.load()) return false;
+        opts.directory = m_configDir + "ChatLog";
     }
-    return result;
+    opts.maxSegmentBytes = maxSegmentBytes;
+    opts.maxSegments = maxSegments;
+    opts.fsyncIntervalMs = fsyncIntervalMs;
+    return m_chatLog.open(opts);
+}
+
+void DCBridge::disableChatLog() {
+    m_chatLog.close();
+}
+
+bool DCBridge::isChatLogEnabled() const {
+    return m_chatLog.isOpen();
+}
+
+void DCBridge::flushChatLog() {
+    m_chatLog.flush(TimerManager::getTick(), true);
+}
+
+std::vector<ChatLogEntry> DCBridge::queryChatLog(const std::string& hubUrl,
+                                                 int64_t fromTime,
+                                                 int64_t toTime,
+                                                 int maxEntries) {
+    return m_chatLog.query(hubUrl, fromTime, toTime,
+                           static_cast<size_t>(std::max(maxEntries, 0)));
 }
 
 // =========================================================================
@@ -516,17 +905,38 @@ std::vector<UserInfo> DCBridge::getHubUsers(const std::string& hubUrl) {
     std::vector<UserInfo> result;
     if (!m_initialized.load()) return result;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto* hd = findHub(hubUrl);
+    auto hd = findHub(hubUrl);
     if (!hd) return result;
+    auto lock = lockCounted(hd->mutex, m_hubMutexCounters);
 
-    result.reserve(hd->users.size());
-    for (auto& [nick, ui] : hd->users) {
-        result.push_back(ui);
-    }
+    hd->users.appendAll(result);
     return result;
 }
 
+uint64_t DCBridge::getHubUserRevision(const std::string& hubUrl) {
+    if (!m_initialized.load()) return 0;
+
+    auto hd = findHub(hubUrl);
+    if (!hd) return 0;
+    auto lock = lockCounted(hd->mutex, m_hubMutexCounters);
+    return hd->users.revision();
+}
+
+UserChanges DCBridge::getHubUserChanges(const std::string& hubUrl,
+                                        uint64_t sinceRevision) {
+    UserChanges changes;
+    if (!m_initialized.load()) return changes;
+
+    auto hd = findHub(hubUrl);
+    if (!hd) {
+        changes.fullResync = true;
+        return changes;
+    }
+    auto lock = lockCounted(hd->mutex, m_hubMutexCounters);
+    hd->users.changesSince(sinceRevision, changes);
+    return changes;
+}
+
 UserInfo DCBridge::getUserInfo(const std::string& nick,
                                const std::string& hubUrl) {
     UserInfo ui;
@@ -534,12 +944,14 @@ UserInfo DCBridge::getUserInfo(const std::string& nick,
     if (!m_initialized.load()) return ui;
 
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        auto* client = findClient(hubUrl);
-        if (!client) return ui;
+        auto hd = findHub(hubUrl);
+        if (!hd || !hd->client) return ui;
+        // Served from the stashed user list when we have it
+        auto lock = lockCounted(hd->mutex, m_hubMutexCounters);
+        if (hd->users.get(nick, ui)) return ui;
     }
 
-    // m_mutex released — safe to call ClientManager (avoids ABBA deadlock)
+    // Hub lock released — safe to call ClientManager (avoids ABBA deadlock)
     UserPtr user = ClientManager::getInstance()->findUser(nick, hubUrl);
     if (user) {
         Identity id = ClientManager::getInstance()->getOnlineUserIdentity(user);
@@ -561,33 +973,149 @@ UserInfo DCBridge::getUserInfo(const std::string& nick,
 bool DCBridge::search(const std::string& query, int fileType,
                       int sizeMode, int64_t size,
                       const std::string& hubUrl) {
-    if (!m_initialized.load()) return false;
+    return !startSearch(query, fileType, sizeMode, size, hubUrl).empty();
+}
 
-    if (!hubUrl.empty()) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        if (!findClient(hubUrl)) return false;
+std::string DCBridge::startSearch(const std::string& query, int fileType,
+                                  int sizeMode, int64_t size,
+                                  const std::string& hubUrl) {
+    if (!m_initialized.load()) return "";
+
+    auto token = Util::toString(Util::rand());
+    if (!hubUrl.empty() && !findClient(hubUrl)) return "";
+    {
+        // Open the session before dispatching so no early result is lost
+        auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+        m_searches.beginSearch(token, query,
+                               fileType == SearchManager::TYPE_TTH,
+                               hubUrl, GET_TICK());
     }
 
-    // m_mutex released — safe to call SearchManager (avoids ABBA deadlock)
+    // m_searchMutex released — safe to call SearchManager (avoids ABBA
+    // deadlock)
     auto sm = SearchManager::getInstance();
-    auto token = Util::toString(Util::rand());
 
+    StringList hubs;
     if (hubUrl.empty()) {
         // Search all hubs
         sm->search(query, size,
                    static_cast<SearchManager::TypeModes>(fileType),
                    static_cast<SearchManager::SizeModes>(sizeMode),
                    token, nullptr);
+        std::unordered_set<std::string> known, connected;
+        hubUrls(known, connected);
+        hubs.assign(connected.begin(), connected.end());
     } else {
         // Search specific hub
-        StringList hubs;
         hubs.push_back(hubUrl);
         sm->search(hubs, query, size,
                    static_cast<SearchManager::TypeModes>(fileType),
                    static_cast<SearchManager::SizeModes>(sizeMode),
                    token, StringList(), nullptr);
     }
-    return true;
+
+    // Counts against the hubs' intervals, so queued searches keep
+    // their distance
+    std::lock_guard<std::mutex> lock(m_schedulerMutex);
+    m_scheduler.noteSent(hubs, GET_TICK());
+    return token;
+}
+
+std::string DCBridge::queueSearch(const std::string& query, int fileType,
+                                  int sizeMode, int64_t size,
+                                  const std::string& hubUrl, int priority) {
+    if (!m_initialized.load()) return "";
+
+    std::vector<std::string> hubs;
+    if (!hubUrl.empty()) {
+        if (!findHub(hubUrl)) return "";
+        hubs.push_back(hubUrl);
+    } else {
+        std::unordered_set<std::string> known, connected;
+        hubUrls(known, connected);
+        hubs.assign(known.begin(), known.end());
+    }
+
+    SearchScheduler::Request req;
+    req.token = Util::toString(Util::rand());
+    req.query = query;
+    req.fileType = fileType;
+    req.sizeMode = sizeMode;
+    req.size = size;
+    req.priority = priority;
+    std::string newToken = req.token;
+    std::string token;
+    {
+        std::lock_guard<std::mutex> lock(m_schedulerMutex);
+        token = m_scheduler.enqueue(std::move(req), hubs, GET_TICK());
+        if (token.empty()) return "";
+        if (token == newToken) {
+            // Under the scheduler lock, so the timer cannot send it first
+            auto slock = lockCounted(m_searchMutex, m_searchMutexCounters);
+            m_searches.beginSearch(token, query,
+                                   fileType == SearchManager::TYPE_TTH,
+                                   hubUrl, GET_TICK());
+        }
+    }
+    pumpSearchQueue();
+    return token;
+}
+
+bool DCBridge::cancelQueuedSearch(const std::string& token) {
+    std::lock_guard<std::mutex> lock(m_schedulerMutex);
+    return m_scheduler.cancel(token);
+}
+
+std::vector<QueuedSearchInfo> DCBridge::listQueuedSearches() {
+    std::lock_guard<std::mutex> lock(m_schedulerMutex);
+    return m_scheduler.pending();
+}
+
+void DCBridge::setSearchInterval(int seconds) {
+    std::lock_guard<std::mutex> lock(m_schedulerMutex);
+    m_scheduler.setInterval(static_cast<uint64_t>(std::max(seconds, 0)) * 1000);
+}
+
+int DCBridge::getSearchInterval() const {
+    std::lock_guard<std::mutex> lock(m_schedulerMutex);
+    return static_cast<int>(m_scheduler.interval() / 1000);
+}
+
+void DCBridge::pumpSearchQueue() {
+    if (!m_initialized.load()) return;
+
+    std::unordered_set<std::string> known, connected;
+    hubUrls(known, connected);
+    std::vector<SearchScheduler::Dispatch> due;
+    {
+        std::lock_guard<std::mutex> lock(m_schedulerMutex);
+        if (m_scheduler.size() == 0) return;
+        due = m_scheduler.due(GET_TICK(), known, connected);
+    }
+
+    // Scheduler lock released before calling SearchManager
+    auto sm = SearchManager::getInstance();
+    for (auto& d : due) {
+        const auto& req = d.request;
+        sm->search(d.hubs, req.query, req.size,
+                   static_cast<SearchManager::TypeModes>(req.fileType),
+                   static_cast<SearchManager::SizeModes>(req.sizeMode),
+                   req.token, StringList(), nullptr);
+    }
+}
+
+void DCBridge::noteSearchFlood(const std::string& hubUrl) {
+    std::lock_guard<std::mutex> lock(m_schedulerMutex);
+    m_scheduler.noteFlood(hubUrl, GET_TICK());
+}
+
+void DCBridge::hubUrls(std::unordered_set<std::string>& known,
+                       std::unordered_set<std::string>& connected) const {
+    for (const auto& hd : allHubs()) {
+        std::lock_guard<std::mutex> lock(hd->infoMutex);
+        known.insert(hd->cachedInfo.url);
+        if (hd->cachedInfo.connected) connected.insert(hd->cachedInfo.url);
+    }
 }
 
 std::vector<SearchResultInfo> DCBridge::getSearchResults(
@@ -595,45 +1123,132 @@ std::vector<SearchResultInfo> DCBridge::getSearchResults(
     std::vector<SearchResultInfo> result;
     if (!m_initialized.load()) return result;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-
+    // Snapshots are pointer copies, so the lock is held only for those;
+    // the results are copied out after it is released
+    std::vector<SearchResultSnapshot> snaps;
+    {
+        auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+        snaps = m_searches.snapshots();
+    }
     if (hubUrl.empty()) {
-        // Return results from all hubs
-        for (auto& [url, data] : m_hubs) {
-            result.insert(result.end(),
-                          data.searchResults.begin(),
-                          data.searchResults.end());
-        }
-    } else {
-        auto* hd = findHub(hubUrl);
-        if (hd) {
-            result = hd->searchResults;
+        size_t total = 0;
+        for (const auto& snap : snaps) total += snap.size();
+        result.reserve(total);
+    }
+    for (const auto& snap : snaps) {
+        for (size_t i = 0; i < snap.size(); ++i) {
+            const SearchResultInfo& r = snap.item(i);
+            if (hubUrl.empty() || r.hubUrl == hubUrl) {
+                result.push_back(r);
+                fillTTH(result.back());
+            }
         }
     }
     return result;
 }
 
+std::vector<SearchResultInfo> DCBridge::getSearchResults(
+        const std::string& token, int offset, int limit) {
+    std::vector<SearchResultInfo> result;
+    if (!m_initialized.load() || offset < 0) return result;
+
+    auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+    m_searches.page(token, static_cast<size_t>(offset), limit, result);
+    return result;
+}
+
+int DCBridge::getSearchResultCount(const std::string& token) {
+    if (!m_initialized.load()) return 0;
+
+    auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+    return static_cast<int>(m_searches.count(token));
+}
+
+SearchResultSnapshot DCBridge::getSearchSnapshot(const std::string& token) {
+    if (!m_initialized.load()) return SearchResultSnapshot();
+
+    auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+    return m_searches.snapshot(token);
+}
+
+std::vector<std::string> DCBridge::listSearches() {
+    if (!m_initialized.load()) return {};
+
+    auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+    return m_searches.tokens();
+}
+
+bool DCBridge::forgetSearch(const std::string& token) {
+    if (!m_initialized.load()) return false;
+
+    auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+    return m_searches.erase(token);
+}
+
+void DCBridge::setSearchLimits(int maxResultsPerSearch, int maxSearches,
+                               int ttlSeconds) {
+    SearchResultStore::Limits limits;
+    if (maxResultsPerSearch > 0)
+        limits.maxResultsPerSearch = static_cast<size_t>(maxResultsPerSearch);
+    if (maxSearches > 0)
+        limits.maxSearches = static_cast<size_t>(maxSearches);
+    limits.ttlMs = ttlSeconds > 0 ? static_cast<uint64_t>(ttlSeconds) * 1000
+                                  : 0;
+
+    auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+    // The per-hub cap belongs to setHubLimits()
+    limits.maxResultsPerHub = m_searches.limits().maxResultsPerHub;
+    m_searches.setLimits(limits);
+}
+
 void DCBridge::clearSearchResults(const std::string& hubUrl) {
     if (!m_initialized.load()) return;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    if (hubUrl.empty()) {
-        for (auto& [url, data] : m_hubs) {
-            data.searchResults.clear();
-        }
-    } else {
-        auto* hd = findHub(hubUrl);
-        if (hd) {
-            hd->searchResults.clear();
-        }
-    }
+    auto lock = lockCounted(m_searchMutex, m_searchMutexCounters);
+    m_searches.clear(hubUrl);
 }
 
 // =========================================================================
 // Download queue
 // =========================================================================
 
+static std::string queueTarget(const std::string& directory,
+                               const std::string& name) {
+    std::string target = directory;
+    if (!target.empty() && target.back() != '/') target += '/';
+    target += name;
+    return target;
+}
+
+// Extract from magnet:?xt=urn:tree:tiger:TTH&xl=SIZE&dn=NAME
+static bool parseMagnet(const std::string& magnetLink, std::string& name,
+                        std::string& tth, int64_t& size) {
+    auto xtPos = magnetLink.find("xt=urn:tree:tiger:");
+    if (xtPos == std::string::npos) return false;
+    tth = magnetLink.substr(xtPos + 18, 39);
+
+    size = 0;
+    auto xlPos = magnetLink.find("xl=");
+    if (xlPos != std::string::npos) {
+        auto end = magnetLink.find('&', xlPos);
+        size = Util::toInt64(magnetLink.substr(xlPos + 3,
+            end == std::string::npos ? std::string::npos : end - xlPos - 3));
+    }
+
+    name.clear();
+    auto dnPos = magnetLink.find("dn=");
+    if (dnPos != std::string::npos) {
+        auto end = magnetLink.find('&', dnPos);
+        name = magnetLink.substr(dnPos + 3,
+            end == std::string::npos ? std::string::npos : end - dnPos - 3);
+        // URL decode basic escapes
+        // (full decode would be more complex, this handles common cases)
+    }
+
+    if (name.empty()) name = tth;
+    return true;
+}
+
 bool DCBridge::addToQueue(const std::string& directory,
                           const std::string& name,
                           int64_t size,
@@ -641,11 +1256,7 @@ bool DCBridge::addToQueue(const std::string& directory,
     if (!m_initialized.load()) return false;
 
     try {
-        std::string target = directory;
-        if (!target.empty() && target.back() != '/') target += '/';
-        target += name;
-
-        QueueManager::getInstance()->add(target, size,
+        QueueManager::getInstance()->add(queueTarget(directory, name), size,
             TTHValue(tth), HintedUser(),
             QueueItem::FLAG_NORMAL);
         return true;
@@ -658,38 +1269,50 @@ bool DCBridge::addMagnet(const std::string& magnetLink,
                          const std::string& downloadDir) {
     if (!m_initialized.load()) return false;
 
-    // Parse magnet link
     std::string name, tth;
     int64_t size = 0;
+    if (!parseMagnet(magnetLink, name, tth, size)) return false;
 
-    // Extract from magnet:?xt=urn:tree:tiger:TTH&xl=SIZE&dn=NAME
-    auto xtPos = magnetLink.find("xt=urn:tree:tiger:");
-    if (xtPos == std::string::npos) return false;
-    tth = magnetLink.substr(xtPos + 18, 39);
+    std::string dir = downloadDir.empty()
+        ? SETTING(DOWNLOAD_DIRECTORY)
+        : downloadDir;
 
-    auto xlPos = magnetLink.find("xl=");
-    if (xlPos != std::string::npos) {
-        auto end = magnetLink.find('&', xlPos);
-        size = Util::toInt64(magnetLink.substr(xlPos + 3,
-            end == std::string::npos ? std::string::npos : end - xlPos - 3));
-    }
+    return addToQueue(dir, name, size, tth);
+}
 
-    auto dnPos = magnetLink.find("dn=");
-    if (dnPos != std::string::npos) {
-        auto end = magnetLink.find('&', dnPos);
-        name = magnetLink.substr(dnPos + 3,
-            end == std::string::npos ? std::string::npos : end - dnPos - 3);
-        // URL decode basic escapes
-        // (full decode would be more complex, this handles common cases)
+int DCBridge::addToQueueBatch(const std::vector<QueueAddItem>& items) {
+    if (!m_initialized.load()) return 0;
+
+    auto* qm = QueueManager::getInstance();
+    BridgeListeners::QueueEventBatch batch;
+    int added = 0;
+    for (const auto& item : items) {
+        try {
+            qm->add(queueTarget(item.directory, item.name), item.size,
+                    TTHValue(item.tth), HintedUser(), QueueItem::FLAG_NORMAL);
+            ++added;
+        } catch (const Exception&) {}
     }
+    return added;
+}
 
-    if (name.empty()) name = tth;
+int DCBridge::addMagnetBatch(const std::vector<std::string>& magnetLinks,
+                             const std::string& downloadDir) {
+    if (!m_initialized.load()) return 0;
 
     std::string dir = downloadDir.empty()
         ? SETTING(DOWNLOAD_DIRECTORY)
         : downloadDir;
 
-    return addToQueue(dir, name, size, tth);
+    std::vector<QueueAddItem> items;
+    items.reserve(magnetLinks.size());
+    for (const auto& link : magnetLinks) {
+        QueueAddItem item;
+        if (!parseMagnet(link, item.name, item.tth, item.size)) continue;
+        item.directory = dir;
+        items.push_back(std::move(item));
+    }
+    return addToQueueBatch(items);
 }
 
 void DCBridge::removeFromQueue(const std::string& target) {
@@ -720,47 +1343,167 @@ std::vector<QueueItemInfo> DCBridge::listQueue() {
     std::vector<QueueItemInfo> result;
     if (!m_initialized.load()) return result;
 
-    const QueueItem::StringMap& ll = QueueManager::getInstance()->lockQueue();
-    for (const auto& item : ll) {
-        QueueItem* qi = item.second;
-        QueueItemInfo info;
-        info.target = qi->getTarget();
-        info.filename = qi->getTargetFileName();
-        info.size = qi->getSize();
-        info.downloadedBytes = qi->getDownloadedBytes();
-        info.tth = qi->getTTH().toBase32();
-        info.priority = static_cast<int>(qi->getPriority());
-        info.sources = static_cast<int>(qi->getSources().size());
-        info.onlineSources = qi->countOnlineUsers();
-        info.status = qi->isFinished() ? 2 : (qi->isRunning() ? 1 : 0);
-        result.push_back(std::move(info));
-    }
-    QueueManager::getInstance()->unlockQueue();
-
+    auto lock = lockCounted(m_queueMutex, m_queueMutexCounters);
+    m_queue.appendAll(result);
     return result;
 }
 
+QueuePage DCBridge::listQueuePage(int offset, int limit) {
+    QueuePage page;
+    if (!m_initialized.load()) return page;
+
+    auto lock = lockCounted(m_queueMutex, m_queueMutexCounters);
+    m_queue.page(offset > 0 ? static_cast<size_t>(offset) : 0,
+                 limit > 0 ? static_cast<size_t>(limit) : m_queue.size(),
+                 page);
+    return page;
+}
+
+uint64_t DCBridge::getQueueRevision() {
+    if (!m_initialized.load()) return 0;
+    auto lock = lockCounted(m_queueMutex, m_queueMutexCounters);
+    return m_queue.revision();
+}
+
+QueueChanges DCBridge::getQueueChanges(uint64_t sinceRevision) {
+    QueueChanges changes;
+    if (!m_initialized.load()) return changes;
+
+    auto lock = lockCounted(m_queueMutex, m_queueMutexCounters);
+    m_queue.changesSince(sinceRevision, changes);
+    return changes;
+}
+
+void DCBridge::seedQueueMirror() {
+    // Listeners are subscribed already and fire under the queue lock, so
+    // holding it across the snapshot and reset means no event is lost or
+    // applied twice.  Queue lock → m_queueMutex, same order as they use.
+    auto* qm = QueueManager::getInstance();
+    std::vector<QueueItemInfo> items;
+    const QueueItem::StringMap& ll = qm->lockQueue();
+    items.reserve(ll.size());
+    for (const auto& item : ll) {
+        items.push_back(infoFromQueueItem(item.second));
+    }
+    {
+        auto lock = lockCounted(m_queueMutex, m_queueMutexCounters);
+        m_queue.reset(std::move(items));
+    }
+    qm->unlockQueue();
+}
+
 void DCBridge::clearQueue() {
     if (!m_initialized.load()) return;
     // Collect all targets first, then remove outside the lock
     auto* qm = QueueManager::getInstance();
     std::vector<std::string> targets;
     const QueueItem::StringMap& ll = qm->lockQueue();
+    targets.reserve(ll.size());
     for (const auto& item : ll) {
         targets.push_back(*(item.first));
     }
     qm->unlockQueue();
+    removeFromQueueBatch(targets);
+}
+
+int DCBridge::removeFromQueueBatch(const std::vector<std::string>& targets) {
+    if (!m_initialized.load()) return 0;
+
+    // remove() ignores unknown targets, so count the Removed events
+    auto* qm = QueueManager::getInstance();
+    BridgeListeners::QueueEventBatch batch;
     for (const auto& t : targets) {
-        qm->remove(t);
+        try {
+            qm->remove(t);
+        } catch (const Exception&) {}
     }
+    return static_cast<int>(batch.removedCount());
 }
 
-void DCBridge::matchAllLists() {
-    if (!m_initialized.load()) return;
+int DCBridge::setPriorityBatch(const std::vector<std::string>& targets,
+                               int priority) {
+    if (!m_initialized.load()) return 0;
+
+    // setPriority() ignores unknown targets; the mirror says which exist
+    int found = 0;
+    {
+        auto lock = lockCounted(m_queueMutex, m_queueMutexCounters);
+        for (const auto& t : targets) found += m_queue.contains(t) ? 1 : 0;
+    }
+
+    auto* qm = QueueManager::getInstance();
+    auto prio = static_cast<QueueItem::Priority>(priority);
+    for (const auto& t : targets) {
+        try {
+            qm->setPriority(t, prio);
+        } catch (const Exception&) {}
+    }
+    return found;
+}
+
+int DCBridge::matchAllLists() {
+    if (!m_initialized.load()) return 0;
+
+    // Snapshot what we still want, then release the queue lock
+    struct Wanted {
+        std::string target;
+        int64_t size;
+        TTHValue tth;
+    };
+    std::vector<Wanted> wanted;
+    auto* qm = QueueManager::getInstance();
+    const QueueItem::StringMap& ll = qm->lockQueue();
+    wanted.reserve(ll.size());
+    for (const auto& item : ll) {
+        QueueItem* qi = item.second;
+        if (qi->isFinished() || qi->isSet(QueueItem::FLAG_USER_LIST)) continue;
+        wanted.push_back({qi->getTarget(), qi->getSize(), qi->getTTH()});
+    }
+    qm->unlockQueue();
+
+    // (wanted index, list id) pairs — index lookups only, no dcpp calls
+    std::vector<std::pair<size_t, std::string>> matches;
+    {
+        auto lock = lockCounted(m_tthMutex, m_tthMutexCounters);
+        std::vector<const TTHIndex::Source*> found;
+        for (size_t i = 0; i < wanted.size(); ++i) {
+            TTHIndex::RawTTH raw;
+            memcpy(raw.data(), wanted[i].tth.data, raw.size());
+            found.clear();
+            m_tthIndex.find(raw, found);
+            for (auto* src : found) matches.emplace_back(i, src->fileListId);
+        }
+    }
+
+    // Add the sources with no lock held — QueueManager fires callbacks,
+    // gathered into one batch as in addToQueueBatch().  Each list's user
+    // is resolved once, however many files it matches.
+    BridgeListeners::QueueEventBatch batch;
+    int added = 0;
+    std::unordered_map<std::string, HintedUser> users;
+    for (const auto& [i, fileListId] : matches) {
+        auto u = users.find(fileListId);
+        if (u == users.end()) {
+            HintedUser hu;
+            hu.user = DirectoryListing::getUserFromFilename(fileListId);
+            if (hu.user) {
+                auto hubs = ClientManager::getInstance()->getHubUrls(
+                    hu.user->getCID());
+                if (!hubs.empty()) hu.hint = hubs.front();
+            }
+            u = users.emplace(fileListId, std::move(hu)).first;
+        }
+        if (!u->second.user) continue;
 
-    // Match all downloaded file lists against the queue
-    auto dir = Util::getListPath();
-    // TODO: iterate file lists and match
+        const Wanted& w = wanted[i];
+        try {
+            qm->add(w.target, w.size, w.tth, u->second, 0);
+            ++added;
+        } catch (const Exception&) {
+            // Already a source, or the item changed since the snapshot
+        }
+    }
+    return added;
 }
 
 // =========================================================================
@@ -772,13 +1515,9 @@ bool DCBridge::requestFileList(const std::string& hubUrl,
                                bool matchQueue) {
     if (!m_initialized.load()) return false;
 
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        auto* client = findClient(hubUrl);
-        if (!client) return false;
-    }
+    if (!findClient(hubUrl)) return false;
 
-    // m_mutex released — safe to call ClientManager/QueueManager
+    // No bridge lock held — safe to call ClientManager/QueueManager
     UserPtr user = ClientManager::getInstance()->findUser(nick, hubUrl);
     if (user) {
         try {
@@ -805,26 +1544,101 @@ std::vector<std::string> DCBridge::listLocalFileLists() {
                 result.push_back(entry.path().filename().string());
             }
         }
-    } catch (const std::exception&) {}
-    return result;
+    } catch (const std::exception&) {}
+    return result;
+}
+
+// Passes reads through and counts the bytes, so decompression progress
+// can be measured against the compressed size on disk.
+class CountingInputStream : public dcpp::InputStream {
+public:
+    explicit CountingInputStream(dcpp::InputStream* in) : m_in(in) {}
+    size_t read(void* buf, size_t& len) override {
+        size_t n = m_in->read(buf, len);
+        m_count += n;
+        return n;
+    }
+    int64_t count() const { return m_count; }
+private:
+    dcpp::InputStream* m_in;
+    int64_t m_count = 0;
+};
+
+static bool endsWithNoCase(const std::string& s, const char* suffix) {
+    size_t n = strlen(suffix);
+    if (s.size() < n) return false;
+    for (size_t i = 0; i < n; ++i) {
+        if (tolower(static_cast<unsigned char>(s[s.size() - n + i])) !=
+                suffix[i]) {
+            return false;
+        }
+    }
+    return true;
 }
 
-bool DCBridge::openFileList(const std::string& fileListId) {
-    if (!m_initialized.load()) return false;
+// Same as the read half of DirectoryListing::loadFile(), reporting how
+// much of the file has been consumed.  Reading is scaled to 0-90; the
+// remaining span is the XML parse, which has no progress of its own.
+// A list that inflates past MaxFilelistSize throws.
+static std::string readFileListXml(const std::string& path,
+                                   const std::function<void(int)>& progress) {
+    dcpp::File file(path, dcpp::File::READ, dcpp::File::OPEN);
+    int64_t total = std::max<int64_t>(file.getSize(), 1);
+    CountingInputStream counted(&file);
+
+    std::unique_ptr<dcpp::InputStream> bz;
+    dcpp::InputStream* in = &counted;
+    if (endsWithNoCase(path, ".bz2")) {
+        bz.reset(new FilteredInputStream<UnBZFilter, false>(&counted));
+        in = bz.get();
+    } else if (!endsWithNoCase(path, ".xml")) {
+        throw FileException("Unsupported file list format");
+    }
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t BUF_SIZE = 64 * 1024;
+    const size_t maxSize =
+        static_cast<size_t>(SETTING(MAX_FILELIST_SIZE)) * 1024 * 1024;
+    std::vector<char> buf(BUF_SIZE);
+    std::string xml;
+    int last = -1;
+    for (;;) {
+        // The filter leaves in len what it pulled from the file; the
+        // inflated count is what read() returns
+        size_t len = BUF_SIZE;
+        size_t n = in->read(buf.data(), len);
+        xml.append(buf.data(), n);
+        if (maxSize && xml.size() > maxSize) {
+            // Inflated bytes, so a small bz2 bomb is caught one buffer
+            // past the limit.  A cut-off tree would open (and be
+            // indexed) as if complete
+            throw FileException("File list is larger than "
+                                "MaxFilelistSize (" +
+                                Util::toString(SETTING(MAX_FILELIST_SIZE)) +
+                                " MiB)");
+        }
+        if (n < BUF_SIZE) break;
 
-    if (m_fileLists.count(fileListId) > 0) return true; // Already open
+        int pct = static_cast<int>(counted.count() * 90 / total);
+        if (pct > last) {
+            last = pct;
+            progress(pct);
+        }
+    }
+    if (last < 90) progress(90);
+    return xml;
+}
 
+std::shared_ptr<const OpenFileList> DCBridge::loadFileList(
+        const std::string& fileListId, std::string& error,
+        const std::function<void(int)>& progress) {
     auto path = Util::getListPath() + fileListId;
 
     // Resolve the User from the CID embedded in the filename.
     // File list names follow: [nick].[CID-base32].xml.bz2
     UserPtr user = DirectoryListing::getUserFromFilename(fileListId);
     if (!user) {
-        fprintf(stderr, "DCBridge::openFileList: could not resolve user "
-                        "from filename '%s'\n", fileListId.c_str());
-        return false;
+        error = "could not resolve user from filename";
+        return nullptr;
     }
 
     // Get a hub URL hint for the user (needed for download connections)
@@ -834,152 +1648,255 @@ bool DCBridge::openFileList(const std::string& fileListId) {
         hubHint = hubs.front();
     }
 
+    // Decode and parse with no lock held — bz2 + XML on a large list can
+    // take seconds and must not stall other file-list or hub access.
     try {
-        auto* listing = new DirectoryListing(HintedUser(user, hubHint));
-        listing->loadFile(path);
-        m_fileLists[fileListId] = listing;
-        return true;
+        auto listing =
+            std::make_shared<DirectoryListing>(HintedUser(user, hubHint));
+        if (progress) {
+            listing->loadXML(readFileListXml(path, progress), false);
+        } else {
+            listing->loadFile(path);
+        }
+        // Index here too, so the parse thread pays for it and not the
+        // first browse
+        return std::make_shared<const OpenFileList>(std::move(listing));
     } catch (const Exception& e) {
+        error = e.getError();
+        return nullptr;
+    }
+}
+
+bool DCBridge::openFileList(const std::string& fileListId) {
+    if (!m_initialized.load()) return false;
+
+    if (findFileList(fileListId)) return true; // Already open
+
+    std::string error;
+    auto listing = loadFileList(fileListId, error);
+    if (!listing) {
         fprintf(stderr, "DCBridge::openFileList: %s: %s\n",
-                path.c_str(), e.getError().c_str());
+                fileListId.c_str(), error.c_str());
         return false;
     }
+
+    indexFileList(fileListId, *listing);
+
+    // A concurrent open of the same list may have won; keep the first
+    auto lock = lockCounted(m_fileListMutex, m_fileListMutexCounters);
+    m_fileLists.emplace(fileListId, std::move(listing));
+    return true;
+}
+
+bool DCBridge::openFileListAsync(const std::string& fileListId) {
+    if (!m_initialized.load()) return false;
+
+    if (findFileList(fileListId)) {
+        BridgeListeners::getInstance().fileListLoaded(fileListId, true, "");
+        return true;
+    }
+
+    // Already queued or loading: its onFileListLoaded covers this call too
+    m_fileListLoader.submit(fileListId, [this, fileListId] {
+        auto& listeners = BridgeListeners::getInstance();
+        std::string error;
+        auto listing = loadFileList(fileListId, error,
+            [&](int pct) { listeners.fileListProgress(fileListId, pct); });
+        bool ok = listing != nullptr;
+        if (ok) {
+            indexFileList(fileListId, *listing);
+            auto lock = lockCounted(m_fileListMutex, m_fileListMutexCounters);
+            m_fileLists.emplace(fileListId, std::move(listing));
+        } else {
+            listeners.fileListProgress(fileListId, -1);
+        }
+        listeners.fileListLoaded(fileListId, ok, error);
+    });
+    return true;
+}
+
+void DCBridge::setFileListLoadThreads(int threads) {
+    m_fileListLoader.setThreads(threads > 0 ? static_cast<size_t>(threads)
+                                            : 0);
+}
+
+int DCBridge::getPendingFileListLoads() {
+    return static_cast<int>(m_fileListLoader.pending());
 }
 
 std::vector<FileListEntry> DCBridge::browseFileList(
         const std::string& fileListId,
-        const std::string& directory) {
+        const std::string& directory,
+        size_t offset, size_t limit) {
     std::vector<FileListEntry> result;
     if (!m_initialized.load()) return result;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    // Walk without any lock: the list is immutable and our shared_ptr
+    // keeps it alive even if closeFileList() runs meanwhile.
+    auto fl = findFileList(fileListId);
+    if (!fl) return result;
 
-    auto it = m_fileLists.find(fileListId);
-    if (it == m_fileLists.end()) return result;
-
-    auto* listing = it->second;
-    auto* dir = listing->getRoot();
-
-    // Navigate to requested directory
-    if (directory != "/" && !directory.empty()) {
-        StringTokenizer<string> st(directory, '/');
-        for (auto& tok : st.getTokens()) {
-            if (tok.empty()) continue;
-            bool found = false;
-            for (auto d : dir->directories) {
-                if (d->getName() == tok) {
-                    dir = d;
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) return result;
-        }
-    }
+    auto* dir = fl->index.findDir(directory);
+    if (!dir) return result;
 
-    // List directories
-    for (auto d : dir->directories) {
-        FileListEntry entry;
-        entry.name = d->getName();
-        entry.isDirectory = true;
-        entry.size = d->getTotalSize();
-        result.push_back(std::move(entry));
-    }
+    // Directories occupy [0, nDirs), files [nDirs, total)
+    size_t nDirs = dir->directories.size();
+    size_t total = nDirs + dir->files.size();
+    if (offset >= total) return result;
+    size_t end = (limit > 0) ? std::min(total, offset + limit) : total;
 
-    // List files
-    for (auto& f : dir->files) {
-        FileListEntry entry;
-        entry.name = f->getName();
-        entry.size = f->getSize();
-        entry.tth = f->getTTH().toBase32();
-        entry.isDirectory = false;
-        result.push_back(std::move(entry));
+    result.reserve(end - offset);
+    for (size_t i = offset; i < end; ++i) {
+        if (i < nDirs) {
+            result.push_back(dirEntry(dir->directories[i]));
+        } else {
+            result.push_back(fileEntry(dir->files[i - nDirs]));
+        }
     }
     return result;
 }
 
-bool DCBridge::downloadFileFromList(const std::string& fileListId,
-                                    const std::string& filePath,
-                                    const std::string& downloadTo) {
-    if (!m_initialized.load()) return false;
+FileListWalker DCBridge::walkFileList(const std::string& fileListId,
+                                      const std::string& root) {
+    if (!m_initialized.load()) return FileListWalker();
+    return FileListWalker(findFileList(fileListId), root);
+}
 
-    // Extract everything we need from the listing while holding m_mutex,
-    // then release it before calling into QueueManager (which fires
-    // synchronous callbacks through BridgeListeners/SWIG directors).
-    // Holding m_mutex during those callbacks risks ABBA deadlock with
-    // the GIL when a concurrent C++ thread also fires a callback.
-    int64_t fileSize = 0;
-    TTHValue fileTTH;
-    HintedUser hintedUser;
-    std::string target;
+FileListSearchPage DCBridge::searchFileLists(
+        const std::string& query, int fileType, int sizeMode, int64_t size,
+        size_t offset, size_t limit,
+        const std::vector<std::string>& fileListIds) {
+    FileListSearchPage page;
+    if (!m_initialized.load()) return page;
 
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
+    FileListSearchIndex::Query q;
+    if (!FileListSearchIndex::parseQuery(query, fileType, sizeMode, size, q))
+        return page;
 
-        auto it = m_fileLists.find(fileListId);
-        if (it == m_fileLists.end()) return false;
-
-        auto* listing = it->second;
-
-        // Split filePath into directory and filename parts (uses forward slash)
-        std::string directory = Util::getFilePath(filePath, '/');
-        std::string fname = Util::getFileName(filePath, '/');
-        if (fname.empty()) return false;
-
-        // Navigate to the directory containing the file
-        auto* dir = listing->getRoot();
-        if (!directory.empty() && directory != "/") {
-            StringTokenizer<std::string> st(directory, '/');
-            for (auto& tok : st.getTokens()) {
-                if (tok.empty()) continue;
-                bool found = false;
-                for (auto d : dir->directories) {
-                    if (d->getName() == tok) {
-                        dir = d;
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) return false;
+    // Pin the lists, then search them with no lock held
+    std::vector<std::pair<std::string,
+                          std::shared_ptr<const OpenFileList>>> lists;
+    {
+        auto lock = lockCounted(m_fileListMutex, m_fileListMutexCounters);
+        if (fileListIds.empty()) {
+            lists.assign(m_fileLists.begin(), m_fileLists.end());
+        } else {
+            for (const auto& id : fileListIds) {
+                auto it = m_fileLists.find(id);
+                if (it != m_fileLists.end()) lists.emplace_back(*it);
             }
         }
-
-        // Find the file in the directory
-        DirectoryListing::File* filePtr = nullptr;
-        for (auto f : dir->files) {
-            if (f->getName() == fname) {
-                filePtr = f;
-                break;
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    lists.erase(std::unique(lists.begin(), lists.end(),
+                            [](const auto& a, const auto& b) {
+                                return a.first == b.first;
+                            }),
+                lists.end());
+
+    // Lists are independent; each thread claims the next one.  Helpers
+    // come from the persistent search pool, so a query starts no
+    // threads.  The caller works too and then waits only for lists a
+    // helper has claimed: a helper that starts late finds none left and
+    // touches nothing but the shared counters.
+    struct SearchRun {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    const size_t n = lists.size();
+    auto run = std::make_shared<SearchRun>();
+    std::vector<std::vector<uint32_t>> matches(n);
+    auto work = [run, n, &lists, &matches, &q] {
+        for (;;) {
+            size_t i = run->next.fetch_add(1);
+            if (i >= n) break;
+            matches[i] = lists[i].second->words.match(q);
+            if (run->done.fetch_add(1) + 1 == n) {
+                std::lock_guard<std::mutex> lk(run->mutex);
+                run->cv.notify_all();
             }
         }
-        if (!filePtr) return false;
+    };
+    if (n > 1) {
+        uint64_t seq = m_fileListSearchSeq.fetch_add(1);
+        size_t helpers = std::min(n, m_fileListSearchPool.threads()) - 1;
+        for (size_t t = 0; t < helpers; ++t) {
+            m_fileListSearchPool.submit("/search/" + std::to_string(seq) +
+                                        "/" + std::to_string(t), work);
+        }
+    }
+    work();
+    {
+        std::unique_lock<std::mutex> lk(run->mutex);
+        run->cv.wait(lk, [&] { return run->done.load() == n; });
+    }
 
-        // Extract the data we need for QueueManager::add()
-        fileSize = filePtr->getSize();
-        fileTTH = filePtr->getTTH();
-        hintedUser = listing->getUser();
+    for (const auto& m : matches) page.total += m.size();
 
-        if (!hintedUser.user) {
-            fprintf(stderr, "DCBridge::downloadFileFromList: listing has null "
-                            "user for '%s'\n", fileListId.c_str());
-            return false;
+    // Paths are only built for the page handed out
+    size_t skip = offset;
+    for (size_t i = 0; i < lists.size(); ++i) {
+        const auto& m = matches[i];
+        if (skip >= m.size()) {
+            skip -= m.size();
+            continue;
         }
+        for (size_t j = skip; j < m.size(); ++j) {
+            if (limit > 0 && page.hits.size() == limit) return page;
+            page.hits.push_back(lists[i].second->words.entry(m[j]));
+            page.hits.back().fileListId = lists[i].first;
+        }
+        skip = 0;
+    }
+    return page;
+}
+
+// Download target for one file.  downloadTo (or the default download
+// directory) is a directory when it ends in a separator or has no '.',
+// otherwise it is taken as the full target filename.
+static std::string fileTarget(const std::string& downloadTo,
+                              const std::string& fname) {
+    std::string target = downloadTo.empty()
+        ? SETTING(DOWNLOAD_DIRECTORY)
+        : downloadTo;
+    if (!target.empty() && target.back() == PATH_SEPARATOR)
+        target += fname;
+    else if (!target.empty() && target.back() != PATH_SEPARATOR
+             && target.find('.') == std::string::npos)
+        target += PATH_SEPARATOR + fname;
+    return target;
+}
+
+bool DCBridge::downloadFileFromList(const std::string& fileListId,
+                                    const std::string& filePath,
+                                    const std::string& downloadTo) {
+    if (!m_initialized.load()) return false;
+
+    // Extract everything we need from the listing first, then call into
+    // QueueManager (which fires synchronous callbacks through
+    // BridgeListeners/SWIG directors).  No bridge lock is held during
+    // either step, so there is no ABBA deadlock with the GIL when a
+    // concurrent C++ thread also fires a callback.
+    auto fl = findFileList(fileListId);
+    if (!fl) return false;
 
-        // Build download target path
-        target = downloadTo.empty()
-            ? SETTING(DOWNLOAD_DIRECTORY)
-            : downloadTo;
-        if (!target.empty() && target.back() == PATH_SEPARATOR)
-            target += fname;
-        else if (!target.empty() && target.back() != PATH_SEPARATOR
-                 && target.find('.') == std::string::npos)
-            target += PATH_SEPARATOR + fname;
+    auto* filePtr = fl->index.findFile(filePath);
+    if (!filePtr) return false;
+
+    const HintedUser& hintedUser = fl->listing->getUser();
+    if (!hintedUser.user) {
+        fprintf(stderr, "DCBridge::downloadFileFromList: listing has null "
+                        "user for '%s'\n", fileListId.c_str());
+        return false;
     }
-    // m_mutex released — safe to call into dcpp (avoids ABBA deadlock
-    // between m_mutex and dcpp internal locks / GIL)
 
     try {
-        QueueManager::getInstance()->add(target, fileSize, fileTTH, hintedUser, 0);
+        QueueManager::getInstance()->add(
+            fileTarget(downloadTo, filePtr->getName()), filePtr->getSize(),
+            filePtr->getTTH(), hintedUser, 0);
     } catch (const Exception&) {
         return false;
     }
@@ -991,69 +1908,210 @@ bool DCBridge::downloadDirFromList(const std::string& fileListId,
                                    const std::string& downloadTo) {
     if (!m_initialized.load()) return false;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    auto it = m_fileLists.find(fileListId);
-    if (it == m_fileLists.end()) return false;
-
-    auto* listing = it->second;
+    // No bridge lock held: listing->download() calls QueueManager, whose
+    // synchronous callbacks come back through BridgeListeners.
+    auto fl = findFileList(fileListId);
+    if (!fl) return false;
 
-    if (!listing->getUser().user) {
+    if (!fl->listing->getUser().user) {
         fprintf(stderr, "DCBridge::downloadDirFromList: listing has null "
                         "user for '%s'\n", fileListId.c_str());
         return false;
     }
 
-    // Navigate to the requested directory
-    DirectoryListing::Directory* dir = nullptr;
-    if (dirPath.empty() || dirPath == "/") {
-        dir = listing->getRoot();
-    } else {
-        dir = listing->getRoot();
-        StringTokenizer<std::string> st(dirPath, '/');
-        for (auto& tok : st.getTokens()) {
-            if (tok.empty()) continue;
-            bool found = false;
-            for (auto d : dir->directories) {
-                if (d->getName() == tok) {
-                    dir = d;
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) return false;
-        }
-    }
+    auto* dir = fl->index.findDir(dirPath);
+    if (!dir) return false;
 
     std::string target = downloadTo.empty()
         ? SETTING(DOWNLOAD_DIRECTORY)
         : downloadTo;
 
     try {
-        listing->download(dir, target, false);
+        fl->listing->download(dir, target, false);
     } catch (const Exception&) {
         return false;
     }
     return true;
 }
 
-void DCBridge::closeFileList(const std::string& fileListId) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+int DCBridge::downloadFilesFromList(const std::string& fileListId,
+                                    const std::vector<std::string>& paths,
+                                    const std::string& downloadTo) {
+    if (!m_initialized.load()) return 0;
 
-    auto it = m_fileLists.find(fileListId);
-    if (it != m_fileLists.end()) {
-        delete it->second;
+    // One lookup for the whole batch, then plain index lookups per path
+    auto fl = findFileList(fileListId);
+    if (!fl) return 0;
+
+    const HintedUser& hintedUser = fl->listing->getUser();
+    if (!hintedUser.user) {
+        fprintf(stderr, "DCBridge::downloadFilesFromList: listing has null "
+                        "user for '%s'\n", fileListId.c_str());
+        return 0;
+    }
+
+    // Every entry lands inside downloadTo under its own name
+    std::string targetDir = downloadTo.empty()
+        ? SETTING(DOWNLOAD_DIRECTORY)
+        : downloadTo;
+    if (!targetDir.empty() && targetDir.back() != PATH_SEPARATOR)
+        targetDir += PATH_SEPARATOR;
+
+    int queued = 0;
+    auto* qm = QueueManager::getInstance();
+    for (const auto& path : paths) {
+        try {
+            if (auto* f = fl->index.findFile(path)) {
+                qm->add(targetDir + f->getName(), f->getSize(), f->getTTH(),
+                        hintedUser, 0);
+                ++queued;
+            } else if (auto* d = fl->index.findDir(path)) {
+                fl->listing->download(d, targetDir, false);
+                ++queued;
+            }
+        } catch (const Exception&) {
+            // Already queued, target exists, ... — carry on with the rest
+        }
+    }
+    return queued;
+}
+
+// Identity of a list file on disk, for spotting new or rewritten lists.
+static bool statListFile(const std::string& path, int64_t& mtime,
+                         int64_t& size) {
+    std::error_code ec;
+    auto t = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    auto sz = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    mtime = static_cast<int64_t>(t.time_since_epoch().count());
+    size = static_cast<int64_t>(sz);
+    return true;
+}
+
+void DCBridge::indexFileList(const std::string& fileListId,
+                             const OpenFileList& fl) {
+    TTHIndex::Source src;
+    src.fileListId = fileListId;
+    if (!statListFile(Util::getListPath() + fileListId, src.mtime,
+                      src.fileSize)) {
+        return;
+    }
+
+    std::vector<TTHIndex::RawTTH> tths;
+    std::vector<const DirectoryListing::Directory*> stack;
+    if (fl.listing->getRoot()) stack.push_back(fl.listing->getRoot());
+    while (!stack.empty()) {
+        const auto* dir = stack.back();
+        stack.pop_back();
+        for (auto* f : dir->files) {
+            tths.emplace_back();
+            memcpy(tths.back().data(), f->getTTH().data, TTHIndex::TTH_SIZE);
+        }
+        for (auto* d : dir->directories) stack.push_back(d);
+    }
+
+    auto lock = lockCounted(m_tthMutex, m_tthMutexCounters);
+    m_tthIndex.setSource(src, std::move(tths));
+}
+
+bool DCBridge::indexFileListAsync(const std::string& fileListId) {
+    // '/' cannot occur in a list file name, so this never collides with
+    // an openFileListAsync() job for the same list
+    return m_fileListLoader.submit("/tth/" + fileListId, [this, fileListId] {
+        std::string error;
+        auto fl = loadFileList(fileListId, error);
+        if (fl) indexFileList(fileListId, *fl);
+    });
+}
+
+std::vector<TTHSource> DCBridge::findSources(
+        const std::vector<std::string>& tths) {
+    std::vector<TTHSource> result;
+    if (!m_initialized.load()) return result;
+
+    std::vector<const TTHIndex::Source*> found;
+    auto lock = lockCounted(m_tthMutex, m_tthMutexCounters);
+    for (const auto& tth : tths) {
+        TTHIndex::RawTTH raw;
+        if (!TTHIndex::decodeTTH(tth, raw)) continue;
+        found.clear();
+        m_tthIndex.find(raw, found);
+        for (auto* src : found) {
+            TTHSource ts;
+            ts.tth = tth;
+            ts.fileListId = src->fileListId;
+            result.push_back(std::move(ts));
+        }
+    }
+    return result;
+}
+
+int DCBridge::refreshTTHIndex() {
+    if (!m_initialized.load()) return 0;
+
+    struct OnDisk {
+        int64_t mtime;
+        int64_t size;
+    };
+    std::unordered_map<std::string, OnDisk> onDisk;
+    auto listPath = Util::getListPath();
+    try {
+        for (auto& entry : std::filesystem::directory_iterator(listPath)) {
+            if (!entry.is_regular_file()) continue;
+            std::string name = entry.path().filename().string();
+            if (!endsWithNoCase(name, ".xml.bz2") &&
+                    !endsWithNoCase(name, ".xml")) {
+                continue;
+            }
+            OnDisk st;
+            if (statListFile(entry.path().string(), st.mtime, st.size)) {
+                onDisk.emplace(std::move(name), st);
+            }
+        }
+    } catch (const std::exception&) {
+        return 0;
+    }
+
+    std::vector<std::string> stale;
+    {
+        auto lock = lockCounted(m_tthMutex, m_tthMutexCounters);
+        for (const auto& id : m_tthIndex.sourceIds()) {
+            if (!onDisk.count(id)) m_tthIndex.removeSource(id);
+        }
+        for (const auto& [id, st] : onDisk) {
+            auto* src = m_tthIndex.source(id);
+            if (!src || src->mtime != st.mtime || src->fileSize != st.size) {
+                stale.push_back(id);
+            }
+        }
+    }
+
+    int queued = 0;
+    for (const auto& id : stale) {
+        if (indexFileListAsync(id)) ++queued;
+    }
+    return queued;
+}
+
+void DCBridge::closeFileList(const std::string& fileListId) {
+    std::shared_ptr<const OpenFileList> fl;
+    {
+        auto lock = lockCounted(m_fileListMutex, m_fileListMutexCounters);
+        auto it = m_fileLists.find(fileListId);
+        if (it == m_fileLists.end()) return;
+        fl = std::move(it->second);
         m_fileLists.erase(it);
     }
+    // Freed here (if no browse still holds it), outside the lock
 }
 
 void DCBridge::closeAllFileLists() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    for (auto& [id, listing] : m_fileLists) {
-        delete listing;
+    decltype(m_fileLists) lists;
+    {
+        auto lock = lockCounted(m_fileListMutex, m_fileListMutexCounters);
+        lists.swap(m_fileLists);
     }
-    m_fileLists.clear();
 }
 
 // =========================================================================
@@ -1122,6 +2180,58 @@ void DCBridge::refreshShare() {
     ShareManager::getInstance()->refresh(true, true, false);
 }
 
+bool DCBridge::refreshShareDir(const std::string& realPath) {
+    if (!m_initialized.load() || realPath.empty()) return false;
+    auto* sm = ShareManager::getInstance();
+
+    // The core only builds trees per share root, so find the root that
+    // holds realPath; the longest match wins for nested roots
+    std::string sep(1, PATH_SEPARATOR);
+    std::string want = realPath.back() == PATH_SEPARATOR
+        ? realPath : realPath + sep;
+    std::string root, virt;
+    for (auto& [v, real] : sm->getDirectories()) {
+        std::string r = (!real.empty() && real.back() == PATH_SEPARATOR)
+            ? real : real + sep;
+        if (want.compare(0, r.size(), r) == 0 && r.size() > root.size()) {
+            root = real;
+            virt = v;
+        }
+    }
+    if (root.empty()) return false;
+
+    auto& listeners = BridgeListeners::getInstance();
+
+    // The core has no rescan-in-place: the root is removed and added
+    // again, and a failed add leaves it unshared.  So check first that
+    // the walk can read it, and leave a gone or unreadable root (and its
+    // tree) as it is.
+    std::error_code ec;
+    if (!std::filesystem::is_directory(root, ec) ||
+            ::access(root.c_str(), R_OK | X_OK) != 0) {
+        listeners.statusMessage("", "Share refresh skipped: " + root +
+                                " is not a readable directory");
+        return false;
+    }
+
+    // Re-adding a root walks just that tree, here on the caller's thread;
+    // the hash database keeps the TTHs of unchanged files, so only new or
+    // modified ones are hashed
+    try {
+        sm->removeDirectory(root);
+        sm->addDirectory(root, virt);
+    } catch (const Exception& e) {
+        // Adding it back would fail the same way; it stays out of the
+        // share until the user adds it again, so say so
+        listeners.statusMessage("", "Share root " + root +
+                                " was removed from the share: " +
+                                e.getError());
+        return false;
+    }
+    sm->setDirty();
+    return true;
+}
+
 int64_t DCBridge::getShareSize() {
     if (!m_initialized.load()) return 0;
     return ShareManager::getInstance()->getShareSize();
@@ -1149,6 +2259,58 @@ TransferStats DCBridge::getTransferStats() {
     return stats;
 }
 
+StatusSnapshot DCBridge::getStatusSnapshot() const {
+    const StatusSnapshot* status = m_status.load(std::memory_order_acquire);
+    return status ? *status : StatusSnapshot();
+}
+
+void DCBridge::refreshStatusSnapshot() {
+    if (!m_initialized.load()) return;
+
+    // Never the published slot: readers may be copying it
+    ++m_statusSeq;
+    StatusSnapshot* status = &m_statusRing[m_statusSeq % STATUS_RING];
+    *status = StatusSnapshot();
+    status->seq = m_statusSeq;
+    status->timestamp = static_cast<int64_t>(time(nullptr));
+
+    for (const auto& hd : allHubs()) {
+        ++status->hubs;
+        std::lock_guard<std::mutex> lock(hd->infoMutex);
+        if (hd->cachedInfo.connected) {
+            ++status->connectedHubs;
+            status->users += hd->cachedInfo.userCount;
+        }
+    }
+    {
+        auto lock = lockCounted(m_queueMutex, m_queueMutexCounters);
+        status->queueItems = m_queue.size();
+    }
+    status->activeTransfers = static_cast<int>(
+        BridgeListeners::getInstance().activeTransferCount());
+
+    // Core accessors last, with every bridge lock released
+    status->shareSize = getShareSize();
+    status->sharedFiles = getSharedFileCount();
+    status->transfers = getTransferStats();
+    status->hashing = getHashStatus();
+
+    m_status.store(status, std::memory_order_release);
+}
+
+std::vector<TransferInfo> DCBridge::getActiveTransfers() {
+    if (!m_initialized.load()) return {};
+    return BridgeListeners::getInstance().getActiveTransfers();
+}
+
+void DCBridge::setTransferProgressInterval(int intervalMs) {
+    BridgeListeners::getInstance().setTransferProgressInterval(intervalMs);
+}
+
+int DCBridge::getTransferProgressInterval() const {
+    return BridgeListeners::getInstance().getTransferProgressInterval();
+}
+
 // =========================================================================
 // Hashing
 // =========================================================================
@@ -1176,58 +2338,206 @@ void DCBridge::pauseHashing(bool pause) {
     }
 }
 
+void DCBridge::setHashSpeedLimit(int mbPerSec) {
+    if (!m_initialized.load()) return;
+    SettingsManager::getInstance()->set(SettingsManager::MAX_HASH_SPEED,
+                                        mbPerSec < 0 ? 0 : mbPerSec);
+    markSettingsDirty();
+}
+
+int DCBridge::getHashSpeedLimit() {
+    if (!m_initialized.load()) return 0;
+    return SETTING(MAX_HASH_SPEED);
+}
+
+void DCBridge::setHashProgressInterval(int intervalMs) {
+    BridgeListeners::getInstance().setHashProgressInterval(intervalMs);
+}
+
+int DCBridge::getHashProgressInterval() const {
+    return BridgeListeners::getInstance().getHashProgressInterval();
+}
+
 // =========================================================================
 // Settings
 // =========================================================================
 
-std::string DCBridge::getSetting(const std::string& name) {
-    if (!m_initialized.load()) return "";
+// Float settings only exist in some dcpp versions; this compiles to
+// "not a float" when SettingsManager has no FloatSetting.
+template <typename SM, typename = void>
+struct FloatSettings {
+    static bool is(int) { return false; }
+    static std::string get(SM*, int) { return ""; }
+    static bool set(SM*, int, const std::string&) { return false; }
+};
+
+template <typename SM>
+struct FloatSettings<SM, std::void_t<typename SM::FloatSetting,
+                                     decltype(SM::TYPE_FLOAT)>> {
+    static bool is(int type) { return type == SM::TYPE_FLOAT; }
+
+    static std::string get(SM* sm, int n) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%g", static_cast<double>(
+            sm->get(static_cast<typename SM::FloatSetting>(n), true)));
+        return buf;
+    }
 
-    auto* sm = SettingsManager::getInstance();
+    static bool set(SM* sm, int n, const std::string& value) {
+        char* end = nullptr;
+        errno = 0;
+        double v = strtod(value.c_str(), &end);
+        if (value.empty() || *end || errno) return false;
+        sm->set(static_cast<typename SM::FloatSetting>(n),
+                static_cast<float>(v));
+        return true;
+    }
+};
+
+using FloatSetting = FloatSettings<SettingsManager>;
+
+// Whole decimal number within [lo, hi]; no trailing junk
+static bool parseInteger(const std::string& value, int64_t lo, int64_t hi,
+                         int64_t& out) {
+    if (value.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    long long v = strtoll(value.c_str(), &end, 10);
+    if (*end || errno || v < lo || v > hi) return false;
+    out = v;
+    return true;
+}
+
+bool DCBridge::resolveSetting(const std::string& name, SettingRef& out) {
+    {
+        std::lock_guard<std::mutex> lock(m_settingsMutex);
+        auto it = m_settingIndex.find(name);
+        if (it != m_settingIndex.end()) {
+            out = it->second;
+            return true;
+        }
+    }
 
-    // Resolve setting name → enum index + type.
+    // Linear scan of the tag table; misses are not cached, so
+    // arbitrary names from the API cannot grow the index
     int n = 0;
     SettingsManager::Types type{};
-    if (!sm->getType(name.c_str(), n, type))
-        return "";  // unknown setting name
+    if (!SettingsManager::getInstance()->getType(name.c_str(), n, type))
+        return false;
+    out.index = n;
+    out.type = static_cast<int>(type);
+    std::lock_guard<std::mutex> lock(m_settingsMutex);
+    m_settingIndex.emplace(name, out);
+    return true;
+}
+
+std::string DCBridge::readSetting(const SettingRef& ref) {
+    auto* sm = SettingsManager::getInstance();
+    int n = ref.index;
 
     // Read with useDefault=true so defaults (e.g. DownloadDirectory) are
     // returned even when the user hasn't explicitly overridden them.
-    if (type == SettingsManager::TYPE_STRING)
+    switch (ref.type) {
+    case SettingsManager::TYPE_STRING:
         return sm->get(static_cast<SettingsManager::StrSetting>(n), true);
-    else if (type == SettingsManager::TYPE_INT)
+    case SettingsManager::TYPE_INT:
         return std::to_string(sm->get(static_cast<SettingsManager::IntSetting>(n), true));
-    else if (type == SettingsManager::TYPE_INT64)
+    case SettingsManager::TYPE_INT64:
         return std::to_string(sm->get(static_cast<SettingsManager::Int64Setting>(n), true));
+    default:
+        return FloatSetting::is(ref.type) ? FloatSetting::get(sm, n) : "";
+    }
+}
+
+bool DCBridge::writeSetting(const SettingRef& ref, const std::string& value) {
+    auto* sm = SettingsManager::getInstance();
+    int n = ref.index;
+    int64_t v = 0;
+
+    switch (ref.type) {
+    case SettingsManager::TYPE_STRING:
+        sm->set(static_cast<SettingsManager::StrSetting>(n), value);
+        return true;
+    case SettingsManager::TYPE_INT:
+        if (!parseInteger(value, INT32_MIN, INT32_MAX, v)) return false;
+        sm->set(static_cast<SettingsManager::IntSetting>(n), static_cast<int>(v));
+        return true;
+    case SettingsManager::TYPE_INT64:
+        if (!parseInteger(value, INT64_MIN, INT64_MAX, v)) return false;
+        sm->set(static_cast<SettingsManager::Int64Setting>(n), v);
+        return true;
+    default:
+        return FloatSetting::is(ref.type) && FloatSetting::set(sm, n, value);
+    }
+}
+
+std::string DCBridge::getSetting(const std::string& name) {
+    if (!m_initialized.load()) return "";
 
-    return "";
+    SettingRef ref;
+    if (!resolveSetting(name, ref)) return "";  // unknown setting name
+    return readSetting(ref);
 }
 
-void DCBridge::setSetting(const std::string& name,
+bool DCBridge::setSetting(const std::string& name,
                           const std::string& value) {
-    if (!m_initialized.load()) return;
+    if (!m_initialized.load()) return false;
 
-    auto* sm = SettingsManager::getInstance();
+    SettingRef ref;
+    if (!resolveSetting(name, ref) || !writeSetting(ref, value)) return false;
+    markSettingsDirty();
+    return true;
+}
 
-    int n = 0;
-    SettingsManager::Types type{};
-    if (!sm->getType(name.c_str(), n, type))
-        return;  // unknown setting name
+std::map<std::string, std::string> DCBridge::getSettings(
+        const std::vector<std::string>& names) {
+    std::map<std::string, std::string> result;
+    if (!m_initialized.load()) return result;
 
-    if (type == SettingsManager::TYPE_STRING)
-        sm->set(static_cast<SettingsManager::StrSetting>(n), value);
-    else if (type == SettingsManager::TYPE_INT)
-        sm->set(static_cast<SettingsManager::IntSetting>(n), std::atoi(value.c_str()));
-    else if (type == SettingsManager::TYPE_INT64)
-        sm->set(static_cast<SettingsManager::Int64Setting>(n),
-                static_cast<int64_t>(std::atoll(value.c_str())));
+    SettingRef ref;
+    for (const auto& name : names) {
+        if (resolveSetting(name, ref)) result[name] = readSetting(ref);
+    }
+    return result;
+}
+
+int DCBridge::setSettings(const std::map<std::string, std::string>& values) {
+    if (!m_initialized.load()) return 0;
 
-    // Save to disk so changes persist
-    sm->save();
+    int applied = 0;
+    SettingRef ref;
+    for (const auto& [name, value] : values) {
+        if (resolveSetting(name, ref) && writeSetting(ref, value)) ++applied;
+    }
+    if (applied > 0) markSettingsDirty();
+    return applied;
+}
+
+void DCBridge::markSettingsDirty() {
+    uint64_t now = GET_TICK();
+    m_settingsDirtyAt.store(now ? now : 1);
+}
+
+void DCBridge::saveSettings() {
+    if (!m_initialized.load()) return;
+    if (m_settingsDirtyAt.exchange(0) == 0) return;
+    SettingsManager::getInstance()->save();
+}
+
+void DCBridge::saveSettingsIfIdle(uint64_t tick) {
+    static const uint64_t SAVE_DELAY_MS = 2000;
+
+    uint64_t at = m_settingsDirtyAt.load();
+    if (at == 0 || tick - at < SAVE_DELAY_MS) return;
+    // A change racing in after the exchange marks it dirty again and
+    // is saved on a later tick
+    if (!m_settingsDirtyAt.compare_exchange_strong(at, 0)) return;
+    SettingsManager::getInstance()->save();
 }
 
 void DCBridge::reloadConfig() {
     if (!m_initialized.load()) return;
+    saveSettings();
     SettingsManager::getInstance()->load();
 }
 
@@ -1362,14 +2672,36 @@ void DCBridge::startNetworking() {
 // Internal helpers
 // =========================================================================
 
-DCBridge::HubData* DCBridge::findHub(const std::string& url) {
+DCBridge::HubPtr DCBridge::findHub(const std::string& url) const {
+    auto lock = lockCountedShared(m_hubsMutex, m_hubsMutexCounters);
     auto it = m_hubs.find(url);
-    return (it != m_hubs.end()) ? &it->second : nullptr;
+    return (it != m_hubs.end()) ? it->second : nullptr;
+}
+
+DCBridge::HubPtr DCBridge::findHub(const dcpp::Client* client) const {
+    auto lock = lockCountedShared(m_hubsMutex, m_hubsMutexCounters);
+    auto it = m_hubsByClient.find(client);
+    return (it != m_hubsByClient.end()) ? it->second : nullptr;
+}
+
+std::vector<DCBridge::HubPtr> DCBridge::allHubs() const {
+    std::vector<HubPtr> hubs;
+    auto lock = lockCountedShared(m_hubsMutex, m_hubsMutexCounters);
+    hubs.reserve(m_hubs.size());
+    for (const auto& [url, hd] : m_hubs) hubs.push_back(hd);
+    return hubs;
 }
 
-dcpp::Client* DCBridge::findClient(const std::string& url) {
-    auto* hd = findHub(url);
+dcpp::Client* DCBridge::findClient(const std::string& url) const {
+    auto hd = findHub(url);
     return hd ? hd->client : nullptr;
 }
 
+std::shared_ptr<const OpenFileList> DCBridge::findFileList(
+        const std::string& fileListId) const {
+    auto lock = lockCounted(m_fileListMutex, m_fileListMutexCounters);
+    auto it = m_fileLists.find(fileListId);
+    return (it != m_fileLists.end()) ? it->second : nullptr;
+}
+
 } // namespace eiskaltdcpp_py
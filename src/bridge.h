@@ -15,18 +15,36 @@
 
 #include <string>
 #include <vector>
+#include <array>
 #include <cstdint>
 #include <mutex>
+#include <shared_mutex>
+#include <memory>
 #include <atomic>
-#include <deque>
+#include <condition_variable>
+#include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <stdexcept>
+#include <functional>
+#include <thread>
 
 #include "types.h"
+#include "chat_history.h"
+#include "chat_log.h"
+#include "file_list_loader.h"
+#include "file_list_walker.h"
+#include "metrics.h"
+#include "queue_store.h"
+#include "search_scheduler.h"
+#include "search_store.h"
+#include "tth_index.h"
+#include "user_store.h"
 
 // Forward declare the callback interface
 namespace eiskaltdcpp_py {
 class DCClientCallback;
+struct OpenFileList;
 }
 
 // Forward declare dcpp types we use (avoid including heavy headers here)
@@ -79,7 +97,8 @@ public:
  *
  * Lifecycle:
  *   1. Construct a DCBridge instance
- *   2. Call initialize(configDir)
+ *   2. Call initialize(configDir), or initializeAsync(configDir) and
+ *      wait for onCoreReady
  *   3. Optionally setCallback(handler) for events
  *   4. Use connectHub(), search(), addToQueue(), etc.
  *   5. Call shutdown() when done
@@ -108,20 +127,112 @@ public:
     /// @return true on success
     bool initialize(const std::string& configDir = "");
 
-    /// Shut down cleanly — disconnects all hubs, saves state.
+    /// Start the core on a background thread and return at once.
+    /// Settings, the hash database, the share and the download queue
+    /// load there (the bridge's TTH index alongside them); onCoreReady
+    /// fires when they are done.  Until then getInitPhase() is
+    /// INIT_LOADING and every other call behaves as if uninitialized.
+    /// Set the callback first to receive onCoreReady.
+    /// @return false if the config directory cannot be created or the
+    ///         core already runs in this process; true if loading (or
+    ///         already loaded)
+    bool initializeAsync(const std::string& configDir = "");
+
+    /// Shut down cleanly — disconnects all hubs, saves state.  Waits
+    /// for a start under way (INIT_LOADING) to finish first, including
+    /// one whose background thread has not been spawned yet.
     void shutdown();
 
-    /// Whether initialize() has been called successfully.
+    /// Whether the core is loaded and usable (INIT_READY).
     bool isInitialized() const;
 
+    /// Startup progress (InitPhase).
+    int getInitPhase() const;
+
+    /// What startup is loading now ("Hash database", "Shared Files",
+    /// ...), or after INIT_FAILED, why it failed.
+    std::string getInitStep() const;
+
     // =====================================================================
     // Callbacks
     // =====================================================================
 
     /// Set event callback handler. Pass nullptr to disable.
-    /// Caller retains ownership of the callback object.
+    /// Caller retains ownership of the callback object.  May be set
+    /// before initialize(); it takes effect once this bridge starts.
     void setCallback(DCClientCallback* cb);
 
+    /// Select how events are delivered.
+    /// DISPATCH_DIRECT (default) calls the callback on the dcpp thread
+    /// that produced the event, taking the GIL each time.
+    /// DISPATCH_QUEUED packs events into a bounded lock-free ring instead;
+    /// drain it with pollEvents().  dcpp threads never block — when the
+    /// ring is full new events are dropped and counted.
+    /// @param queueCapacity  Ring size, used the first time queued mode is
+    ///                       enabled (rounded up to a power of two).
+    void setDispatchMode(int mode, size_t queueCapacity = 65536);
+
+    /// Current dispatch mode (DISPATCH_DIRECT or DISPATCH_QUEUED).
+    int getDispatchMode() const;
+
+    /// Drain up to maxEvents queued events (<= 0 drains everything).
+    std::vector<BridgeEvent> pollEvents(int maxEvents = 1000);
+
+    /// File descriptor that becomes readable when queued events arrive,
+    /// for asyncio's loop.add_reader() or select().  Call pollEvents()
+    /// when it fires; that also resets it.  -1 if unavailable.
+    int getEventFd();
+
+    /// Ring depth plus queued / dropped / polled counters.
+    EventQueueStats getEventQueueStats() const;
+
+    /// Coalesce UserUpdated / UserRemoved bursts: instead of one
+    /// onUserConnected / onUserDisconnected per event, deliver the latest
+    /// state per nick once a second via onUsersConnectedBatch /
+    /// onUsersRemovedBatch, whose defaults fan back out to the per-user
+    /// callbacks.  The user list itself is always kept current.
+    void setUserEventCoalescing(bool enable);
+
+    /// Whether user events are being coalesced.
+    bool getUserEventCoalescing() const;
+
+    /// Set what happens to events of one EventType — see EventPolicy.
+    /// Lets a noisy hub's chat, status or search flood be dropped,
+    /// coalesced or rate-limited before it reaches Python.  Batch
+    /// callbacks (onUsersUpdatedBatch, ...) follow their per-item type:
+    /// POLICY_DROP drops the batch, and under POLICY_COALESCE or
+    /// POLICY_RATE_LIMIT its items are delivered one by one through the
+    /// per-item callback so the policy applies to each.
+    /// Returns false for an unknown event type or policy.  EVENT_CORE_READY
+    /// is always delivered (whatever the event mask) and takes only
+    /// POLICY_DELIVER.
+    bool setEventPolicy(int eventType, int policy, int ratePerSecond = 0);
+
+    /// Current EventPolicy for a type (POLICY_DELIVER if unknown).
+    int getEventPolicy(int eventType) const;
+
+    /// Policy and delivered / dropped / coalesced counters per EventType.
+    std::vector<EventPolicyStats> getEventPolicyStats() const;
+
+    /// Back to POLICY_DELIVER everywhere with zeroed counters; held
+    /// coalesced events are delivered first.
+    void resetEventPolicies();
+
+    /// Subscribe to a subset of events: bit (1 << EventType) set means
+    /// deliver.  Masked events are discarded in the listener thread before
+    /// any string is copied or the GIL is taken — a chat bot typically
+    /// wants only chat and private messages.  Default: everything.
+    void setEventMask(uint64_t mask);
+
+    /// Current event mask.
+    uint64_t getEventMask() const;
+
+    /// Always-on instrumentation: per-EventType raised / skipped counts
+    /// and callback latency histograms, bridge mutex contention, and the
+    /// depth of the event ring and every other internal backlog.  Cheap
+    /// enough to scrape every few seconds.
+    BridgeMetrics getMetrics();
+
     // =====================================================================
     // Hub connections
     // =====================================================================
@@ -141,6 +252,17 @@ public:
     /// Check if connected to a specific hub.
     bool isHubConnected(const std::string& hubUrl);
 
+    /// Approximate memory held by each hub's users, chat history and
+    /// search results.
+    std::vector<HubMemoryStats> getHubMemoryStats();
+
+    /// Cap what one hub may hold: users kept in its user list (joins
+    /// beyond the cap are dropped and counted), chat lines (same as
+    /// setChatHistoryCapacity) and stored search results across all
+    /// searches.  0 = unlimited for users and results.
+    void setHubLimits(int maxUsers, int maxChatLines, int maxResults);
+    HubLimits getHubLimits() const;
+
     // =====================================================================
     // Chat
     // =====================================================================
@@ -154,10 +276,49 @@ public:
                 const std::string& nick,
                 const std::string& message);
 
-    /// Get buffered chat history for a hub (most recent lines).
+    /// Get buffered chat history for a hub (most recent lines), as
+    /// "<nick> text".
     std::vector<std::string> getChatHistory(const std::string& hubUrl,
                                             int maxLines = 50);
 
+    /// Chat lines with seq > sinceSeq, oldest first, at most maxEntries
+    /// (0 = all).  Tail a hub by passing back the returned lastSeq.
+    ChatHistoryPage getChatHistorySince(const std::string& hubUrl,
+                                        uint64_t sinceSeq = 0,
+                                        int maxEntries = 0);
+
+    /// Lines of chat kept per hub (default 500), applied to connected
+    /// hubs immediately.  0 disables the history.
+    void setChatHistoryCapacity(int lines);
+    int getChatHistoryCapacity() const;
+
+    /// Append chat, PMs and status messages of every hub to an on-disk
+    /// log in C++, without going through Python.  directory defaults to
+    /// <config>/ChatLog.  Segments rotate at maxSegmentBytes (0 = never)
+    /// and beyond maxSegments (0 = keep all) the oldest are deleted;
+    /// writes are fsynced at most every fsyncIntervalMs.  Returns false
+    /// if the directory or newest segment cannot be opened.
+    bool enableChatLog(const std::string& directory = "",
+                       int64_t maxSegmentBytes = 64LL << 20,
+                       int maxSegments = 0, int fsyncIntervalMs = 1000);
+
+    /// Flush, fsync and stop logging.
+    void disableChatLog();
+
+    bool isChatLogEnabled() const;
+
+    /// Write out and fsync everything buffered so far.
+    void flushChatLog();
+
+    /// Logged lines for hubUrl ("" = all hubs) received in
+    /// [fromTime, toTime) (Unix seconds; toTime 0 = no upper bound),
+    /// oldest first, at most maxEntries (0 = all).  Read via mmap; works
+    /// on the last directory logged to even after disableChatLog().
+    std::vector<ChatLogEntry> queryChatLog(const std::string& hubUrl = "",
+                                           int64_t fromTime = 0,
+                                           int64_t toTime = 0,
+                                           int maxEntries = 0);
+
     // =====================================================================
     // Users
     // =====================================================================
@@ -169,6 +330,15 @@ public:
     UserInfo getUserInfo(const std::string& nick,
                          const std::string& hubUrl);
 
+    /// Current user-list revision for a hub (0 if unknown).
+    uint64_t getHubUserRevision(const std::string& hubUrl);
+
+    /// Joins, parts and updates since sinceRevision (0 = everything).
+    /// Cost scales with churn rather than hub size; see UserChanges for
+    /// how to apply the result.
+    UserChanges getHubUserChanges(const std::string& hubUrl,
+                                  uint64_t sinceRevision = 0);
+
     // =====================================================================
     // Search
     // =====================================================================
@@ -187,11 +357,73 @@ public:
                 int64_t size = 0,
                 const std::string& hubUrl = "");
 
-    /// Get accumulated search results.
+    /// Same as search(), but returns the search token ("" on failure).
+    /// Results are filed under that token — see getSearchResults(token,
+    /// offset, limit).
+    std::string startSearch(const std::string& query,
+                            int fileType = 0,
+                            int sizeMode = 0,
+                            int64_t size = 0,
+                            const std::string& hubUrl = "");
+
+    /// Queue a search instead of sending it now.  The bridge sends it to
+    /// each hub (hubUrl, or every hub tracked when empty) as soon as that
+    /// hub's minimum search interval has passed, highest priority first,
+    /// and backs off on hubs that report a search flood.  A TTH search
+    /// already pending or just sent to the same hubs is not repeated.
+    /// @return Token the results are filed under — an existing search's
+    ///         token when deduplicated — or "" if there is no such hub.
+    std::string queueSearch(const std::string& query,
+                            int fileType = 0,
+                            int sizeMode = 0,
+                            int64_t size = 0,
+                            const std::string& hubUrl = "",
+                            int priority = 0);
+
+    /// Drop a queued search before it reaches the remaining hubs.  Its
+    /// results so far stay in the store.
+    bool cancelQueuedSearch(const std::string& token);
+
+    /// Searches still waiting for at least one hub, in sending order.
+    std::vector<QueuedSearchInfo> listQueuedSearches();
+
+    /// Minimum seconds between searches sent to one hub (default 10).
+    /// Flood backoff multiplies it per hub.
+    void setSearchInterval(int seconds);
+    int getSearchInterval() const;
+
+    /// Get accumulated search results (all searches), optionally only
+    /// those received from one hub.
     std::vector<SearchResultInfo> getSearchResults(
         const std::string& hubUrl = "");
 
-    /// Clear search results.
+    /// One page of the results for a search token.  limit <= 0 returns
+    /// everything from offset on.  Token "" holds results that matched
+    /// no active search.
+    std::vector<SearchResultInfo> getSearchResults(
+        const std::string& token, int offset, int limit);
+
+    /// Number of results stored for a search token.
+    int getSearchResultCount(const std::string& token);
+
+    /// Immutable view of a search's results, taken without copying them.
+    /// It can be indexed, sliced and packed into columns from Python long
+    /// after the store has moved on (or dropped the search).
+    SearchResultSnapshot getSearchSnapshot(const std::string& token);
+
+    /// Tokens of the searches still held, most recently active first.
+    std::vector<std::string> listSearches();
+
+    /// Drop one search and its results.
+    bool forgetSearch(const std::string& token);
+
+    /// Bound the result store: per-search result cap, number of searches
+    /// kept (least recently used evicted first), and idle TTL in seconds
+    /// (0 = never expire).
+    void setSearchLimits(int maxResultsPerSearch, int maxSearches,
+                         int ttlSeconds);
+
+    /// Clear search results (from one hub, or all when hubUrl is empty).
     void clearSearchResults(const std::string& hubUrl = "");
 
     // =====================================================================
@@ -208,9 +440,22 @@ public:
     bool addMagnet(const std::string& magnetLink,
                    const std::string& downloadDir = "");
 
+    /// Queue many files in one call.  Per-item onQueueItemAdded callbacks
+    /// are replaced by a single onQueueItemsAddedBatch.  Returns how many
+    /// were added.
+    int addToQueueBatch(const std::vector<QueueAddItem>& items);
+
+    /// addMagnet() for many links; malformed links are skipped.
+    int addMagnetBatch(const std::vector<std::string>& magnetLinks,
+                       const std::string& downloadDir = "");
+
     /// Remove an item from the queue.
     void removeFromQueue(const std::string& target);
 
+    /// Remove many items; one onQueueItemsRemovedBatch instead of a
+    /// callback per item.  Returns how many were in the queue.
+    int removeFromQueueBatch(const std::vector<std::string>& targets);
+
     /// Move a queued item.
     void moveQueueItem(const std::string& source,
                        const std::string& target);
@@ -218,14 +463,34 @@ public:
     /// Set queue item priority (0=paused..5=highest).
     void setPriority(const std::string& target, int priority);
 
-    /// List all items in the download queue.
+    /// Set the same priority on many items.  Returns how many were in
+    /// the queue.
+    int setPriorityBatch(const std::vector<std::string>& targets,
+                         int priority);
+
+    /// List all items in the download queue, in target order.
+    /// Served from the bridge's queue mirror — never locks the core queue.
+    /// Source counts and downloaded bytes are as of the item's last
+    /// queue event (add, status or source change).
     std::vector<QueueItemInfo> listQueue();
 
-    /// Clear entire download queue.
+    /// Up to limit items starting at offset (limit <= 0: to the end).
+    QueuePage listQueuePage(int offset, int limit);
+
+    /// Current queue revision (bumped by every change seen).
+    uint64_t getQueueRevision();
+
+    /// Additions, changes and removals since sinceRevision
+    /// (0 = everything); see QueueChanges for how to apply the result.
+    QueueChanges getQueueChanges(uint64_t sinceRevision = 0);
+
+    /// Clear entire download queue (reported as one removal batch).
     void clearQueue();
 
-    /// Match all downloaded file lists against queue.
-    void matchAllLists();
+    /// Add every indexed file list that has a queued file's TTH as a
+    /// source for it.  Uses the TTH index only — no list is re-parsed.
+    /// Returns the number of sources added.
+    int matchAllLists();
 
     // =====================================================================
     // File lists
@@ -239,13 +504,50 @@ public:
     /// List locally available file list files.
     std::vector<std::string> listLocalFileLists();
 
-    /// Open a downloaded file list for browsing.
+    /// Open a downloaded file list for browsing.  Blocks until the list
+    /// is parsed — see openFileListAsync() for large lists.
     bool openFileList(const std::string& fileListId);
 
-    /// Browse a directory in an opened file list.
+    /// Open a file list on a background loader thread.  Returns false only
+    /// if the bridge is not initialized; the outcome arrives through
+    /// onFileListLoaded (at once if the list is already open).  Asking for
+    /// a list that is still loading does not start a second load.
+    bool openFileListAsync(const std::string& fileListId);
+
+    /// Maximum concurrent background loads (0 = one per hardware thread).
+    void setFileListLoadThreads(int threads);
+
+    /// Background loads queued or running.
+    int getPendingFileListLoads();
+
+    /// Browse a directory in an opened file list: subdirectories first,
+    /// then files, from entry offset on, at most limit (0 = all).
     std::vector<FileListEntry> browseFileList(
         const std::string& fileListId,
-        const std::string& directory = "/");
+        const std::string& directory = "/",
+        size_t offset = 0, size_t limit = 0);
+
+    /// Depth-first cursor over everything under root in an opened file
+    /// list; each entry carries its path from the list root.  Exhausted
+    /// at once if the list is not open or root does not exist.
+    FileListWalker walkFileList(const std::string& fileListId,
+                                const std::string& root = "/");
+
+    /// Search the word indexes of opened file lists (fileListIds, or
+    /// all when empty), on up to one thread per core (the caller plus
+    /// parked workers of a persistent pool).  Arguments mean
+    /// what they do for search(), except that query words match name
+    /// words they are a prefix of.  Hits are ordered by list id and then
+    /// by walk order; offset/limit (0 = all) page through them.
+    FileListSearchPage searchFileLists(
+        const std::string& query,
+        int fileType = 0,
+        int sizeMode = 0,
+        int64_t size = 0,
+        size_t offset = 0,
+        size_t limit = 100,
+        const std::vector<std::string>& fileListIds =
+            std::vector<std::string>());
 
     /// Download a file from an opened file list.
     bool downloadFileFromList(const std::string& fileListId,
@@ -257,9 +559,27 @@ public:
                              const std::string& dirPath,
                              const std::string& downloadTo);
 
+    /// Queue many files and/or directories from one opened file list.
+    /// downloadTo is a directory; each entry keeps its own name inside it.
+    /// Returns how many paths were found and queued.
+    int downloadFilesFromList(const std::string& fileListId,
+                              const std::vector<std::string>& paths,
+                              const std::string& downloadTo = "");
+
     /// Close an opened file list.
     void closeFileList(const std::string& fileListId);
 
+    /// File lists (from the TTH index over every downloaded list) that
+    /// contain each of tths, grouped in the order asked.
+    std::vector<TTHSource> findSources(const std::vector<std::string>& tths);
+
+    /// Bring the TTH index in line with the list directory: forget lists
+    /// that were deleted and (re)index, on the loader pool, those that are
+    /// new or changed on disk.  Lists downloaded or opened through the
+    /// bridge are indexed as they arrive, so this is only needed for files
+    /// placed there behind our back.  Returns how many lists were queued.
+    int refreshTTHIndex();
+
     /// Close all opened file lists.
     void closeAllFileLists();
 
@@ -284,6 +604,23 @@ public:
     /// Refresh (rescan) shared directories.
     void refreshShare();
 
+    /// Rescan one shared directory instead of the whole share.  For a
+    /// share root, only that root is rewalked (files already hashed are
+    /// not hashed again).  For a path inside a root, the enclosing root
+    /// is.  Returns false if realPath is not in the share, its root is
+    /// no longer a readable directory (the share is left untouched), or
+    /// the core refuses to add the root back — it is then out of the
+    /// share until added again.  Both failures also fire
+    /// onStatusMessage with an empty hub URL and the reason.
+    ///
+    /// The walk (ShareManager::buildTree) runs synchronously on the
+    /// calling thread, unlike refreshShare(); the REST route calls it from
+    /// a worker thread so the API's event loop is not held up.  The core
+    /// rescans by removing the root and adding it back, so for the length
+    /// of the walk the root's files are not shared: searches miss them
+    /// and our own file list leaves them out.
+    bool refreshShareDir(const std::string& realPath);
+
     /// Get total share size.
     int64_t getShareSize();
 
@@ -297,6 +634,24 @@ public:
     /// Get aggregate transfer statistics.
     TransferStats getTransferStats();
 
+    /// Hub, share, queue, transfer and hashing totals as of the last
+    /// core Second tick.  Never takes a bridge lock or calls the core, so
+    /// any number of pollers cost the same as one; seq is 0 until the
+    /// first tick after initialize().  Wait-free: one acquire load of
+    /// the published pointer and a copy of what it points at.
+    StatusSnapshot getStatusSnapshot() const;
+
+    /// Every upload and download in progress, refreshed from the core's
+    /// once-a-second transfer ticks (no core locks taken).
+    std::vector<TransferInfo> getActiveTransfers();
+
+    /// Push getActiveTransfers() to onTransferProgress every intervalMs
+    /// (0 = off, the default).  Effective resolution is one second.
+    void setTransferProgressInterval(int intervalMs);
+
+    /// Current progress interval in ms (0 = off).
+    int getTransferProgressInterval() const;
+
     // =====================================================================
     // Hashing
     // =====================================================================
@@ -307,17 +662,45 @@ public:
     /// Pause/resume hashing.
     void pauseHashing(bool pause = true);
 
+    /// Cap hashing reads at mbPerSec MiB/s (0 = unlimited); persisted as
+    /// the core's MaxHashSpeed setting by the debounced settings save.
+    /// The core hashes one file at a time, so this is the whole hashing
+    /// I/O budget.
+    void setHashSpeedLimit(int mbPerSec);
+    int getHashSpeedLimit();
+
+    /// Fire onHashProgress every intervalMs (0 = off, the default) while
+    /// files are waiting to be hashed, and once more when they are done.
+    /// Effective resolution is one second.
+    void setHashProgressInterval(int intervalMs);
+    int getHashProgressInterval() const;
+
     // =====================================================================
     // Settings
     // =====================================================================
 
-    /// Get a setting by name.
+    /// Get a setting by name ("" for an unknown name).  Names are
+    /// resolved once and cached.
     std::string getSetting(const std::string& name);
 
-    /// Set a setting by name.
-    void setSetting(const std::string& name, const std::string& value);
+    /// Set a setting by name.  Returns false for an unknown name or a
+    /// value that does not parse as the setting's type.  The write to
+    /// disk is deferred until no setting has changed for two seconds
+    /// (or saveSettings() / shutdown()).
+    bool setSetting(const std::string& name, const std::string& value);
+
+    /// Values of several settings; unknown names are left out.
+    std::map<std::string, std::string> getSettings(
+        const std::vector<std::string>& names);
 
-    /// Reload configuration from disk.
+    /// Apply several settings with one deferred save.  Returns how many
+    /// were applied; unknown names and unparsable values are skipped.
+    int setSettings(const std::map<std::string, std::string>& values);
+
+    /// Write pending setting changes to disk now.
+    void saveSettings();
+
+    /// Reload configuration from disk.  Pending changes are saved first.
     void reloadConfig();
 
     /// (Re)start the networking stack — opens TCP/UDP listeners based on
@@ -355,41 +738,234 @@ public:
 
     // BridgeListeners needs access to hub data for stashing chat/results
     friend class BridgeListeners;
+    // tests/bridge_bench.cpp publishes synthetic hubs and queue items
+    friend class BridgeBench;
 
 private:
+    /// Claim the core and set up the config directory and paths.  Moves
+    /// the phase INIT_NONE → INIT_LOADING; false (phase unchanged) if
+    /// another start is under way or the core already runs.
+    bool prepareInit(const std::string& configDir);
+
+    /// dcpp::startup() and the bridge's own loading; ends in INIT_READY
+    /// or INIT_FAILED and fires onCoreReady.
+    void runStartup();
+
+    /// Join the background start, unless called from it.
+    void joinInitThread();
+
+    /// dcpp::startup() progress callback; bridge is the DCBridge.
+    static void onStartupStep(void* bridge, const std::string& step);
+
     // Internal types matching ServerThread pattern
     struct HubData {
+        // Set before the hub is published in m_hubs and never changed,
+        // so they are read without any lock.
         dcpp::Client* client = nullptr;
-        std::deque<std::string> chatHistory;
-        std::vector<SearchResultInfo> searchResults;
-        // Per-hub user map: nick → UserInfo, populated by
+        int id = 0;
+
+        // Guards chatHistory and users.  One lock per hub: ingestion on
+        // one hub's socket thread never waits for another hub's.
+        mutable std::mutex mutex;
+        ChatHistory chatHistory;
+        // Per-hub user list (interned, columnar), populated by
         // ClientListener::UserUpdated / UserRemoved callbacks.
-        std::unordered_map<std::string, UserInfo> users;
+        UserStore users;
+        // Users refused by m_maxHubUsers: only nick and share are kept,
+        // so the hub's user count and share total stay those of the hub
+        // (refreshDirtyHubs).  usersDropped counts each refused nick once.
+        std::unordered_map<std::string, int64_t> refusedUsers;
+        int64_t refusedShare = 0;
+        uint64_t usersDropped = 0;
+
+        /// Store ui, or refuse it if the hub holds cap users (0 = no
+        /// cap).  Caller holds mutex.
+        void admitUser(const UserInfo& ui, size_t cap);
+
+        // Guards cachedInfo only, so listHubs / isHubConnected never wait
+        // behind user-list ingestion.
+        mutable std::mutex infoMutex;
         // Cached hub info — updated from socket-thread callbacks where
         // Client* access is safe.  API-thread methods (listHubs,
-        // isHubConnected) read ONLY from this cache under m_mutex,
-        // avoiding data-race reads on Client* GETSET members.
+        // isHubConnected) read ONLY from this cache, avoiding data-race
+        // reads on Client* GETSET members.
         HubInfo cachedInfo;
+        // Set by user-list changes; the Second tick folds the new user
+        // count and share total into cachedInfo, so a login burst costs
+        // one refresh a second instead of one per user.
+        std::atomic<bool> countsDirty{false};
     };
-
-    // State
+    using HubPtr = std::shared_ptr<HubData>;
+
+    // Locking.  Never call into dcpp while holding any of these — hub
+    // socket threads call back into us with dcpp locks held (ABBA).
+    //   m_mutex          lifecycle and callback registration
+    //   m_hubsMutex      m_hubs / m_hubsByClient (shared: lookup,
+    //                    unique: add/remove)
+    //   HubData::mutex / HubData::infoMutex   one hub's data
+    //   m_schedulerMutex m_scheduler (taken before m_searchMutex)
+    //   m_searchMutex    m_searches
+    //   m_fileListMutex  shape of m_fileLists
+    //   m_tthMutex       m_tthIndex
+    //   m_queueMutex     m_queue
+    //   m_settingsMutex  m_settingIndex
+    //   m_initMutex      m_initThread / m_initStep
+    // Order: m_mutex → m_hubsMutex → per-hub; the rest are leaves, except
+    // that queueSearch opens the session under m_schedulerMutex.
+    // m_mutex, m_hubsMutex, HubData::mutex and the search, file-list, TTH
+    // and queue locks are taken through lockCounted() (lockCountedShared()
+    // for lookups), each with its own LockCounters for getMetrics().
+    // Lookups hand out shared_ptrs, so per-hub work and file-list walks
+    // run with the map locks already released.
+
+    // State.  m_initialized is INIT_READY, for the many calls that only
+    // check it; m_coreStarted is whether this bridge owns a running
+    // dcpp core (set from dcpp::startup() until shutdown()).
     std::atomic<bool> m_initialized{false};
+    std::atomic<int> m_initPhase{INIT_NONE};
+    std::atomic<bool> m_coreStarted{false};
+    // Background start (initializeAsync) and startup progress text;
+    // m_initMutex is a leaf lock.  m_initDone is notified, under
+    // m_initMutex, when runStartup() moves the phase off INIT_LOADING.
+    mutable std::mutex m_initMutex;
+    std::condition_variable m_initDone;
+    std::thread m_initThread;
+    std::string m_initStep;
     DCClientCallback* m_callback = nullptr;
-    mutable std::mutex m_mutex;
+    mutable std::mutex m_mutex;     // lock through lockCounted()
+    LockCounters m_mutexCounters{"DCBridge::m_mutex"};
     std::string m_configDir;  // resolved config directory (with trailing slash)
 
-    // Hub tracking (url → data)
-    std::unordered_map<std::string, HubData> m_hubs;
-
-    // File list tracking
-    std::unordered_map<std::string, dcpp::DirectoryListing*> m_fileLists;
+    // Hub tracking (url → data).  Listener callbacks look hubs up by
+    // their Client* instead, which hashes a pointer rather than the URL.
+    mutable std::shared_mutex m_hubsMutex;
+    mutable LockCounters m_hubsMutexCounters{"DCBridge::m_hubsMutex"};
+    // Summed over every hub's HubData::mutex (they come and go)
+    mutable LockCounters m_hubMutexCounters{"HubData::mutex"};
+    std::unordered_map<std::string, HubPtr> m_hubs;
+    std::unordered_map<const dcpp::Client*, HubPtr> m_hubsByClient;
+    // Bumped (under m_hubsMutex) whenever a hub is added or removed, so
+    // lookups memoised outside the lock know when to look again
+    std::atomic<uint64_t> m_hubsGeneration{0};
+    int m_nextHubId = 1;
+
+    // Search results, keyed by search token
+    mutable std::mutex m_searchMutex;
+    mutable LockCounters m_searchMutexCounters{"DCBridge::m_searchMutex"};
+    SearchResultStore m_searches;
+
+    // Setting name → SettingsManager index and type, filled as names are
+    // first used.  m_settingsDirtyAt is the tick of the last unsaved
+    // change (0 = saved).
+    struct SettingRef {
+        int index = 0;
+        int type = 0;
+    };
+    mutable std::mutex m_settingsMutex;
+    std::unordered_map<std::string, SettingRef> m_settingIndex;
+    std::atomic<uint64_t> m_settingsDirtyAt{0};
+
+    // Searches queued behind per-hub intervals (queueSearch)
+    mutable std::mutex m_schedulerMutex;
+    SearchScheduler m_scheduler;
+
+    // File list tracking.  An opened list (listing + path index) is never
+    // modified, so holders of the shared_ptr may walk it concurrently.
+    mutable std::mutex m_fileListMutex;
+    mutable LockCounters m_fileListMutexCounters{"DCBridge::m_fileListMutex"};
+    std::unordered_map<std::string,
+                       std::shared_ptr<const OpenFileList>> m_fileLists;
+
+    // TTH → source lists, over every downloaded list; persisted to
+    // tthIndexPath() across restarts.  m_tthMutex is a leaf lock.
+    mutable std::mutex m_tthMutex;
+    mutable LockCounters m_tthMutexCounters{"DCBridge::m_tthMutex"};
+    TTHIndex m_tthIndex;
+
+    // Mirror of QueueManager's queue, fed by QueueManagerListener events
+    // (which fire under the queue lock, so m_queueMutex nests inside it)
+    mutable std::mutex m_queueMutex;
+    mutable LockCounters m_queueMutexCounters{"DCBridge::m_queueMutex"};
+    QueueStore m_queue;
+
+    // Opt-in on-disk chat log; locks internally (leaf locks)
+    ChatLog m_chatLog;
+
+    // Latest status.  The timer thread (the only writer) fills the next
+    // ring slot and then publishes it; readers load the pointer and copy
+    // the slot.  A slot is rewritten STATUS_RING - 1 ticks (seconds)
+    // after it stopped being current: the grace period a reader that
+    // loaded it has to finish its copy.  Nothing is allocated or freed
+    static constexpr size_t STATUS_RING = 8;
+    std::array<StatusSnapshot, STATUS_RING> m_statusRing;
+    std::atomic<const StatusSnapshot*> m_status{nullptr};
+    uint64_t m_statusSeq = 0;       // timer thread only
+
+    // Background list parsing.  Declared after everything its jobs touch
+    // so it is destroyed (and its workers joined) first.
+    FileListLoader m_fileListLoader;
+    // Helpers for searchFileLists(), kept apart so a query never queues
+    // behind list parses; its workers stay parked between queries
+    FileListLoader m_fileListSearchPool;
+    std::atomic<uint64_t> m_fileListSearchSeq{0};
 
     // Internal helpers
-    HubData* findHub(const std::string& url);
-    dcpp::Client* findClient(const std::string& url);
-
-    // Maximum chat history lines per hub
-    static const size_t MAX_CHAT_LINES = 100;
+    HubPtr findHub(const std::string& url) const;
+    HubPtr findHub(const dcpp::Client* client) const;
+    /// Every hub, copied out so the map lock is not held while using them.
+    std::vector<HubPtr> allHubs() const;
+    dcpp::Client* findClient(const std::string& url) const;
+    std::shared_ptr<const OpenFileList> findFileList(
+        const std::string& fileListId) const;
+
+    /// Resolve, decompress, parse and index a list with no lock held.
+    /// progress (optional) receives 0-99 as the file is read.  Returns
+    /// nullptr and sets error on failure.
+    std::shared_ptr<const OpenFileList> loadFileList(
+        const std::string& fileListId, std::string& error,
+        const std::function<void(int)>& progress = nullptr);
+
+    /// Record a parsed list's TTHs in m_tthIndex (walks the tree unlocked).
+    void indexFileList(const std::string& fileListId, const OpenFileList& fl);
+
+    /// Parse and index a list on the loader pool without opening it —
+    /// used for lists that finish downloading.
+    bool indexFileListAsync(const std::string& fileListId);
+
+    bool resolveSetting(const std::string& name, SettingRef& out);
+    std::string readSetting(const SettingRef& ref);
+    bool writeSetting(const SettingRef& ref, const std::string& value);
+    void markSettingsDirty();
+
+    /// Save settings once they have been left alone for a while
+    /// (Second tick).
+    void saveSettingsIfIdle(uint64_t tick);
+
+    /// Send the queued searches whose hubs are ready (Second tick, and
+    /// right after queueSearch).
+    void pumpSearchQueue();
+
+    /// A hub refused a search as a flood (socket thread).
+    void noteSearchFlood(const std::string& hubUrl);
+
+    /// Urls of the tracked hubs, and of those currently connected.
+    void hubUrls(std::unordered_set<std::string>& known,
+                 std::unordered_set<std::string>& connected) const;
+
+    /// Build a StatusSnapshot and publish it to m_status (Second tick,
+    /// timer thread; no bridge lock held while calling the core).
+    void refreshStatusSnapshot();
+
+    /// Fill m_queue from the core queue once, after the listeners are
+    /// subscribed; events keep it current from then on.
+    void seedQueueMirror();
+
+    std::string tthIndexPath() const { return m_configDir + "TTHIndex.dat"; }
+
+    // Chat lines kept per hub; applied to each HubData when it is created
+    std::atomic<size_t> m_chatCapacity{ChatHistory::DEFAULT_CAPACITY};
+    // Users kept per hub (0 = unlimited)
+    std::atomic<size_t> m_maxHubUsers{0};
 };
 
 } // namespace eiskaltdcpp_py
@@ -6,82 +6,932 @@
 #include "bridge_listeners.h"
 #include "bridge.h"
 
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
 namespace eiskaltdcpp_py {
 
-void BridgeListeners::stashChat(const std::string& hubUrl,
-                                const std::string& nick,
-                                const std::string& text) {
-    if (!m_bridge) return;
+// =========================================================================
+// Event dispatch
+// =========================================================================
 
-    std::lock_guard<std::mutex> lk(m_bridge->m_mutex);
-    auto* hd = m_bridge->findHub(hubUrl);
-    if (!hd) return;
+void BridgeListeners::setDispatchMode(int mode, size_t queueCapacity) {
+    auto lk = lockCounted(m_mutex, m_mutexCounters);
+    if (mode == DISPATCH_QUEUED && !m_ringOwner) {
+        m_ringOwner.reset(new EventRing<BridgeEvent>(
+            queueCapacity > 0 ? queueCapacity : 65536));
+        m_ring.store(m_ringOwner.get(), std::memory_order_release);
+    }
+    m_queued.store(mode == DISPATCH_QUEUED, std::memory_order_release);
+}
+
+std::vector<BridgeEvent> BridgeListeners::pollEvents(int maxEvents) {
+    std::vector<BridgeEvent> result;
+    auto* ring = m_ring.load(std::memory_order_acquire);
+    if (!ring) return result;
+
+    // Clear before draining: a record pushed from here on either gets
+    // popped below or signals afresh
+    clearWakeup();
+
+    size_t limit = maxEvents > 0 ? static_cast<size_t>(maxEvents)
+                                 : ring->capacity();
+    result.reserve(std::min(limit, ring->size()));
+    BridgeEvent ev;
+    while (result.size() < limit && ring->pop(ev)) {
+        result.push_back(std::move(ev));
+    }
+    m_polled.fetch_add(result.size(), std::memory_order_relaxed);
+    if (ring->size() > 0) signalWakeup();
+    return result;
+}
+
+BridgeListeners::~BridgeListeners() {
+    int rfd = m_wakeReadFd.load();
+    int wfd = m_wakeWriteFd.load();
+    if (wfd >= 0 && wfd != rfd) ::close(wfd);
+    if (rfd >= 0) ::close(rfd);
+}
+
+int BridgeListeners::getEventFd() {
+    int fd = m_wakeReadFd.load(std::memory_order_acquire);
+    if (fd >= 0) return fd;
+
+    auto lk = lockCounted(m_mutex, m_mutexCounters);
+    fd = m_wakeReadFd.load(std::memory_order_relaxed);
+    if (fd >= 0) return fd;
+#ifdef __linux__
+    fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) return -1;
+    m_wakeWriteFd.store(fd, std::memory_order_release);
+#else
+    int fds[2];
+    if (::pipe(fds) != 0) return -1;
+    for (int end : fds) {
+        ::fcntl(end, F_SETFL, ::fcntl(end, F_GETFL) | O_NONBLOCK);
+        ::fcntl(end, F_SETFD, FD_CLOEXEC);
+    }
+    fd = fds[0];
+    m_wakeWriteFd.store(fds[1], std::memory_order_release);
+#endif
+    m_wakeReadFd.store(fd, std::memory_order_release);
+
+    // Records queued before anyone was waiting
+    auto* ring = m_ring.load(std::memory_order_acquire);
+    if (ring && ring->size() > 0) signalWakeup();
+    return fd;
+}
+
+void BridgeListeners::signalWakeup() {
+    int fd = m_wakeWriteFd.load(std::memory_order_acquire);
+    if (fd < 0) return;
+    // Pairs with the fence in clearWakeup(): either the consumer sees
+    // our record, or we see the flag it cleared
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_wakePending.exchange(true)) return;
+#ifdef __linux__
+    uint64_t one = 1;
+    ssize_t n = ::write(fd, &one, sizeof(one));
+#else
+    char one = 1;
+    ssize_t n = ::write(fd, &one, 1);
+#endif
+    (void)n;    // EAGAIN only if already readable
+}
+
+void BridgeListeners::clearWakeup() {
+    int fd = m_wakeReadFd.load(std::memory_order_acquire);
+    if (fd < 0) return;
+    // Read first, then clear the flag: a producer that saw it set has
+    // its record in the ring already and no write outstanding
+#ifdef __linux__
+    uint64_t count;
+    ssize_t n = ::read(fd, &count, sizeof(count));
+#else
+    char buf[64];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0) {}
+#endif
+    (void)n;
+    m_wakePending.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+EventQueueStats BridgeListeners::getEventQueueStats() const {
+    EventQueueStats st;
+    auto* ring = m_ring.load(std::memory_order_acquire);
+    if (!ring) return st;
+    st.capacity = ring->capacity();
+    st.depth = ring->size();
+    st.queued = ring->pushed();
+    st.dropped = ring->dropped();
+    st.polled = m_polled.load(std::memory_order_relaxed);
+    return st;
+}
+
+void BridgeListeners::fillMetrics(BridgeMetrics& out) {
+    out.events.reserve(EVENT_TYPE_COUNT);
+    for (int type = 0; type < EVENT_TYPE_COUNT; ++type) {
+        const EventCounters& c = m_eventCounters[type];
+        EventMetrics em;
+        em.type = type;
+        em.raised = c.raised.load(std::memory_order_relaxed);
+        em.skipped = c.skipped.load(std::memory_order_relaxed);
+        em.callbacks = c.callbacks.load(std::memory_order_relaxed);
+        em.callbackLatency = c.latency.snapshot();
+        out.events.push_back(std::move(em));
+    }
+    out.locks.push_back(m_mutexCounters.snapshot());
+    out.ring = getEventQueueStats();
+    {
+        std::lock_guard<std::mutex> lk(m_pendingMutex);
+        for (const auto& [hub, users] : m_pendingUsers) {
+            out.pendingUserEvents += users.size();
+        }
+    }
+    std::lock_guard<std::mutex> lk(m_policyMutex);
+    out.heldCoalescedEvents = m_coalescedEvents.size();
+}
+
+void BridgeListeners::emit(BridgeEvent&& ev) {
+    if (ev.type < 0 || ev.type >= EVENT_TYPE_COUNT) return;
+    EventCounters& counters = m_eventCounters[ev.type];
+    counters.raised.fetch_add(1, std::memory_order_relaxed);
+    if (!((m_eventMask.load(std::memory_order_relaxed) >> ev.type) & 1)) {
+        counters.skipped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    PolicySlot& slot = m_policies[ev.type];
+
+    switch (slot.policy.load(std::memory_order_relaxed)) {
+    case POLICY_DROP:
+        slot.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    case POLICY_COALESCE: {
+        std::string key = std::to_string(ev.type) + '\0' + ev.hubUrl +
+                          '\0' + ev.nick;
+        std::lock_guard<std::mutex> lk(m_policyMutex);
+        auto [it, inserted] = m_coalescedEvents.try_emplace(std::move(key));
+        if (!inserted) slot.coalesced.fetch_add(1, std::memory_order_relaxed);
+        it->second = std::move(ev);
+        return;
+    }
+    case POLICY_RATE_LIMIT:
+        if (!takeRateToken(ev, slot.rate.load(std::memory_order_relaxed))) {
+            slot.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    slot.delivered.fetch_add(1, std::memory_order_relaxed);
+    dispatch(std::move(ev));
+}
+
+void BridgeListeners::dispatch(BridgeEvent&& ev) {
+    ev.seq = m_eventSeq.fetch_add(1, std::memory_order_relaxed);
+
+    if (m_queued.load(std::memory_order_acquire)) {
+        // Never touches the GIL — a full ring just counts a drop.
+        if (m_ring.load(std::memory_order_acquire)->push(std::move(ev))) {
+            signalWakeup();
+        }
+        return;
+    }
+
+    auto cb = getCallback();
+    if (cb) {
+        auto timer = timeCallback(ev.type);
+        deliver(cb, ev);
+    }
+}
+
+// =========================================================================
+// Dispatch policies
+// =========================================================================
+
+bool BridgeListeners::setEventPolicy(int eventType, int policy,
+                                     int ratePerSecond) {
+    if (eventType < 0 || eventType >= EVENT_TYPE_COUNT) return false;
+    if (policy < POLICY_DELIVER || policy > POLICY_RATE_LIMIT) return false;
+    if (policy == POLICY_RATE_LIMIT && ratePerSecond <= 0) return false;
+    // Always delivered (coreReady())
+    if (eventType == EVENT_CORE_READY && policy != POLICY_DELIVER) {
+        return false;
+    }
+
+    PolicySlot& slot = m_policies[eventType];
+    slot.rate.store(ratePerSecond, std::memory_order_relaxed);
+    slot.policy.store(policy, std::memory_order_relaxed);
+    {
+        // New rate: start every hub with a full bucket again
+        std::lock_guard<std::mutex> lk(m_policyMutex);
+        m_rateBuckets.clear();
+    }
+    return true;
+}
+
+int BridgeListeners::getEventPolicy(int eventType) const {
+    if (eventType < 0 || eventType >= EVENT_TYPE_COUNT) return POLICY_DELIVER;
+    return m_policies[eventType].policy.load(std::memory_order_relaxed);
+}
+
+std::vector<EventPolicyStats> BridgeListeners::getEventPolicyStats() const {
+    std::vector<EventPolicyStats> result(EVENT_TYPE_COUNT);
+    for (int t = 0; t < EVENT_TYPE_COUNT; ++t) {
+        const PolicySlot& slot = m_policies[t];
+        EventPolicyStats& st = result[t];
+        st.type = t;
+        st.policy = slot.policy.load(std::memory_order_relaxed);
+        st.ratePerSecond = slot.rate.load(std::memory_order_relaxed);
+        st.delivered = slot.delivered.load(std::memory_order_relaxed);
+        st.dropped = slot.dropped.load(std::memory_order_relaxed);
+        st.coalesced = slot.coalesced.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void BridgeListeners::resetEventPolicies() {
+    for (auto& slot : m_policies) {
+        slot.policy.store(POLICY_DELIVER, std::memory_order_relaxed);
+        slot.rate.store(0, std::memory_order_relaxed);
+    }
+    flushCoalescedEvents();
+    {
+        std::lock_guard<std::mutex> lk(m_policyMutex);
+        m_rateBuckets.clear();
+    }
+    for (auto& slot : m_policies) {
+        slot.delivered.store(0, std::memory_order_relaxed);
+        slot.dropped.store(0, std::memory_order_relaxed);
+        slot.coalesced.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool BridgeListeners::policyNeedsPerItem(int type) const {
+    int policy = m_policies[type].policy.load(std::memory_order_relaxed);
+    return policy == POLICY_COALESCE || policy == POLICY_RATE_LIMIT;
+}
+
+bool BridgeListeners::policyAllowsBatch(int type, size_t items) {
+    m_eventCounters[type].raised.fetch_add(items, std::memory_order_relaxed);
+    PolicySlot& slot = m_policies[type];
+    if (slot.policy.load(std::memory_order_relaxed) == POLICY_DROP) {
+        slot.dropped.fetch_add(items, std::memory_order_relaxed);
+        return false;
+    }
+    slot.delivered.fetch_add(items, std::memory_order_relaxed);
+    return true;
+}
+
+bool BridgeListeners::takeRateToken(const BridgeEvent& ev, int ratePerSecond) {
+    if (ratePerSecond <= 0) return true;
+    uint64_t now = dcpp::TimerManager::getTick();
+    std::string key = std::to_string(ev.type) + '\0' + ev.hubUrl;
 
-    std::string formatted;
-    if (!nick.empty()) {
-        formatted = "<" + nick + "> " + text;
+    // Token bucket: refills at ratePerSecond, holds at most one second's
+    // worth, so a quiet hub may burst up to the rate and no further
+    std::lock_guard<std::mutex> lk(m_policyMutex);
+    auto [it, inserted] = m_rateBuckets.try_emplace(std::move(key));
+    RateBucket& b = it->second;
+    if (inserted) {
+        b.tokens = ratePerSecond;
     } else {
-        formatted = text;
+        b.tokens = std::min<double>(ratePerSecond,
+            b.tokens + (now - b.lastTick) * ratePerSecond / 1000.0);
+    }
+    b.lastTick = now;
+    if (b.tokens < 1.0) return false;
+    b.tokens -= 1.0;
+    return true;
+}
+
+void BridgeListeners::flushCoalescedEvents() {
+    decltype(m_coalescedEvents) held;
+    {
+        std::lock_guard<std::mutex> lk(m_policyMutex);
+        if (m_coalescedEvents.empty()) return;
+        held.swap(m_coalescedEvents);
+    }
+    for (auto& [key, ev] : held) {
+        m_policies[ev.type].delivered.fetch_add(1, std::memory_order_relaxed);
+        dispatch(std::move(ev));
+    }
+}
+
+void BridgeListeners::deliver(DCClientCallback* cb, const BridgeEvent& ev) {
+    switch (ev.type) {
+    case EVENT_HUB_CONNECTING:
+        cb->onHubConnecting(ev.hubUrl);
+        break;
+    case EVENT_HUB_CONNECTED:
+        cb->onHubConnected(ev.hubUrl, ev.text);
+        break;
+    case EVENT_HUB_DISCONNECTED:
+        cb->onHubDisconnected(ev.hubUrl, ev.text);
+        break;
+    case EVENT_HUB_REDIRECT:
+        cb->onHubRedirect(ev.hubUrl, ev.text);
+        break;
+    case EVENT_HUB_PASSWORD_REQUEST:
+        cb->onHubPasswordRequest(ev.hubUrl);
+        break;
+    case EVENT_HUB_UPDATED:
+        cb->onHubUpdated(ev.hubUrl, ev.text);
+        break;
+    case EVENT_NICK_TAKEN:
+        cb->onNickTaken(ev.hubUrl);
+        break;
+    case EVENT_HUB_FULL:
+        cb->onHubFull(ev.hubUrl);
+        break;
+    case EVENT_CHAT_MESSAGE:
+        cb->onChatMessage(ev.hubUrl, ev.nick, ev.text, ev.flag);
+        break;
+    case EVENT_PRIVATE_MESSAGE:
+        cb->onPrivateMessage(ev.hubUrl, ev.nick, ev.extra, ev.text);
+        break;
+    case EVENT_STATUS_MESSAGE:
+        cb->onStatusMessage(ev.hubUrl, ev.text);
+        break;
+    case EVENT_USER_CONNECTED:
+        cb->onUserConnected(ev.hubUrl, ev.nick);
+        break;
+    case EVENT_USER_DISCONNECTED:
+        cb->onUserDisconnected(ev.hubUrl, ev.nick);
+        break;
+    case EVENT_USER_UPDATED:
+        cb->onUserUpdated(ev.hubUrl, ev.nick);
+        break;
+    case EVENT_SEARCH_RESULT:
+        cb->onSearchResult(ev.hubUrl, ev.text, ev.size, ev.freeSlots,
+                           ev.totalSlots, ev.extra, ev.nick, ev.flag);
+        break;
+    case EVENT_DOWNLOAD_STARTING:
+        cb->onDownloadStarting(ev.text, ev.nick, ev.size);
+        break;
+    case EVENT_DOWNLOAD_COMPLETE:
+        cb->onDownloadComplete(ev.text, ev.nick, ev.size, ev.value);
+        break;
+    case EVENT_DOWNLOAD_FAILED:
+        cb->onDownloadFailed(ev.text, ev.extra);
+        break;
+    case EVENT_UPLOAD_STARTING:
+        cb->onUploadStarting(ev.text, ev.nick, ev.size);
+        break;
+    case EVENT_UPLOAD_COMPLETE:
+        cb->onUploadComplete(ev.text, ev.nick, ev.size);
+        break;
+    case EVENT_QUEUE_ITEM_ADDED:
+        cb->onQueueItemAdded(ev.text, ev.size, ev.extra);
+        break;
+    case EVENT_QUEUE_ITEM_FINISHED:
+        cb->onQueueItemFinished(ev.text, ev.size);
+        break;
+    case EVENT_QUEUE_ITEM_REMOVED:
+        cb->onQueueItemRemoved(ev.text);
+        break;
+    case EVENT_HASH_PROGRESS:
+        cb->onHashProgress(ev.text, static_cast<uint64_t>(ev.size),
+                           static_cast<size_t>(ev.value));
+        break;
+    case EVENT_FILE_LIST_PROGRESS:
+        cb->onFileListProgress(ev.text, static_cast<int>(ev.value));
+        break;
+    case EVENT_FILE_LIST_LOADED:
+        cb->onFileListLoaded(ev.text, ev.flag, ev.extra);
+        break;
+    case EVENT_TRANSFER_PROGRESS: {
+        TransferInfo ti;
+        ti.filename = ev.text;
+        ti.nick = ev.nick;
+        ti.hubUrl = ev.hubUrl;
+        ti.size = ev.size;
+        ti.pos = ev.pos;
+        ti.speed = ev.value;
+        ti.isDownload = ev.flag;
+        cb->onTransferProgress({ti});
+        break;
+    }
+    case EVENT_CORE_READY:
+        cb->onCoreReady(ev.flag, ev.text);
+        break;
+    default:
+        break;
+    }
+}
+
+void BridgeListeners::emitUsersUpdated(const std::string& hubUrl,
+                                       std::vector<UserInfo>&& users) {
+    if (users.empty() || !wants(EVENT_USER_UPDATED, users.size())) return;
+
+    if (m_queued.load(std::memory_order_acquire) ||
+            policyNeedsPerItem(EVENT_USER_UPDATED)) {
+        for (auto& u : users) {
+            emitNick(EVENT_USER_UPDATED, hubUrl, u.nick);
+        }
+        return;
     }
 
-    hd->chatHistory.push_back(formatted);
+    auto cb = getCallback();
+    if (cb && policyAllowsBatch(EVENT_USER_UPDATED, users.size())) {
+        auto timer = timeCallback(EVENT_USER_UPDATED);
+        cb->onUsersUpdatedBatch(hubUrl, users);
+    }
+}
+
+void BridgeListeners::emitUsersConnected(const std::string& hubUrl,
+                                         std::vector<UserInfo>&& users) {
+    if (users.empty() || !wants(EVENT_USER_CONNECTED, users.size())) {
+        return;
+    }
+
+    if (m_queued.load(std::memory_order_acquire) ||
+            policyNeedsPerItem(EVENT_USER_CONNECTED)) {
+        for (auto& u : users) {
+            emitNick(EVENT_USER_CONNECTED, hubUrl, u.nick);
+        }
+        return;
+    }
+
+    auto cb = getCallback();
+    if (cb && policyAllowsBatch(EVENT_USER_CONNECTED, users.size())) {
+        auto timer = timeCallback(EVENT_USER_CONNECTED);
+        cb->onUsersConnectedBatch(hubUrl, users);
+    }
+}
+
+void BridgeListeners::emitUsersRemoved(const std::string& hubUrl,
+                                       std::vector<std::string>&& nicks) {
+    if (nicks.empty() || !wants(EVENT_USER_DISCONNECTED, nicks.size())) {
+        return;
+    }
+
+    if (m_queued.load(std::memory_order_acquire) ||
+            policyNeedsPerItem(EVENT_USER_DISCONNECTED)) {
+        for (auto& n : nicks) {
+            emitNick(EVENT_USER_DISCONNECTED, hubUrl, n);
+        }
+        return;
+    }
 
-    // Limit history size
-    static const size_t MAX_HISTORY = 500;
-    while (hd->chatHistory.size() > MAX_HISTORY) {
-        hd->chatHistory.pop_front();
+    auto cb = getCallback();
+    if (cb && policyAllowsBatch(EVENT_USER_DISCONNECTED, nicks.size())) {
+        auto timer = timeCallback(EVENT_USER_DISCONNECTED);
+        cb->onUsersRemovedBatch(hubUrl, nicks);
     }
 }
 
-void BridgeListeners::stashSearchResult(const SearchResultInfo& info) {
+// =========================================================================
+// Active transfers
+// =========================================================================
+
+void BridgeListeners::trackTransfer(const dcpp::Transfer* t,
+                                    const TransferInfo& ti) {
+    std::lock_guard<std::mutex> lk(m_transfersMutex);
+    m_transfers[t] = ti;
+}
+
+void BridgeListeners::untrackTransfer(const dcpp::Transfer* t) {
+    std::lock_guard<std::mutex> lk(m_transfersMutex);
+    m_transfers.erase(t);
+}
+
+template <typename T>
+static void refreshTransfers(
+        std::unordered_map<const dcpp::Transfer*, TransferInfo>& transfers,
+        const std::vector<T*>& list, bool isDownload) {
+    // A Tick lists every running transfer of one direction, so anything
+    // of that direction not in it has ended without us hearing about it
+    for (auto it = transfers.begin(); it != transfers.end();) {
+        if (it->second.isDownload == isDownload &&
+                std::find(list.begin(), list.end(), it->first) == list.end()) {
+            it = transfers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (const T* t : list) {
+        auto it = transfers.find(t);
+        if (it == transfers.end()) continue;    // Starting not seen (yet)
+        it->second.size = t->getSize();
+        it->second.pos = t->getPos();
+        it->second.speed = static_cast<int64_t>(t->getAverageSpeed());
+    }
+}
+
+void BridgeListeners::tickTransfers(const dcpp::DownloadList& list) {
+    std::lock_guard<std::mutex> lk(m_transfersMutex);
+    refreshTransfers(m_transfers, list, true);
+}
+
+void BridgeListeners::tickTransfers(const dcpp::UploadList& list) {
+    std::lock_guard<std::mutex> lk(m_transfersMutex);
+    refreshTransfers(m_transfers, list, false);
+}
+
+std::vector<TransferInfo> BridgeListeners::getActiveTransfers() {
+    std::vector<TransferInfo> result;
+    std::lock_guard<std::mutex> lk(m_transfersMutex);
+    result.reserve(m_transfers.size());
+    for (const auto& [t, ti] : m_transfers) result.push_back(ti);
+    return result;
+}
+
+void BridgeListeners::clearActiveTransfers() {
+    std::lock_guard<std::mutex> lk(m_transfersMutex);
+    m_transfers.clear();
+}
+
+void BridgeListeners::emitTransferProgress(uint64_t tick) {
+    int interval = m_progressIntervalMs.load(std::memory_order_relaxed);
+    if (interval <= 0 ||
+            tick - m_lastProgressTick < static_cast<uint64_t>(interval)) {
+        return;
+    }
+    m_lastProgressTick = tick;
+    if (!wants(EVENT_TRANSFER_PROGRESS)) return;
+
+    std::vector<TransferInfo> transfers = getActiveTransfers();
+    if (transfers.empty()) return;
+
+    if (m_queued.load(std::memory_order_acquire) ||
+            policyNeedsPerItem(EVENT_TRANSFER_PROGRESS)) {
+        for (auto& ti : transfers) {
+            BridgeEvent ev;
+            ev.type = EVENT_TRANSFER_PROGRESS;
+            ev.text = std::move(ti.filename);
+            ev.nick = std::move(ti.nick);
+            ev.hubUrl = std::move(ti.hubUrl);
+            ev.size = ti.size;
+            ev.pos = ti.pos;
+            ev.value = ti.speed;
+            ev.flag = ti.isDownload;
+            emit(std::move(ev));
+        }
+        return;
+    }
+
+    auto cb = getCallback();
+    if (cb && policyAllowsBatch(EVENT_TRANSFER_PROGRESS, transfers.size())) {
+        auto timer = timeCallback(EVENT_TRANSFER_PROGRESS);
+        cb->onTransferProgress(transfers);
+    }
+}
+
+void BridgeListeners::emitHashProgress(uint64_t tick) {
+    int interval = m_hashIntervalMs.load(std::memory_order_relaxed);
+    if (interval <= 0 ||
+            tick - m_lastHashTick < static_cast<uint64_t>(interval)) {
+        return;
+    }
+    m_lastHashTick = tick;
+    if (!wants(EVENT_HASH_PROGRESS)) return;
+
+    // No bridge lock is held here; getStats() only takes the hasher's
+    std::string file;
+    uint64_t bytesLeft = 0;
+    size_t filesLeft = 0;
+    dcpp::HashManager::getInstance()->getStats(file, bytesLeft, filesLeft);
+
+    // Idle ticks report nothing, except the first one after work ran out
+    bool active = filesLeft > 0 || bytesLeft > 0;
+    if (!active && !m_hashActive) return;
+    m_hashActive = active;
+
+    BridgeEvent ev;
+    ev.type = EVENT_HASH_PROGRESS;
+    ev.text = std::move(file);
+    ev.size = static_cast<int64_t>(bytesLeft);
+    ev.value = static_cast<int64_t>(filesLeft);
+    emit(std::move(ev));
+}
+
+// =========================================================================
+// Queue event batches
+// =========================================================================
+
+BridgeListeners::QueueEventBatch*& BridgeListeners::currentQueueBatch() {
+    static thread_local QueueEventBatch* current = nullptr;
+    return current;
+}
+
+BridgeListeners::QueueEventBatch::QueueEventBatch()
+    : m_outer(currentQueueBatch()) {
+    if (m_outer) {
+        m_addedBase = m_outer->m_added.size();
+        m_removedBase = m_outer->m_removed.size();
+    } else {
+        currentQueueBatch() = this;
+    }
+}
+
+BridgeListeners::QueueEventBatch::~QueueEventBatch() {
+    if (m_outer) {
+        // Nested: the outermost batch already collected everything
+        return;
+    }
+    currentQueueBatch() = nullptr;
+    BridgeListeners::getInstance().emitQueueBatch(std::move(m_added),
+                                                  std::move(m_removed));
+}
+
+void BridgeListeners::emitQueueBatch(std::vector<QueueItemInfo>&& added,
+                                     std::vector<std::string>&& removed) {
+    if (removed.empty() && added.empty()) return;
+    if (!removed.empty() && !wants(EVENT_QUEUE_ITEM_REMOVED, removed.size())) {
+        removed.clear();
+    }
+    if (!added.empty() && !wants(EVENT_QUEUE_ITEM_ADDED, added.size())) {
+        added.clear();
+    }
+    if (removed.empty() && added.empty()) return;
+
+    bool queued = m_queued.load(std::memory_order_acquire);
+    if (queued || policyNeedsPerItem(EVENT_QUEUE_ITEM_REMOVED)) {
+        for (auto& t : removed) {
+            emit(EVENT_QUEUE_ITEM_REMOVED, "", t);
+        }
+        removed.clear();
+    }
+    if (queued || policyNeedsPerItem(EVENT_QUEUE_ITEM_ADDED)) {
+        for (auto& q : added) {
+            emitQueueAdded(q);
+        }
+        added.clear();
+    }
+
+    auto cb = getCallback();
+    if (!cb) return;
+    if (!removed.empty() &&
+            policyAllowsBatch(EVENT_QUEUE_ITEM_REMOVED, removed.size())) {
+        auto timer = timeCallback(EVENT_QUEUE_ITEM_REMOVED);
+        cb->onQueueItemsRemovedBatch(removed);
+    }
+    if (!added.empty() &&
+            policyAllowsBatch(EVENT_QUEUE_ITEM_ADDED, added.size())) {
+        auto timer = timeCallback(EVENT_QUEUE_ITEM_ADDED);
+        cb->onQueueItemsAddedBatch(added);
+    }
+}
+
+// =========================================================================
+// User event coalescing
+// =========================================================================
+
+void BridgeListeners::setUserEventCoalescing(bool enable) {
+    m_coalesceUsers.store(enable, std::memory_order_relaxed);
+    if (!enable) flushUserEvents();
+}
+
+void BridgeListeners::queueUserEvent(const std::string& hubUrl, bool removed,
+                                     UserInfo&& info, bool joined) {
+    std::lock_guard<std::mutex> lk(m_pendingMutex);
+    auto& byNick = m_pendingUsers[hubUrl];
+    auto it = byNick.find(info.nick);
+    if (it == byNick.end()) {
+        auto& slot = byNick[info.nick];
+        slot.removed = removed;
+        slot.joinedThisTick = joined && !removed;
+        slot.info = std::move(info);
+        return;
+    }
+    if (removed && it->second.joinedThisTick) {
+        // Joined and left within the tick: nobody heard of it, so a
+        // users_removed for it would be noise
+        byNick.erase(it);
+        if (byNick.empty()) m_pendingUsers.erase(hubUrl);
+        return;
+    }
+    it->second.removed = removed;
+    it->second.info = std::move(info);
+}
+
+void BridgeListeners::flushUserEvents() {
+    decltype(m_pendingUsers) pending;
+    {
+        std::lock_guard<std::mutex> lk(m_pendingMutex);
+        if (m_pendingUsers.empty()) return;
+        pending.swap(m_pendingUsers);
+    }
+
+    for (auto& [hubUrl, byNick] : pending) {
+        std::vector<UserInfo> connected;
+        std::vector<std::string> removed;
+        for (auto& [nick, ev] : byNick) {
+            if (ev.removed) {
+                removed.push_back(std::move(ev.info.nick));
+            } else {
+                connected.push_back(std::move(ev.info));
+            }
+        }
+        // Parts first: a nick that left and rejoined within the tick is
+        // recorded as connected, so the final state is always correct.
+        // Joins keep their own callback (and mask bit), as uncoalesced.
+        emitUsersRemoved(hubUrl, std::move(removed));
+        emitUsersConnected(hubUrl, std::move(connected));
+    }
+}
+
+// =========================================================================
+// Hub data stashing
+// =========================================================================
+
+void BridgeListeners::stashChat(dcpp::Client* c,
+                                const std::string& nick,
+                                const std::string& text,
+                                int64_t timestamp, bool thirdPerson,
+                                bool isPrivate) {
     if (!m_bridge) return;
+    auto hd = m_bridge->findHub(c);
+    if (!hd) return;
+    auto lk = lockCounted(hd->mutex, m_bridge->m_hubMutexCounters);
+    hd->chatHistory.push(nick, text, timestamp, thirdPerson, isPrivate);
+}
 
-    std::lock_guard<std::mutex> lk(m_bridge->m_mutex);
+void BridgeListeners::logChat(int kind, const std::string& hubUrl,
+                              const std::string& nick, const std::string& to,
+                              const std::string& text, bool thirdPerson) {
+    if (!m_bridge || !m_bridge->m_chatLog.isOpen()) return;
+    m_bridge->m_chatLog.append(kind, hubUrl, nick, to, text,
+                               static_cast<int64_t>(std::time(nullptr)),
+                               thirdPerson);
+}
 
-    // Store in the matching hub, or the first hub if no match
-    auto* hd = m_bridge->findHub(info.hubUrl);
-    if (hd) {
-        hd->searchResults.push_back(info);
-    } else if (!m_bridge->m_hubs.empty()) {
-        m_bridge->m_hubs.begin()->second.searchResults.push_back(info);
+void BridgeListeners::flushChatLog(uint64_t tick) {
+    if (m_bridge) m_bridge->m_chatLog.flush(tick);
+}
+
+DCBridge::HubPtr BridgeListeners::hubForSearchResult(
+        const std::string& hubUrl) {
+    // A SearchResult carries its hub's URL but no Client*, so the
+    // Client*-keyed index cannot be used.  Remember the last hub each
+    // (UDP or hub socket) thread resolved instead, until the URL changes
+    // or a hub is added or removed.
+    struct Memo {
+        const DCBridge* bridge = nullptr;
+        uint64_t generation = 0;
+        std::string url;
+        std::weak_ptr<DCBridge::HubData> hub;
+    };
+    static thread_local Memo memo;
+
+    uint64_t gen = m_bridge->m_hubsGeneration.load(std::memory_order_acquire);
+    if (memo.bridge == m_bridge && memo.generation == gen &&
+            memo.url == hubUrl) {
+        if (auto hd = memo.hub.lock()) return hd;
+    }
+    auto hd = m_bridge->findHub(hubUrl);
+    memo.bridge = m_bridge;
+    memo.generation = gen;
+    memo.url = hubUrl;
+    memo.hub = hd;
+    return hd;
+}
+
+std::string BridgeListeners::nickForSearchResult(
+        const dcpp::SearchResultPtr& sr) {
+    const dcpp::CID& cid = sr->getUser()->getCID();
+    if (m_bridge) {
+        if (auto hd = hubForSearchResult(sr->getHubURL())) {
+            UserStore::RawCID raw;
+            memcpy(raw.data(), cid.data(), raw.size());
+            auto lk = lockCounted(hd->mutex, m_bridge->m_hubMutexCounters);
+            if (const std::string* nick = hd->users.nickForCID(raw)) {
+                return *nick;
+            }
+        }
     }
+    auto nicks = dcpp::ClientManager::getInstance()->getNicks(
+        cid, sr->getHubURL());
+    return nicks.empty() ? "" : nicks[0];
 }
 
-void BridgeListeners::stashUserUpdate(const std::string& hubUrl,
-                                       const dcpp::OnlineUser& ou) {
+bool BridgeListeners::stashSearchResult(const dcpp::SearchResultPtr& sr,
+                                        const SearchResultInfo& info) {
+    if (!m_bridge) return false;
+
+    // Same file from the same user — directories have no TTH, so their
+    // path stands in for it.  Raw bytes: nothing here is shown to anyone.
+    std::string key;
+    if (info.isDirectory) {
+        key = 'd' + sr->getFile();
+    } else {
+        key = 'f';
+        key.append(reinterpret_cast<const char*>(info.rawTTH.data()),
+                   info.rawTTH.size());
+    }
+    key += '|';
+    key.append(reinterpret_cast<const char*>(sr->getUser()->getCID().data()),
+               dcpp::CID::SIZE);
+
+    SearchResultInfo copy(info);
+    auto lk = lockCounted(m_bridge->m_searchMutex,
+                          m_bridge->m_searchMutexCounters);
+    return m_bridge->m_searches.add(sr->getToken(), std::move(copy), key,
+                                    dcpp::TimerManager::getTick());
+}
+
+void BridgeListeners::expireSearches(uint64_t tick) {
+    if (!m_bridge) return;
+    auto lk = lockCounted(m_bridge->m_searchMutex,
+                          m_bridge->m_searchMutexCounters);
+    m_bridge->m_searches.expire(tick);
+}
+
+void BridgeListeners::stashQueueItem(QueueItemInfo&& info) {
+    if (!m_bridge) return;
+    auto lk = lockCounted(m_bridge->m_queueMutex,
+                          m_bridge->m_queueMutexCounters);
+    m_bridge->m_queue.upsert(std::move(info));
+}
+
+void BridgeListeners::stashQueueRemove(const std::string& target) {
     if (!m_bridge) return;
-    std::lock_guard<std::mutex> lk(m_bridge->m_mutex);
-    auto* hd = m_bridge->findHub(hubUrl);
+    auto lk = lockCounted(m_bridge->m_queueMutex,
+                          m_bridge->m_queueMutexCounters);
+    m_bridge->m_queue.erase(target);
+}
+
+void BridgeListeners::indexFinishedList(dcpp::QueueItem* qi) {
+    if (!m_bridge) return;
+    // Parsing happens on the loader pool; here we only hand over the name
+    std::string listName = qi->getListName();
+    size_t slash = listName.find_last_of(PATH_SEPARATOR);
+    m_bridge->indexFileListAsync(slash == std::string::npos
+        ? listName : listName.substr(slash + 1));
+}
+
+bool BridgeListeners::stashUserUpdate(dcpp::Client* c, const UserInfo& ui) {
+    if (!m_bridge) return false;
+    auto hd = m_bridge->findHub(c);
+    if (!hd) return false;
+    size_t cap = m_bridge->m_maxHubUsers.load(std::memory_order_relaxed);
+    auto lk = lockCounted(hd->mutex, m_bridge->m_hubMutexCounters);
+    // Refused users were announced too, as uncoalesced joins are
+    bool joined = !hd->users.contains(ui.nick) &&
+                  hd->refusedUsers.find(ui.nick) == hd->refusedUsers.end();
+    hd->admitUser(ui, cap);
+    hd->countsDirty.store(true, std::memory_order_relaxed);
+    return joined;
+}
+
+void BridgeListeners::stashUserUpdates(dcpp::Client* c,
+                                       const std::vector<UserInfo>& users) {
+    if (!m_bridge || users.empty()) return;
+    auto hd = m_bridge->findHub(c);
     if (!hd) return;
-    hd->users[ou.getIdentity().getNick()] = userFromOnlineUser(ou);
+    size_t cap = m_bridge->m_maxHubUsers.load(std::memory_order_relaxed);
+    auto lk = lockCounted(hd->mutex, m_bridge->m_hubMutexCounters);
+    size_t want = hd->users.size() + users.size();
+    hd->users.reserve(cap ? std::min(want, cap) : want);
+    for (const auto& ui : users) hd->admitUser(ui, cap);
+    hd->countsDirty.store(true, std::memory_order_relaxed);
 }
 
-void BridgeListeners::stashUserRemove(const std::string& hubUrl,
-                                       const std::string& nick) {
+void BridgeListeners::stashUserRemove(dcpp::Client* c,
+                                      const std::string& nick) {
     if (!m_bridge) return;
-    std::lock_guard<std::mutex> lk(m_bridge->m_mutex);
-    auto* hd = m_bridge->findHub(hubUrl);
+    auto hd = m_bridge->findHub(c);
     if (!hd) return;
-    hd->users.erase(nick);
+    auto lk = lockCounted(hd->mutex, m_bridge->m_hubMutexCounters);
+    if (!hd->users.erase(nick)) {
+        auto refused = hd->refusedUsers.find(nick);
+        if (refused != hd->refusedUsers.end()) {
+            hd->refusedShare -= refused->second;
+            hd->refusedUsers.erase(refused);
+        }
+    }
+    hd->countsDirty.store(true, std::memory_order_relaxed);
 }
 
-void BridgeListeners::clearHubUsers(const std::string& hubUrl) {
+void BridgeListeners::clearHubUsers(dcpp::Client* c) {
     if (!m_bridge) return;
-    std::lock_guard<std::mutex> lk(m_bridge->m_mutex);
-    auto* hd = m_bridge->findHub(hubUrl);
+    auto hd = m_bridge->findHub(c);
     if (!hd) return;
+    auto lk = lockCounted(hd->mutex, m_bridge->m_hubMutexCounters);
     hd->users.clear();
+    hd->refusedUsers.clear();
+    hd->refusedShare = 0;
+    hd->countsDirty.store(true, std::memory_order_relaxed);
 }
 
-void BridgeListeners::refreshHubCache(const std::string& hubUrl,
-                                       dcpp::Client* c) {
+void BridgeListeners::refreshHubCache(dcpp::Client* c) {
     if (!m_bridge || !c) return;
+    auto hd = m_bridge->findHub(c);
+    if (!hd) return;
 
     // Read all Client* accessors HERE on the socket thread where it's safe.
     // Some of these (getUserCount) acquire NmdcHub::cs, which is recursive,
     // so re-acquiring it from a callback already under cs is fine.
     HubInfo info;
-    info.url        = hubUrl;
+    info.url        = c->getHubUrl();
     info.name       = c->getHubName();
     info.description = c->getHubDescription();
     info.userCount  = static_cast<int>(c->getUserCount());
@@ -91,19 +941,64 @@ void BridgeListeners::refreshHubCache(const std::string& hubUrl,
     info.isSecure   = c->isSecure();
     info.isTrusted  = c->isTrusted();
     info.cipherName = c->getCipherName();
+    info.hubId      = hd->id;
 
-    // Now store the snapshot under m_mutex.
-    std::lock_guard<std::mutex> lk(m_bridge->m_mutex);
-    auto* hd = m_bridge->findHub(hubUrl);
-    if (!hd) return;
+    // Now store the snapshot under the hub's info lock.
+    std::lock_guard<std::mutex> lk(hd->infoMutex);
     hd->cachedInfo = std::move(info);
 }
 
-void BridgeListeners::markHubDisconnected(const std::string& hubUrl) {
+void BridgeListeners::refreshDirtyHubs() {
+    if (!m_bridge) return;
+
+    std::vector<DCBridge::HubPtr> dirty;
+    {
+        auto lock = lockCountedShared(m_bridge->m_hubsMutex,
+                                      m_bridge->m_hubsMutexCounters);
+        for (const auto& [url, hd] : m_bridge->m_hubs) {
+            if (hd->countsDirty.exchange(false, std::memory_order_relaxed)) {
+                dirty.push_back(hd);
+            }
+        }
+    }
+
+    for (const auto& hd : dirty) {
+        int userCount;
+        int64_t sharedBytes;
+        {
+            // Refused users count too: these are the hub's totals
+            auto lk = lockCounted(hd->mutex, m_bridge->m_hubMutexCounters);
+            userCount = static_cast<int>(hd->users.size() +
+                                         hd->refusedUsers.size());
+            sharedBytes = hd->users.totalShare() + hd->refusedShare;
+        }
+        std::lock_guard<std::mutex> lk(hd->infoMutex);
+        hd->cachedInfo.userCount = userCount;
+        hd->cachedInfo.sharedBytes = sharedBytes;
+    }
+}
+
+void BridgeListeners::saveSettings(uint64_t tick) {
+    if (m_bridge) m_bridge->saveSettingsIfIdle(tick);
+}
+
+void BridgeListeners::pumpSearches() {
+    if (m_bridge) m_bridge->pumpSearchQueue();
+}
+
+void BridgeListeners::noteSearchFlood(const std::string& hubUrl) {
+    if (m_bridge) m_bridge->noteSearchFlood(hubUrl);
+}
+
+void BridgeListeners::refreshStatus() {
+    if (m_bridge) m_bridge->refreshStatusSnapshot();
+}
+
+void BridgeListeners::markHubDisconnected(dcpp::Client* c) {
     if (!m_bridge) return;
-    std::lock_guard<std::mutex> lk(m_bridge->m_mutex);
-    auto* hd = m_bridge->findHub(hubUrl);
+    auto hd = m_bridge->findHub(c);
     if (!hd) return;
+    std::lock_guard<std::mutex> lk(hd->infoMutex);
     hd->cachedInfo.connected = false;
 }
 
@@ -13,7 +13,10 @@
 
 #pragma once
 
+#include "base32.h"
 #include "callbacks.h"
+#include "event_ring.h"
+#include "metrics.h"
 #include "types.h"
 #include "dcpp_compat.h"  // must precede dcpp headers
 
@@ -40,9 +43,15 @@
 #include <dcpp/UploadManagerListener.h>
 #include <dcpp/Util.h>
 
+#include <atomic>
+#include <cstring>
+#include <ctime>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 // Forward declare
 namespace eiskaltdcpp_py {
@@ -69,24 +78,38 @@ inline UserInfo userFromOnlineUser(const dcpp::OnlineUser& ou) {
     return ui;
 }
 
+/// Everything but the nick (BridgeListeners::nickForSearchResult).  The
+/// TTH is kept raw; see fillTTH().
 inline SearchResultInfo infoFromSearchResult(const dcpp::SearchResultPtr& sr) {
     SearchResultInfo sri;
     sri.file = sr->getBaseName();
+    sri.path = sr->getFile();
     sri.size = sr->getSize();
     sri.freeSlots = sr->getFreeSlots();
     sri.totalSlots = sr->getSlots();
-    sri.tth = sr->getTTH().toBase32();
+    memcpy(sri.rawTTH.data(), sr->getTTH().data, sri.rawTTH.size());
+    sri.hasRawTTH = true;
     sri.hubUrl = sr->getHubURL();
     sri.hubName = sr->getHubName();
-    {
-        auto nicks = dcpp::ClientManager::getInstance()->getNicks(
-            sr->getUser()->getCID(), sr->getHubURL());
-        sri.nick = nicks.empty() ? "" : nicks[0];
-    }
     sri.isDirectory = (sr->getType() == dcpp::SearchResult::TYPE_DIRECTORY);
     return sri;
 }
 
+/// Caller holds the queue lock (listener callbacks already run under it).
+inline QueueItemInfo infoFromQueueItem(const dcpp::QueueItem* qi) {
+    QueueItemInfo info;
+    info.target = qi->getTarget();
+    info.filename = qi->getTargetFileName();
+    info.size = qi->getSize();
+    info.downloadedBytes = qi->getDownloadedBytes();
+    info.tth = qi->getTTH().toBase32();
+    info.priority = static_cast<int>(qi->getPriority());
+    info.sources = static_cast<int>(qi->getSources().size());
+    info.onlineSources = qi->countOnlineUsers();
+    info.status = qi->isFinished() ? 2 : (qi->isRunning() ? 1 : 0);
+    return info;
+}
+
 inline TransferInfo infoFromDownload(const dcpp::Download* dl) {
     TransferInfo ti;
     ti.filename = dl->getPath();
@@ -138,13 +161,180 @@ public:
     // ----- Setup / teardown -----
 
     void setBridge(DCBridge* bridge) {
-        std::lock_guard<std::mutex> lk(m_mutex);
+        auto lk = lockCounted(m_mutex, m_mutexCounters);
         m_bridge = bridge;
     }
 
     void setCallback(DCClientCallback* cb) {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        m_callback = cb;
+        m_callback.store(cb, std::memory_order_release);
+    }
+
+    // ----- Queued dispatch -----
+
+    /// Switch between direct director calls and the event ring.
+    /// The ring is allocated the first time queued mode is enabled and
+    /// keeps that capacity for the life of the process.
+    void setDispatchMode(int mode, size_t queueCapacity);
+
+    int getDispatchMode() const {
+        return m_queued.load(std::memory_order_acquire)
+            ? DISPATCH_QUEUED : DISPATCH_DIRECT;
+    }
+
+    /// Drain up to maxEvents records (all queued records if <= 0).
+    /// Clears the wakeup descriptor first, and re-arms it if records
+    /// are left behind.
+    std::vector<BridgeEvent> pollEvents(int maxEvents);
+
+    /// Descriptor that turns readable when the ring goes from drained to
+    /// holding records — an eventfd on Linux, the read end of a pipe
+    /// elsewhere — so an event loop can wait on it and drain in batches.
+    /// Created on first call and kept for the life of the process; -1 if
+    /// it could not be created.
+    int getEventFd();
+
+    EventQueueStats getEventQueueStats() const;
+
+    /// Event counters and callback latencies, m_mutex contention, and
+    /// the depth of every internal backlog (DCBridge adds its own locks).
+    void fillMetrics(BridgeMetrics& out);
+
+    /// Hold back per-user UserUpdated / UserRemoved callbacks and deliver
+    /// them as onUsersConnectedBatch / onUsersRemovedBatch once per timer
+    /// tick, keeping only the latest state per nick.  Disabling flushes
+    /// whatever is pending.
+    void setUserEventCoalescing(bool enable);
+
+    bool getUserEventCoalescing() const {
+        return m_coalesceUsers.load(std::memory_order_relaxed);
+    }
+
+    /// Bit (1 << EventType) set = deliver that type (all set by default).
+    /// Masked events are not even built.
+    void setEventMask(uint64_t mask) {
+        m_eventMask.store(mask, std::memory_order_relaxed);
+    }
+
+    uint64_t getEventMask() const {
+        return m_eventMask.load(std::memory_order_relaxed);
+    }
+
+    /// Per-EventType dispatch policies (see DCBridge::setEventPolicy).
+    bool setEventPolicy(int eventType, int policy, int ratePerSecond);
+    int getEventPolicy(int eventType) const;
+    std::vector<EventPolicyStats> getEventPolicyStats() const;
+    void resetEventPolicies();
+
+    /// Deliver onTransferProgress every intervalMs (0 = never).  The core
+    /// ticks once a second, so shorter intervals mean every tick.
+    void setTransferProgressInterval(int intervalMs) {
+        m_progressIntervalMs.store(intervalMs < 0 ? 0 : intervalMs,
+                                   std::memory_order_relaxed);
+    }
+
+    int getTransferProgressInterval() const {
+        return m_progressIntervalMs.load(std::memory_order_relaxed);
+    }
+
+    /// Deliver onHashProgress every intervalMs (0 = never) while files
+    /// are queued for hashing, plus once when the queue drains.
+    void setHashProgressInterval(int intervalMs) {
+        m_hashIntervalMs.store(intervalMs < 0 ? 0 : intervalMs,
+                               std::memory_order_relaxed);
+    }
+
+    int getHashProgressInterval() const {
+        return m_hashIntervalMs.load(std::memory_order_relaxed);
+    }
+
+    /// Uploads and downloads in progress, as of the last core tick.
+    std::vector<TransferInfo> getActiveTransfers();
+
+    size_t activeTransferCount() {
+        std::lock_guard<std::mutex> lk(m_transfersMutex);
+        return m_transfers.size();
+    }
+
+    /// Forget tracked transfers (bridge shutdown).
+    void clearActiveTransfers();
+
+    /// While alive, collects the queue Added / Removed events fired on
+    /// the constructing thread and delivers them on destruction as one
+    /// onQueueItemsAddedBatch / onQueueItemsRemovedBatch.  QueueManager
+    /// fires those events synchronously from add() / remove(), so this
+    /// catches exactly what a DCBridge batch call caused.  Nested scopes
+    /// feed the outermost one, but still count what was collected while
+    /// they were open.  The queue mirror is updated per event either way.
+    class QueueEventBatch {
+    public:
+        QueueEventBatch();
+        ~QueueEventBatch();
+        QueueEventBatch(const QueueEventBatch&) = delete;
+        QueueEventBatch& operator=(const QueueEventBatch&) = delete;
+
+        size_t addedCount() const {
+            return collector().m_added.size() - m_addedBase;
+        }
+        size_t removedCount() const {
+            return collector().m_removed.size() - m_removedBase;
+        }
+
+    private:
+        friend class BridgeListeners;
+        const QueueEventBatch& collector() const {
+            return m_outer ? *m_outer : *this;
+        }
+        QueueEventBatch* m_outer;
+        std::vector<QueueItemInfo> m_added;
+        std::vector<std::string> m_removed;
+        // The collector's sizes when this scope opened
+        size_t m_addedBase = 0;
+        size_t m_removedBase = 0;
+    };
+
+    /// A status line from a DCBridge call (e.g. refreshShareDir); hubUrl
+    /// is empty when no hub is involved.
+    void statusMessage(const std::string& hubUrl, const std::string& text) {
+        emit(EVENT_STATUS_MESSAGE, hubUrl, text);
+    }
+
+    /// File-list loader notifications (DCBridge::openFileListAsync).
+    /// Called from loader threads, never with a bridge lock held.
+    void fileListProgress(const std::string& fileListId, int percent) {
+        if (!wants(EVENT_FILE_LIST_PROGRESS)) return;
+        BridgeEvent ev;
+        ev.type = EVENT_FILE_LIST_PROGRESS;
+        ev.text = fileListId;
+        ev.value = percent;
+        emit(std::move(ev));
+    }
+
+    void fileListLoaded(const std::string& fileListId, bool success,
+                        const std::string& error) {
+        if (!wants(EVENT_FILE_LIST_LOADED)) return;
+        BridgeEvent ev;
+        ev.type = EVENT_FILE_LIST_LOADED;
+        ev.text = fileListId;
+        ev.flag = success;
+        ev.extra = error;
+        emit(std::move(ev));
+    }
+
+    /// Startup finished (DCBridge::runStartup), on the thread that ran
+    /// it, with no bridge lock held.  Once per start, and waiters hang
+    /// without it, so it bypasses emit(): neither the event mask (left
+    /// over from a previous run of this singleton) nor a policy applies.
+    void coreReady(bool success, const std::string& error) {
+        if (!hasSink()) return;
+        BridgeEvent ev;
+        ev.type = EVENT_CORE_READY;
+        ev.flag = success;
+        ev.text = error;
+        m_eventCounters[EVENT_CORE_READY].raised.fetch_add(
+            1, std::memory_order_relaxed);
+        m_policies[EVENT_CORE_READY].delivered.fetch_add(
+            1, std::memory_order_relaxed);
+        dispatch(std::move(ev));
     }
 
     /// Subscribe to global managers (call once after dcpp::startup)
@@ -167,7 +357,7 @@ public:
 
     /// Attach to a specific hub client
     void attach(dcpp::Client* client, DCBridge* bridge) {
-        std::lock_guard<std::mutex> lk(m_mutex);
+        auto lk = lockCounted(m_mutex, m_mutexCounters);
         m_bridge = bridge;
         client->addListener(this);
     }
@@ -182,48 +372,40 @@ public:
     // =================================================================
 
     void on(dcpp::ClientListener::Connecting, dcpp::Client* c) noexcept override {
-        auto cb = getCallback();
-        if (cb) cb->onHubConnecting(c->getHubUrl());
+        emit(EVENT_HUB_CONNECTING, c->getHubUrl());
     }
 
     void on(dcpp::ClientListener::Connected, dcpp::Client* c) noexcept override {
-        refreshHubCache(c->getHubUrl(), c);
-        auto cb = getCallback();
-        if (cb) cb->onHubConnected(c->getHubUrl(), c->getHubName());
+        refreshHubCache(c);
+        emit(EVENT_HUB_CONNECTED, c->getHubUrl(), c->getHubName());
     }
 
     void on(dcpp::ClientListener::Failed, dcpp::Client* c,
             const std::string& reason) noexcept override {
-        markHubDisconnected(c->getHubUrl());
-        auto cb = getCallback();
-        if (cb) cb->onHubDisconnected(c->getHubUrl(), reason);
+        markHubDisconnected(c);
+        emit(EVENT_HUB_DISCONNECTED, c->getHubUrl(), reason);
     }
 
     void on(dcpp::ClientListener::Redirect, dcpp::Client* c,
             const std::string& newUrl) noexcept override {
-        auto cb = getCallback();
-        if (cb) cb->onHubRedirect(c->getHubUrl(), newUrl);
+        emit(EVENT_HUB_REDIRECT, c->getHubUrl(), newUrl);
     }
 
     void on(dcpp::ClientListener::GetPassword, dcpp::Client* c) noexcept override {
-        auto cb = getCallback();
-        if (cb) cb->onHubPasswordRequest(c->getHubUrl());
+        emit(EVENT_HUB_PASSWORD_REQUEST, c->getHubUrl());
     }
 
     void on(dcpp::ClientListener::HubUpdated, dcpp::Client* c) noexcept override {
-        refreshHubCache(c->getHubUrl(), c);
-        auto cb = getCallback();
-        if (cb) cb->onHubUpdated(c->getHubUrl(), c->getHubName());
+        refreshHubCache(c);
+        emit(EVENT_HUB_UPDATED, c->getHubUrl(), c->getHubName());
     }
 
     void on(dcpp::ClientListener::NickTaken, dcpp::Client* c) noexcept override {
-        auto cb = getCallback();
-        if (cb) cb->onNickTaken(c->getHubUrl());
+        emit(EVENT_NICK_TAKEN, c->getHubUrl());
     }
 
     void on(dcpp::ClientListener::HubFull, dcpp::Client* c) noexcept override {
-        auto cb = getCallback();
-        if (cb) cb->onHubFull(c->getHubUrl());
+        emit(EVENT_HUB_FULL, c->getHubUrl());
     }
 
     void on(dcpp::ClientListener::Message, dcpp::Client* c,
@@ -236,59 +418,81 @@ public:
             nick = msg.from->getIdentity().getNick();
         }
 
-        // Stash in chat history via bridge
-        stashChat(hubUrl, nick, text);
-
-        auto cb = getCallback();
-        if (!cb) return;
-
         // Determine if it was private or public
-        if (msg.to && msg.to->getIdentity().getNick().size() > 0) {
-            std::string toNick = msg.to->getIdentity().getNick();
-            cb->onPrivateMessage(hubUrl, nick, toNick, text);
+        bool isPrivate = msg.to && msg.to->getIdentity().getNick().size() > 0;
+
+        // Stash in chat history via bridge
+        stashChat(c, nick, text,
+                  msg.timestamp ? static_cast<int64_t>(msg.timestamp)
+                                : static_cast<int64_t>(std::time(nullptr)),
+                  msg.thirdPerson, isPrivate);
+        logChat(isPrivate ? CHAT_LOG_PRIVATE : CHAT_LOG_CHAT, hubUrl, nick,
+                isPrivate ? msg.to->getIdentity().getNick() : std::string(),
+                text, msg.thirdPerson);
+        if (!wants(isPrivate ? EVENT_PRIVATE_MESSAGE : EVENT_CHAT_MESSAGE)) {
+            return;
+        }
+        BridgeEvent ev;
+        ev.hubUrl = std::move(hubUrl);
+        ev.nick = std::move(nick);
+        ev.text = std::move(text);
+        if (isPrivate) {
+            ev.type = EVENT_PRIVATE_MESSAGE;
+            ev.extra = msg.to->getIdentity().getNick();
         } else {
-            cb->onChatMessage(hubUrl, nick, text, msg.thirdPerson);
+            ev.type = EVENT_CHAT_MESSAGE;
+            ev.flag = msg.thirdPerson;
         }
+        emit(std::move(ev));
     }
 
     void on(dcpp::ClientListener::StatusMessage, dcpp::Client* c,
             const std::string& msg, int flags) noexcept override {
-        auto cb = getCallback();
-        if (cb) cb->onStatusMessage(c->getHubUrl(), msg);
+        logChat(CHAT_LOG_STATUS, c->getHubUrl(), "", "", msg, false);
+        emit(EVENT_STATUS_MESSAGE, c->getHubUrl(), msg);
     }
 
     void on(dcpp::ClientListener::UserUpdated, dcpp::Client* c,
             const dcpp::OnlineUser& ou) noexcept override {
-        stashUserUpdate(c->getHubUrl(), ou);
-        refreshHubCache(c->getHubUrl(), c);
-        auto cb = getCallback();
-        if (cb) cb->onUserConnected(c->getHubUrl(), ou.getIdentity().getNick());
+        UserInfo ui = userFromOnlineUser(ou);
+        bool joined = stashUserUpdate(c, ui);
+        if (m_coalesceUsers.load(std::memory_order_relaxed)) {
+            queueUserEvent(c->getHubUrl(), false, std::move(ui), joined);
+            return;
+        }
+        emitNick(EVENT_USER_CONNECTED, c->getHubUrl(), ui.nick);
     }
 
     void on(dcpp::ClientListener::UsersUpdated, dcpp::Client* c,
             const dcpp::OnlineUserList& list) noexcept override {
-        auto cb = getCallback();
+        // Convert outside any lock, then apply the whole list under a
+        // single hub-lock acquisition and fire one batch callback.
+        std::vector<UserInfo> users;
+        users.reserve(list.size());
         for (auto& ou : list) {
-            stashUserUpdate(c->getHubUrl(), *ou);
-            if (cb) cb->onUserUpdated(c->getHubUrl(), ou->getIdentity().getNick());
+            users.push_back(userFromOnlineUser(*ou));
         }
-        // Refresh once after batch — user count / share total may have changed
-        refreshHubCache(c->getHubUrl(), c);
+        stashUserUpdates(c, users);
+        emitUsersUpdated(c->getHubUrl(), std::move(users));
     }
 
     void on(dcpp::ClientListener::UserRemoved, dcpp::Client* c,
             const dcpp::OnlineUser& ou) noexcept override {
-        stashUserRemove(c->getHubUrl(), ou.getIdentity().getNick());
-        refreshHubCache(c->getHubUrl(), c);
-        auto cb = getCallback();
-        if (cb) cb->onUserDisconnected(c->getHubUrl(), ou.getIdentity().getNick());
+        std::string nick = ou.getIdentity().getNick();
+        stashUserRemove(c, nick);
+        if (m_coalesceUsers.load(std::memory_order_relaxed)) {
+            UserInfo ui;
+            ui.nick = std::move(nick);
+            queueUserEvent(c->getHubUrl(), true, std::move(ui));
+            return;
+        }
+        emitNick(EVENT_USER_DISCONNECTED, c->getHubUrl(), nick);
     }
 
     void on(dcpp::ClientListener::SearchFlood, dcpp::Client* c,
             const std::string& msg) noexcept override {
-        auto cb = getCallback();
-        if (cb) cb->onStatusMessage(c->getHubUrl(),
-                                    "Search flood: " + msg);
+        noteSearchFlood(c->getHubUrl());
+        emit(EVENT_STATUS_MESSAGE, c->getHubUrl(), "Search flood: " + msg);
     }
 
     // =================================================================
@@ -298,14 +502,24 @@ public:
     void on(dcpp::SearchManagerListener::SR,
             const dcpp::SearchResultPtr& sr) noexcept override {
         auto info = infoFromSearchResult(sr);
-
-        // Store result in hub data
-        stashSearchResult(info);
-
-        auto cb = getCallback();
-        if (cb) cb->onSearchResult(info.hubUrl, info.file, info.size,
-                                    info.freeSlots, info.totalSlots,
-                                    info.tth, info.nick, info.isDirectory);
+        info.nick = nickForSearchResult(sr);
+
+        // File under its search.  Duplicates and over-cap results are
+        // only left out of the store; they are announced all the same.
+        stashSearchResult(sr, info);
+        if (!wants(EVENT_SEARCH_RESULT)) return;
+
+        BridgeEvent ev;
+        ev.type = EVENT_SEARCH_RESULT;
+        ev.hubUrl = std::move(info.hubUrl);
+        ev.text = std::move(info.file);
+        ev.size = info.size;
+        ev.freeSlots = info.freeSlots;
+        ev.totalSlots = info.totalSlots;
+        ev.extra = base32Encode(info.rawTTH.data(), info.rawTTH.size());
+        ev.nick = std::move(info.nick);
+        ev.flag = info.isDirectory;
+        emit(std::move(ev));
     }
 
     // =================================================================
@@ -314,40 +528,58 @@ public:
 
     void on(dcpp::QueueManagerListener::Added,
             dcpp::QueueItem* qi) noexcept override {
-        auto cb = getCallback();
-        if (cb) {
-            cb->onQueueItemAdded(qi->getTarget(), qi->getSize(),
-                                 qi->getTTH().toBase32());
+        QueueItemInfo info = infoFromQueueItem(qi);
+        if (auto* batch = currentQueueBatch()) {
+            batch->m_added.push_back(info);
+            stashQueueItem(std::move(info));
+            return;
         }
+        stashQueueItem(QueueItemInfo(info));
+        emitQueueAdded(info);
     }
 
     void on(dcpp::QueueManagerListener::Finished,
             dcpp::QueueItem* qi,
             const std::string& dir, int64_t speed) noexcept override {
-        auto cb = getCallback();
-        if (cb) {
-            cb->onQueueItemFinished(qi->getTarget(), qi->getSize());
-        }
+        stashQueueItem(infoFromQueueItem(qi));
+        if (qi->isSet(dcpp::QueueItem::FLAG_USER_LIST)) indexFinishedList(qi);
+        if (!wants(EVENT_QUEUE_ITEM_FINISHED)) return;
+        BridgeEvent ev;
+        ev.type = EVENT_QUEUE_ITEM_FINISHED;
+        ev.text = qi->getTarget();
+        ev.size = qi->getSize();
+        emit(std::move(ev));
     }
 
     void on(dcpp::QueueManagerListener::Removed,
             dcpp::QueueItem* qi) noexcept override {
-        auto cb = getCallback();
-        if (cb) {
-            std::string target = qi->getTarget();
-            cb->onQueueItemRemoved(target);
+        stashQueueRemove(qi->getTarget());
+        if (auto* batch = currentQueueBatch()) {
+            batch->m_removed.push_back(qi->getTarget());
+            return;
         }
+        emit(EVENT_QUEUE_ITEM_REMOVED, "", qi->getTarget());
     }
 
     void on(dcpp::QueueManagerListener::Moved,
             dcpp::QueueItem* qi,
             const std::string& oldTarget) noexcept override {
+        QueueItemInfo info = infoFromQueueItem(qi);
+        stashQueueRemove(oldTarget);
+        stashQueueItem(QueueItemInfo(info));
         // Item was moved to a new target path — report as new queue addition
-        auto cb = getCallback();
-        if (cb) {
-            cb->onQueueItemAdded(qi->getTarget(), qi->getSize(),
-                                 qi->getTTH().toBase32());
-        }
+        emitQueueAdded(info);
+    }
+
+    // Mirror-only: no Python callback for these
+    void on(dcpp::QueueManagerListener::SourcesUpdated,
+            dcpp::QueueItem* qi) noexcept override {
+        stashQueueItem(infoFromQueueItem(qi));
+    }
+
+    void on(dcpp::QueueManagerListener::StatusUpdated,
+            dcpp::QueueItem* qi) noexcept override {
+        stashQueueItem(infoFromQueueItem(qi));
     }
 
     // =================================================================
@@ -356,35 +588,34 @@ public:
 
     void on(dcpp::DownloadManagerListener::Starting,
             dcpp::Download* dl) noexcept override {
-        auto cb = getCallback();
-        if (cb) {
-            auto ti = infoFromDownload(dl);
-            cb->onDownloadStarting(ti.filename, ti.nick, ti.size);
-        }
+        TransferInfo ti = infoFromDownload(dl);
+        trackTransfer(dl, ti);
+        if (!wants(EVENT_DOWNLOAD_STARTING)) return;
+        emitTransfer(EVENT_DOWNLOAD_STARTING, std::move(ti));
     }
 
     void on(dcpp::DownloadManagerListener::Complete,
             dcpp::Download* dl) noexcept override {
-        auto cb = getCallback();
-        if (cb) {
-            auto ti = infoFromDownload(dl);
-            cb->onDownloadComplete(ti.filename, ti.nick, ti.size, ti.speed);
-        }
+        untrackTransfer(dl);
+        if (!wants(EVENT_DOWNLOAD_COMPLETE)) return;
+        emitTransfer(EVENT_DOWNLOAD_COMPLETE, infoFromDownload(dl));
     }
 
     void on(dcpp::DownloadManagerListener::Failed,
             dcpp::Download* dl,
             const std::string& reason) noexcept override {
-        auto cb = getCallback();
-        if (cb) {
-            auto ti = infoFromDownload(dl);
-            cb->onDownloadFailed(ti.filename, reason);
-        }
+        untrackTransfer(dl);
+        if (!wants(EVENT_DOWNLOAD_FAILED)) return;
+        BridgeEvent ev;
+        ev.type = EVENT_DOWNLOAD_FAILED;
+        ev.text = infoFromDownload(dl).filename;
+        ev.extra = reason;
+        emit(std::move(ev));
     }
 
     void on(dcpp::DownloadManagerListener::Tick,
             const dcpp::DownloadList& list) noexcept override {
-        // Periodic download progress — could aggregate or skip for now
+        tickTransfers(list);
     }
 
     // =================================================================
@@ -393,33 +624,30 @@ public:
 
     void on(dcpp::UploadManagerListener::Starting,
             dcpp::Upload* ul) noexcept override {
-        auto cb = getCallback();
-        if (cb) {
-            auto ti = infoFromUpload(ul);
-            cb->onUploadStarting(ti.filename, ti.nick, ti.size);
-        }
+        TransferInfo ti = infoFromUpload(ul);
+        trackTransfer(ul, ti);
+        if (!wants(EVENT_UPLOAD_STARTING)) return;
+        emitTransfer(EVENT_UPLOAD_STARTING, std::move(ti));
     }
 
     void on(dcpp::UploadManagerListener::Complete,
             dcpp::Upload* ul) noexcept override {
-        auto cb = getCallback();
-        if (cb) {
-            auto ti = infoFromUpload(ul);
-            cb->onUploadComplete(ti.filename, ti.nick, ti.size);
-        }
+        untrackTransfer(ul);
+        if (!wants(EVENT_UPLOAD_COMPLETE)) return;
+        emitTransfer(EVENT_UPLOAD_COMPLETE, infoFromUpload(ul));
     }
 
     void on(dcpp::UploadManagerListener::Failed,
             dcpp::Upload* ul,
             const std::string& reason) noexcept override {
+        untrackTransfer(ul);
         // Upload failure — report as status
-        auto cb = getCallback();
-        if (cb) cb->onStatusMessage("", "Upload failed: " + reason);
+        emit(EVENT_STATUS_MESSAGE, "", "Upload failed: " + reason);
     }
 
     void on(dcpp::UploadManagerListener::Tick,
             const dcpp::UploadList& list) noexcept override {
-        // Periodic upload progress — could aggregate or skip for now
+        tickTransfers(list);
     }
 
     // =================================================================
@@ -428,45 +656,324 @@ public:
 
     void on(dcpp::TimerManagerListener::Second,
             uint64_t tick) noexcept override {
-        // Periodic tick — could be used for keepalive, stats, etc.
+        refreshDirtyHubs();
+        flushUserEvents();
+        flushCoalescedEvents();
+        emitTransferProgress(tick);
+        emitHashProgress(tick);
+        flushChatLog(tick);
+        pumpSearches();
+        saveSettings(tick);
+        refreshStatus();
+    }
+
+    void on(dcpp::TimerManagerListener::Minute,
+            uint64_t tick) noexcept override {
+        expireSearches(tick);
     }
 
 private:
     BridgeListeners() = default;
+    ~BridgeListeners();
+
+    /// Make the wakeup descriptor readable, once per drain.
+    void signalWakeup();
+    void clearWakeup();
 
     DCClientCallback* getCallback() {
-        std::lock_guard<std::mutex> lk(m_mutex);
-        return m_callback;
+        return m_callback.load(std::memory_order_acquire);
+    }
+
+    /// Whether an event would reach anyone.  Lets handlers skip building
+    /// records (nick lookups, base32 encoding) when nobody is listening.
+    bool hasSink() {
+        return m_queued.load(std::memory_order_acquire) || getCallback();
     }
 
-    void stashChat(const std::string& hubUrl,
+    /// hasSink() for one EventType, also honouring the event mask.
+    /// A "no" counts items events (a batch's size) as raised and skipped.
+    bool wants(int type, size_t items = 1) {
+        if (((m_eventMask.load(std::memory_order_relaxed) >> type) & 1) &&
+                hasSink()) {
+            return true;
+        }
+        m_eventCounters[type].raised.fetch_add(items,
+                                               std::memory_order_relaxed);
+        m_eventCounters[type].skipped.fetch_add(items,
+                                                std::memory_order_relaxed);
+        return false;
+    }
+
+    /// Single exit point for every event: apply its type's policy, then
+    /// dispatch() what survives.
+    void emit(BridgeEvent&& ev);
+
+    /// Queue it or call the director (no policy).
+    void dispatch(BridgeEvent&& ev);
+
+    /// For batch paths that bypass emit(): false (and counted as dropped)
+    /// when the per-item type is set to POLICY_DROP.  Counts every item
+    /// as raised, as emit() would have.
+    bool policyAllowsBatch(int type, size_t items);
+
+    /// True when the type is coalesced or rate-limited.  Batch paths then
+    /// send each item through emit() instead, as in queued mode, so the
+    /// policy holds for batched and single events alike.
+    bool policyNeedsPerItem(int type) const;
+
+    /// POLICY_RATE_LIMIT check for one event; takes m_policyMutex.
+    bool takeRateToken(const BridgeEvent& ev, int ratePerSecond);
+
+    /// Deliver the events held by POLICY_COALESCE (Second tick).
+    void flushCoalescedEvents();
+
+    void emit(int type, const std::string& hubUrl,
+              const std::string& text = "") {
+        if (!wants(type)) return;
+        BridgeEvent ev;
+        ev.type = type;
+        ev.hubUrl = hubUrl;
+        ev.text = text;
+        emit(std::move(ev));
+    }
+
+    void emitNick(int type, const std::string& hubUrl,
+                  const std::string& nick) {
+        if (!wants(type)) return;
+        BridgeEvent ev;
+        ev.type = type;
+        ev.hubUrl = hubUrl;
+        ev.nick = nick;
+        emit(std::move(ev));
+    }
+
+    void emitTransfer(int type, TransferInfo&& ti) {
+        BridgeEvent ev;
+        ev.type = type;
+        ev.text = std::move(ti.filename);
+        ev.nick = std::move(ti.nick);
+        ev.size = ti.size;
+        ev.value = ti.speed;
+        emit(std::move(ev));
+    }
+
+    void emitQueueAdded(const QueueItemInfo& info) {
+        if (!wants(EVENT_QUEUE_ITEM_ADDED)) return;
+        BridgeEvent ev;
+        ev.type = EVENT_QUEUE_ITEM_ADDED;
+        ev.text = info.target;
+        ev.size = info.size;
+        ev.extra = info.tth;
+        emit(std::move(ev));
+    }
+
+    /// This thread's innermost QueueEventBatch, or nullptr.
+    static QueueEventBatch*& currentQueueBatch();
+
+    /// Deliver a finished QueueEventBatch: one director call per kind in
+    /// direct mode, one record per item in queued mode.
+    void emitQueueBatch(std::vector<QueueItemInfo>&& added,
+                        std::vector<std::string>&& removed);
+
+    /// Invoke the DCClientCallback method matching ev.type.
+    static void deliver(DCClientCallback* cb, const BridgeEvent& ev);
+
+    /// Batch user events: one director call in direct mode, one record
+    /// per user in queued mode (the ring already batches for Python).
+    void emitUsersUpdated(const std::string& hubUrl,
+                          std::vector<UserInfo>&& users);
+    void emitUsersConnected(const std::string& hubUrl,
+                            std::vector<UserInfo>&& users);
+    void emitUsersRemoved(const std::string& hubUrl,
+                          std::vector<std::string>&& nicks);
+
+    /// Record the latest state of a nick for the next tick's batch.
+    /// joined: a UserUpdated for a nick the hub did not list yet.  A
+    /// part of such a nick in the same tick cancels both events.
+    void queueUserEvent(const std::string& hubUrl, bool removed,
+                        UserInfo&& info, bool joined = false);
+
+    /// Deliver coalesced user events (called from the Second tick).
+    void flushUserEvents();
+
+    /// Active-transfer tracking.  Entries are keyed by the core's
+    /// Transfer object, added on Starting and dropped on Complete /
+    /// Failed; Ticks refresh pos / size / speed (nicks are looked up only
+    /// once, on Starting) and prune anything the core no longer lists.
+    void trackTransfer(const dcpp::Transfer* t, const TransferInfo& ti);
+    void untrackTransfer(const dcpp::Transfer* t);
+    void tickTransfers(const dcpp::DownloadList& list);
+    void tickTransfers(const dcpp::UploadList& list);
+
+    /// Deliver onTransferProgress if the interval has elapsed (called
+    /// from the Second tick).
+    void emitTransferProgress(uint64_t tick);
+
+    /// Deliver onHashProgress if the interval has elapsed and there is
+    /// (or just was) hashing to report (called from the Second tick).
+    void emitHashProgress(uint64_t tick);
+
+    /// Write deferred setting changes once they settle (Second tick).
+    void saveSettings(uint64_t tick);
+
+    /// Send queued searches whose hubs are ready (Second tick).
+    void pumpSearches();
+
+    /// Back off a hub's search interval (SearchFlood).
+    void noteSearchFlood(const std::string& hubUrl);
+
+    /// Rebuild DCBridge's status snapshot (called last in the Second
+    /// tick, so it sees this tick's hub counts).
+    void refreshStatus();
+
+    /// Drop idle search sessions (called from the Minute tick).
+    void expireSearches(uint64_t tick);
+
+    /// Update DCBridge's queue mirror.  Callers format the item before
+    /// the mirror lock is taken.
+    void stashQueueItem(QueueItemInfo&& info);
+    void stashQueueRemove(const std::string& target);
+
+    /// Queue a just-downloaded file list for the TTH index.
+    void indexFinishedList(dcpp::QueueItem* qi);
+
+    // Hub data is found by Client* (DCBridge::m_hubsByClient), which
+    // hashes a pointer instead of the hub URL on every event.
+    void stashChat(dcpp::Client* c,
                    const std::string& nick,
-                   const std::string& text);
+                   const std::string& text,
+                   int64_t timestamp, bool thirdPerson, bool isPrivate);
 
-    void stashSearchResult(const SearchResultInfo& info);
+    /// The sender's nick from the hub's user list (CID index), falling
+    /// back to ClientManager only for users the bridge has not seen.
+    std::string nickForSearchResult(const dcpp::SearchResultPtr& sr);
 
-    void stashUserUpdate(const std::string& hubUrl,
-                         const dcpp::OnlineUser& ou);
+    /// The hub a search result names, memoised per thread: results come
+    /// in bursts from a few hubs, so most skip the hub map entirely.
+    DCBridge::HubPtr hubForSearchResult(const std::string& hubUrl);
+    /// Append to the bridge's on-disk chat log, if enabled.
+    void logChat(int kind, const std::string& hubUrl, const std::string& nick,
+                 const std::string& to, const std::string& text,
+                 bool thirdPerson);
+    void flushChatLog(uint64_t tick);
 
-    void stashUserRemove(const std::string& hubUrl,
-                         const std::string& nick);
+    bool stashSearchResult(const dcpp::SearchResultPtr& sr,
+                           const SearchResultInfo& info);
 
-    void clearHubUsers(const std::string& hubUrl);
+    /// Users beyond DCBridge::m_maxHubUsers are not stored (only their
+    /// nick and share, in HubData::refusedUsers); their events are still
+    /// delivered.  Returns true if the hub did not list the nick before
+    /// (a join rather than an info change).
+    bool stashUserUpdate(dcpp::Client* c, const UserInfo& ui);
 
-    /// Snapshot Client* accessors into HubData::cachedInfo under m_mutex.
+    /// Apply a whole user list under one hub-lock acquisition.
+    void stashUserUpdates(dcpp::Client* c,
+                          const std::vector<UserInfo>& users);
+
+    void stashUserRemove(dcpp::Client* c, const std::string& nick);
+
+    void clearHubUsers(dcpp::Client* c);
+
+    /// Snapshot Client* accessors into HubData::cachedInfo (infoMutex).
     /// MUST be called from the socket thread (callback context) where
     /// Client* access is safe.  NmdcHub::cs is recursive, so calling
     /// getUserCount() while already under cs (some callbacks fire under
     /// cs) is fine.
-    void refreshHubCache(const std::string& hubUrl, dcpp::Client* c);
+    void refreshHubCache(dcpp::Client* c);
+
+    /// Fold the user count and share total of every hub whose user list
+    /// changed since the last tick into its cachedInfo (Second tick).
+    /// Reads the bridge's own UserStore, never Client*, so it is safe off
+    /// the socket thread; the other fields only change on Connected /
+    /// HubUpdated, which refresh the whole snapshot immediately.
+    void refreshDirtyHubs();
 
     /// Lightweight cache update for disconnect — sets connected=false
     /// without reading Client* accessors that may already be invalid.
-    void markHubDisconnected(const std::string& hubUrl);
+    void markHubDisconnected(dcpp::Client* c);
 
-    std::mutex m_mutex;
+    std::mutex m_mutex;             // lock through lockCounted()
+    LockCounters m_mutexCounters{"BridgeListeners::m_mutex"};
     DCBridge* m_bridge = nullptr;
-    DCClientCallback* m_callback = nullptr;
+    // Read on every raised event, so published like m_queued rather
+    // than under m_mutex
+    std::atomic<DCClientCallback*> m_callback{nullptr};
+
+    // Queued dispatch — the ring is created once (under m_mutex) and then
+    // read lock-free by producers; it lives as long as the singleton.
+    std::atomic<bool> m_queued{false};
+    std::atomic<EventRing<BridgeEvent>*> m_ring{nullptr};
+    std::unique_ptr<EventRing<BridgeEvent>> m_ringOwner;
+    std::atomic<uint64_t> m_eventSeq{0};
+    std::atomic<uint64_t> m_polled{0};
+
+    // Wakeup descriptor for queued mode.  The read and write ends are the
+    // same eventfd on Linux.  m_wakePending is set by the producer that
+    // signals and cleared by pollEvents(), so a burst costs one write().
+    std::atomic<int> m_wakeReadFd{-1};
+    std::atomic<int> m_wakeWriteFd{-1};
+    std::atomic<bool> m_wakePending{false};
+
+    // Coalesced user events: hub URL → nick → latest state this tick.
+    // joinedThisTick marks a nick first seen this tick, never announced.
+    struct PendingUserEvent {
+        bool removed = false;
+        bool joinedThisTick = false;
+        UserInfo info;
+    };
+    std::atomic<bool> m_coalesceUsers{false};
+
+    // Dispatch policies, indexed by EventType.  The policy is read
+    // lock-free on every emit; m_policyMutex only guards the rate-limit
+    // buckets and held coalesced events, keyed on type + hub (+ nick).
+    struct PolicySlot {
+        std::atomic<int> policy{POLICY_DELIVER};
+        std::atomic<int> rate{0};
+        std::atomic<uint64_t> delivered{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> coalesced{0};
+    };
+    struct RateBucket {
+        double tokens = 0;
+        uint64_t lastTick = 0;
+    };
+    static_assert(EVENT_TYPE_COUNT <= 64, "event mask is a uint64_t");
+    std::atomic<uint64_t> m_eventMask{~uint64_t(0)};
+    PolicySlot m_policies[EVENT_TYPE_COUNT];
+    std::mutex m_policyMutex;
+    std::unordered_map<std::string, RateBucket> m_rateBuckets;
+    std::unordered_map<std::string, BridgeEvent> m_coalescedEvents;
+
+    // Instrumentation, indexed by EventType (see getMetrics)
+    struct EventCounters {
+        std::atomic<uint64_t> raised{0};
+        std::atomic<uint64_t> skipped{0};
+        std::atomic<uint64_t> callbacks{0};
+        LatencyHistogram latency;
+    };
+    EventCounters m_eventCounters[EVENT_TYPE_COUNT];
+
+    /// Count and time one direct-mode callback of the given type.
+    CallbackTimer timeCallback(int type) {
+        return CallbackTimer(m_eventCounters[type].callbacks,
+                             m_eventCounters[type].latency);
+    }
+
+    // Active transfers (see trackTransfer)
+    std::mutex m_transfersMutex;
+    std::unordered_map<const dcpp::Transfer*, TransferInfo> m_transfers;
+    std::atomic<int> m_progressIntervalMs{0};
+    uint64_t m_lastProgressTick = 0;    // timer thread only
+
+    // Hash progress (see emitHashProgress); the last two are timer
+    // thread only
+    std::atomic<int> m_hashIntervalMs{0};
+    uint64_t m_lastHashTick = 0;
+    bool m_hashActive = false;
+
+    std::mutex m_pendingMutex;
+    std::unordered_map<std::string,
+        std::unordered_map<std::string, PendingUserEvent>> m_pendingUsers;
 };
 
 } // namespace eiskaltdcpp_py
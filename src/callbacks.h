@@ -14,6 +14,9 @@
 
 #include <string>
 #include <cstdint>
+#include <vector>
+
+#include "types.h"
 
 namespace eiskaltdcpp_py {
 
@@ -104,6 +107,31 @@ public:
     virtual void onUserUpdated(const std::string& hubUrl,
                                const std::string& nick) {}
 
+    /// A batch of users was added or updated in one go by the hub login
+    /// user-list flood.  The default forwards each entry to
+    /// onUserUpdated(); override it to take the whole list in a single
+    /// call.
+    virtual void onUsersUpdatedBatch(const std::string& hubUrl,
+                                     const std::vector<UserInfo>& users) {
+        for (const auto& u : users) onUserUpdated(hubUrl, u.nick);
+    }
+
+    /// A batch of users appeared or changed (UserUpdated events coalesced
+    /// within a timer tick, see DCBridge::setUserEventCoalescing).  These
+    /// are the events that fire onUserConnected() when coalescing is off,
+    /// so the default forwards each entry there.
+    virtual void onUsersConnectedBatch(const std::string& hubUrl,
+                                       const std::vector<UserInfo>& users) {
+        for (const auto& u : users) onUserConnected(hubUrl, u.nick);
+    }
+
+    /// A batch of users left (UserRemoved events coalesced within a timer
+    /// tick).  The default forwards each nick to onUserDisconnected().
+    virtual void onUsersRemovedBatch(const std::string& hubUrl,
+                                     const std::vector<std::string>& nicks) {
+        for (const auto& n : nicks) onUserDisconnected(hubUrl, n);
+    }
+
     // =====================================================================
     // Search events
     // =====================================================================
@@ -147,6 +175,11 @@ public:
                                   const std::string& nick,
                                   int64_t size) {}
 
+    /// Every active upload and download, at most once per
+    /// DCBridge::setTransferProgressInterval() (off by default).
+    virtual void onTransferProgress(
+            const std::vector<TransferInfo>& transfers) {}
+
     // =====================================================================
     // Queue events
     // =====================================================================
@@ -163,6 +196,44 @@ public:
     /// Item removed from download queue.
     virtual void onQueueItemRemoved(const std::string& target) {}
 
+    /// Several items were added by one batch call (addToQueueBatch,
+    /// addMagnetBatch).  The default forwards each to onQueueItemAdded().
+    virtual void onQueueItemsAddedBatch(
+            const std::vector<QueueItemInfo>& items) {
+        for (const auto& q : items) onQueueItemAdded(q.target, q.size, q.tth);
+    }
+
+    /// Several items were removed by one batch call (removeFromQueueBatch,
+    /// clearQueue).  The default forwards each to onQueueItemRemoved().
+    virtual void onQueueItemsRemovedBatch(
+            const std::vector<std::string>& targets) {
+        for (const auto& t : targets) onQueueItemRemoved(t);
+    }
+
+    // =====================================================================
+    // File list events
+    // =====================================================================
+
+    /// Background load progress (DCBridge::openFileListAsync), 0-99, or
+    /// -1 just before onFileListLoaded reports a failure.  Fired from a
+    /// loader thread, at most once per percent.
+    virtual void onFileListProgress(const std::string& fileListId,
+                                    int percent) {}
+
+    /// A background load finished.  On success the list is open and can
+    /// be browsed; otherwise error says why.
+    virtual void onFileListLoaded(const std::string& fileListId,
+                                  bool success,
+                                  const std::string& error) {}
+
+    // =====================================================================
+    // Lifecycle events
+    // =====================================================================
+
+    /// Startup finished (DCBridge::initializeAsync, and initialize()).
+    /// Fired on the thread that ran it.  On failure error says why.
+    virtual void onCoreReady(bool success, const std::string& error) {}
+
     // =====================================================================
     // Hashing events
     // =====================================================================
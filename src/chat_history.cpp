@@ -0,0 +1,123 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * chat_history.cpp — Slot-reusing chat ring with sequence-based reads.
+ */
+
+#include "chat_history.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace eiskaltdcpp_py {
+
+ChatHistory::ChatHistory(size_t capacity) : m_capacity(capacity) {}
+
+uint64_t ChatHistory::push(const std::string& nick, const std::string& text,
+                           int64_t timestamp, bool thirdPerson,
+                           bool isPrivate) {
+    uint64_t seq = m_nextSeq++;
+    if (m_capacity == 0) return seq;
+
+    Slot* slot;
+    if (m_slots.size() < m_capacity) {
+        // Still filling — m_head stays 0 until the ring first wraps
+        m_slots.emplace_back();
+        slot = &m_slots.back();
+        ++m_count;
+    } else {
+        slot = &m_slots[m_head];
+        m_head = (m_head + 1) % m_slots.size();
+    }
+    slot->seq = seq;
+    slot->timestamp = timestamp;
+    slot->flags = (thirdPerson ? FLAG_THIRD_PERSON : 0) |
+                  (isPrivate ? FLAG_PRIVATE : 0);
+    slot->nick.assign(nick);    // reuses the slot's buffer
+    slot->text.assign(text);
+    return seq;
+}
+
+void ChatHistory::setCapacity(size_t capacity) {
+    if (capacity == m_capacity) return;
+
+    // Re-linearize the newest lines so the ring starts at index 0 again
+    size_t keep = std::min(m_count, capacity);
+    std::vector<Slot> slots;
+    slots.reserve(keep);
+    for (size_t i = m_count - keep; i < m_count; ++i) {
+        slots.push_back(std::move(m_slots[(m_head + i) % m_slots.size()]));
+    }
+    m_slots.swap(slots);
+    m_capacity = capacity;
+    m_head = 0;
+    m_count = keep;
+}
+
+void ChatHistory::recentLines(size_t maxLines,
+                              std::vector<std::string>& out) const {
+    size_t n = (maxLines > 0) ? std::min(maxLines, m_count) : m_count;
+    out.reserve(out.size() + n);
+    for (size_t i = m_count - n; i < m_count; ++i) {
+        const Slot& s = at(i);
+        if (s.nick.empty()) {
+            out.push_back(s.text);
+        } else {
+            out.push_back("<" + s.nick + "> " + s.text);
+        }
+    }
+}
+
+void ChatHistory::since(uint64_t sinceSeq, size_t maxEntries,
+                        ChatHistoryPage& out) const {
+    out.entries.clear();
+    uint64_t last = lastSeq();
+
+    // A seq from the future means the hub was re-added and numbering
+    // started over — start from the oldest line and flag the gap
+    bool reset = sinceSeq > last;
+    if (reset) sinceSeq = 0;
+
+    uint64_t first = m_count ? at(0).seq : m_nextSeq;
+    out.gap = reset || sinceSeq + 1 < first;
+
+    // Retained seqs are contiguous, so the start index is arithmetic
+    size_t start = (sinceSeq < first)
+        ? 0 : static_cast<size_t>(sinceSeq + 1 - first);
+    size_t n = m_count - std::min(start, m_count);
+    if (maxEntries > 0) n = std::min(n, maxEntries);
+
+    out.entries.reserve(n);
+    for (size_t i = start; i < start + n; ++i) {
+        const Slot& s = at(i);
+        out.entries.emplace_back();
+        ChatEntry& e = out.entries.back();
+        e.seq = s.seq;
+        e.timestamp = s.timestamp;
+        e.nick = s.nick;
+        e.text = s.text;
+        e.thirdPerson = (s.flags & FLAG_THIRD_PERSON) != 0;
+        e.isPrivate = (s.flags & FLAG_PRIVATE) != 0;
+    }
+    out.lastSeq = n ? out.entries.back().seq : last;
+}
+
+void ChatHistory::clear() {
+    m_slots.clear();
+    m_head = 0;
+    m_count = 0;
+}
+
+size_t ChatHistory::memoryUsage() const {
+    size_t bytes = m_slots.capacity() * sizeof(Slot);
+    for (const Slot& s : m_slots) {
+        if (s.nick.capacity() > 15) bytes += s.nick.capacity() + 1;
+        if (s.text.capacity() > 15) bytes += s.text.capacity() + 1;
+    }
+    return bytes;
+}
+
+} // namespace eiskaltdcpp_py
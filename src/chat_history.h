@@ -0,0 +1,89 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * chat_history.h — Fixed-capacity per-hub chat ring.
+ *
+ * Replaces the deque of preformatted "<nick> text" strings in HubData.
+ * Slots are allocated once, up to the capacity, and keep their nick and
+ * text buffers when the ring wraps: once the ring is full, storing a
+ * line only copies characters into an existing buffer and allocates only
+ * when a line is longer than every line that slot held before.
+ *
+ * Every line gets a per-hub sequence number, so readers can tail the
+ * ring with since() and copy only what is new.
+ *
+ * Not thread-safe — callers hold the owning hub's HubData::mutex.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+namespace eiskaltdcpp_py {
+
+class ChatHistory {
+public:
+    static const size_t DEFAULT_CAPACITY = 500;
+
+    explicit ChatHistory(size_t capacity = DEFAULT_CAPACITY);
+
+    /// Store one line, evicting the oldest when full.  Returns its seq.
+    uint64_t push(const std::string& nick, const std::string& text,
+                  int64_t timestamp, bool thirdPerson, bool isPrivate);
+
+    /// Resize, keeping the newest lines.  0 keeps no history at all.
+    void setCapacity(size_t capacity);
+    size_t capacity() const { return m_capacity; }
+
+    size_t size() const { return m_count; }
+
+    /// Seq of the newest line (0 before the first one).
+    uint64_t lastSeq() const { return m_nextSeq - 1; }
+
+    /// The newest maxLines (0 = all) as "<nick> text", oldest first.
+    void recentLines(size_t maxLines, std::vector<std::string>& out) const;
+
+    /// Lines after sinceSeq, oldest first, at most maxEntries (0 = all).
+    void since(uint64_t sinceSeq, size_t maxEntries,
+               ChatHistoryPage& out) const;
+
+    /// Drop every line.  Sequence numbers keep counting.
+    void clear();
+
+    /// Approximate heap bytes held by the ring.
+    size_t memoryUsage() const;
+
+private:
+    enum : uint8_t {
+        FLAG_THIRD_PERSON = 1 << 0,
+        FLAG_PRIVATE      = 1 << 1,
+    };
+
+    struct Slot {
+        uint64_t seq = 0;
+        int64_t timestamp = 0;
+        uint8_t flags = 0;
+        std::string nick;
+        std::string text;
+    };
+
+    /// i-th retained line, 0 = oldest.
+    const Slot& at(size_t i) const {
+        return m_slots[(m_head + i) % m_slots.size()];
+    }
+
+    std::vector<Slot> m_slots;      // grows to m_capacity, then wraps
+    size_t m_capacity;
+    size_t m_head = 0;              // index of the oldest line
+    size_t m_count = 0;
+    uint64_t m_nextSeq = 1;
+};
+
+} // namespace eiskaltdcpp_py
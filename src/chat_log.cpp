@@ -0,0 +1,431 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * chat_log.cpp — Buffered segment writer and mmap range reader.
+ */
+
+#include "chat_log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace eiskaltdcpp_py {
+
+// Segment layout (native byte order; the marker rejects a foreign one):
+//   char[8] MAGIC, uint32 VERSION, uint32 ENDIAN_MARK
+//   records, each:
+//     uint32 length (whole record), uint8 kind, uint8 flags,
+//     uint16 hubLen, uint16 nickLen, uint16 toLen, int64 timestamp,
+//     char hub[hubLen], nick[nickLen], to[toLen], text[rest]
+static const char MAGIC[8] = {'D', 'C', 'P', 'Y', 'C', 'L', 'O', 'G'};
+static const uint32_t VERSION = 1;
+static const uint32_t ENDIAN_MARK = 0x01020304;
+static const size_t SEGMENT_HEADER = sizeof(MAGIC) + 2 * sizeof(uint32_t);
+static const size_t RECORD_HEADER = 4 + 1 + 1 + 2 + 2 + 2 + 8;
+static const size_t MAX_FIELD = 0xFFFF;
+static const size_t MAX_TEXT = 1 << 20;
+
+static const uint8_t FLAG_THIRD_PERSON = 1 << 0;
+
+namespace {
+
+struct RecordView {
+    int kind;
+    bool thirdPerson;
+    int64_t timestamp;
+    const char* hub;   size_t hubLen;
+    const char* nick;  size_t nickLen;
+    const char* to;    size_t toLen;
+    const char* text;  size_t textLen;
+};
+
+template <typename T>
+void put(std::string& out, const T& v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+template <typename T>
+T peek(const uint8_t* p) {
+    T v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+bool validHeader(const uint8_t* data, size_t size) {
+    return size >= SEGMENT_HEADER &&
+           memcmp(data, MAGIC, sizeof(MAGIC)) == 0 &&
+           peek<uint32_t>(data + 8) == VERSION &&
+           peek<uint32_t>(data + 12) == ENDIAN_MARK;
+}
+
+/// Walk the records of a mapped segment; fn returns false to stop.
+/// Returns the offset just past the last complete record.
+template <typename Fn>
+size_t scanRecords(const uint8_t* data, size_t size, Fn&& fn) {
+    size_t off = SEGMENT_HEADER;
+    while (off + RECORD_HEADER <= size) {
+        const uint8_t* p = data + off;
+        uint32_t length = peek<uint32_t>(p);
+        size_t hubLen = peek<uint16_t>(p + 6);
+        size_t nickLen = peek<uint16_t>(p + 8);
+        size_t toLen = peek<uint16_t>(p + 10);
+        if (length < RECORD_HEADER + hubLen + nickLen + toLen ||
+                length > size - off) {
+            break;      // torn or corrupt — nothing after it is trusted
+        }
+        RecordView r;
+        r.kind = p[4];
+        r.thirdPerson = (p[5] & FLAG_THIRD_PERSON) != 0;
+        r.timestamp = peek<int64_t>(p + 12);
+        const char* s = reinterpret_cast<const char*>(p + RECORD_HEADER);
+        r.hub = s;                  r.hubLen = hubLen;
+        r.nick = r.hub + hubLen;    r.nickLen = nickLen;
+        r.to = r.nick + nickLen;    r.toLen = toLen;
+        r.text = r.to + toLen;
+        r.textLen = length - RECORD_HEADER - hubLen - nickLen - toLen;
+        off += length;
+        if (!fn(r)) break;
+    }
+    return off;
+}
+
+/// Read-only mapping of one file, unmapped on destruction.
+class Mapping {
+public:
+    explicit Mapping(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = mmap(nullptr, static_cast<size_t>(st.st_size),
+                           PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                m_data = static_cast<const uint8_t*>(p);
+                m_size = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+    }
+    ~Mapping() {
+        if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool valid() const { return m_data && validHeader(m_data, m_size); }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+bool makeDirectories(const std::string& path) {
+    for (size_t pos = 1; pos <= path.size(); ++pos) {
+        if (pos != path.size() && path[pos] != '/') continue;
+        std::string prefix = path.substr(0, pos);
+        if (::mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) {
+            return false;
+        }
+    }
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool writeAll(int fd, const char* p, size_t n) {
+    while (n > 0) {
+        ssize_t w = ::write(fd, p, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += w;
+        n -= static_cast<size_t>(w);
+    }
+    return true;
+}
+
+} // namespace
+
+ChatLog::~ChatLog() {
+    close();
+}
+
+std::string ChatLog::segmentPath(uint32_t index) const {
+    char name[32];
+    snprintf(name, sizeof(name), "chat-%08u.dclog", index);
+    return m_opts.directory + "/" + name;
+}
+
+std::vector<uint32_t> ChatLog::listSegments() const {
+    std::vector<uint32_t> out;
+    DIR* dir = opendir(m_opts.directory.c_str());
+    if (!dir) return out;
+    while (struct dirent* e = readdir(dir)) {
+        unsigned index = 0;
+        char tail[8] = {};
+        if (sscanf(e->d_name, "chat-%8u.%7s", &index, tail) == 2 &&
+                strcmp(tail, "dclog") == 0 && index > 0) {
+            out.push_back(index);
+        }
+    }
+    closedir(dir);
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+bool ChatLog::openSegment(uint32_t index) {
+    std::string path = segmentPath(index);
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    off_t end = 0;
+    if (st.st_size > 0) {
+        // Resume after the last complete record, cutting off a torn tail
+        Mapping map(path);
+        if (!map.valid()) {
+            ::close(fd);
+            return false;
+        }
+        end = static_cast<off_t>(scanRecords(map.data(), map.size(),
+            [](const RecordView&) { return true; }));
+        if (end != st.st_size && ftruncate(fd, end) != 0) {
+            ::close(fd);
+            return false;
+        }
+    } else {
+        std::string header(MAGIC, sizeof(MAGIC));
+        put(header, VERSION);
+        put(header, ENDIAN_MARK);
+        if (!writeAll(fd, header.data(), header.size())) {
+            ::close(fd);
+            return false;
+        }
+        end = static_cast<off_t>(header.size());
+    }
+    if (lseek(fd, end, SEEK_SET) != end) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_segment = index;
+    m_segmentBytes = end;
+    return true;
+}
+
+void ChatLog::closeSegment() {
+    if (m_fd < 0) return;
+    if (m_unsynced) fdatasync(m_fd);
+    ::close(m_fd);
+    m_fd = -1;
+    m_unsynced = false;
+}
+
+bool ChatLog::open(const Options& opts) {
+    close();
+    std::lock_guard<std::mutex> lk(m_fileMutex);
+    m_opts = opts;
+    while (m_opts.directory.size() > 1 && m_opts.directory.back() == '/') {
+        m_opts.directory.pop_back();
+    }
+    if (m_opts.directory.empty() || !makeDirectories(m_opts.directory)) {
+        return false;
+    }
+
+    std::vector<uint32_t> segments = listSegments();
+    uint32_t next = segments.empty() ? 1 : segments.back();
+    if (!openSegment(next)) {
+        // Newest segment is foreign or unreadable — leave it, start anew
+        if (segments.empty() || !openSegment(next + 1)) return false;
+    }
+    m_lastSyncMs = 0;
+    m_open.store(true, std::memory_order_release);
+    return true;
+}
+
+void ChatLog::close() {
+    if (!m_open.exchange(false, std::memory_order_acq_rel)) return;
+    std::lock_guard<std::mutex> lk(m_fileMutex);
+    std::string data;
+    {
+        std::lock_guard<std::mutex> blk(m_bufferMutex);
+        data.swap(m_buffer);
+    }
+    writeOut(data);
+    closeSegment();
+}
+
+void ChatLog::append(int kind, const std::string& hubUrl,
+                     const std::string& nick, const std::string& to,
+                     const std::string& text, int64_t timestamp,
+                     bool thirdPerson) {
+    if (!isOpen()) return;
+
+    uint16_t hubLen = static_cast<uint16_t>(std::min(hubUrl.size(), MAX_FIELD));
+    uint16_t nickLen = static_cast<uint16_t>(std::min(nick.size(), MAX_FIELD));
+    uint16_t toLen = static_cast<uint16_t>(std::min(to.size(), MAX_FIELD));
+    size_t textLen = std::min(text.size(), MAX_TEXT);
+    uint32_t length = static_cast<uint32_t>(
+        RECORD_HEADER + hubLen + nickLen + toLen + textLen);
+
+    std::lock_guard<std::mutex> lk(m_bufferMutex);
+    if (m_buffer.size() + length > MAX_BUFFER_BYTES) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    put(m_buffer, length);
+    m_buffer.push_back(static_cast<char>(kind));
+    m_buffer.push_back(static_cast<char>(thirdPerson ? FLAG_THIRD_PERSON : 0));
+    put(m_buffer, hubLen);
+    put(m_buffer, nickLen);
+    put(m_buffer, toLen);
+    put(m_buffer, timestamp);
+    m_buffer.append(hubUrl, 0, hubLen);
+    m_buffer.append(nick, 0, nickLen);
+    m_buffer.append(to, 0, toLen);
+    m_buffer.append(text, 0, textLen);
+    m_records.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ChatLog::writeOut(const std::string& data) {
+    if (data.empty() || m_fd < 0) return;
+
+    if (m_opts.maxSegmentBytes > 0 &&
+            m_segmentBytes > static_cast<int64_t>(SEGMENT_HEADER) &&
+            m_segmentBytes + static_cast<int64_t>(data.size()) >
+            m_opts.maxSegmentBytes) {
+        uint32_t next = m_segment + 1;
+        closeSegment();
+        if (!openSegment(next)) return;
+
+        if (m_opts.maxSegments > 0) {
+            std::vector<uint32_t> segments = listSegments();
+            size_t keep = static_cast<size_t>(m_opts.maxSegments);
+            for (size_t i = 0; i + keep < segments.size(); ++i) {
+                std::remove(segmentPath(segments[i]).c_str());
+            }
+        }
+    }
+
+    if (writeAll(m_fd, data.data(), data.size())) {
+        m_segmentBytes += static_cast<int64_t>(data.size());
+        m_unsynced = true;
+    } else {
+        // Drop back to the last whole record so the segment stays readable
+        ftruncate(m_fd, m_segmentBytes);
+        lseek(m_fd, m_segmentBytes, SEEK_SET);
+    }
+}
+
+void ChatLog::sync(uint64_t nowMs) {
+    if (m_fd < 0 || !m_unsynced) return;
+    fdatasync(m_fd);
+    m_unsynced = false;
+    m_lastSyncMs = nowMs;
+}
+
+void ChatLog::flush(uint64_t nowMs, bool force) {
+    if (!isOpen()) return;
+    std::lock_guard<std::mutex> lk(m_fileMutex);
+    std::string data;
+    {
+        std::lock_guard<std::mutex> blk(m_bufferMutex);
+        data.swap(m_buffer);
+    }
+    writeOut(data);
+    if (force || nowMs - m_lastSyncMs >=
+            static_cast<uint64_t>(std::max(m_opts.fsyncIntervalMs, 0))) {
+        sync(nowMs);
+    }
+}
+
+std::vector<ChatLogEntry> ChatLog::query(const std::string& hubUrl,
+                                         int64_t fromTime, int64_t toTime,
+                                         size_t maxEntries) {
+    std::vector<ChatLogEntry> out;
+    std::vector<std::string> paths;
+    {
+        std::lock_guard<std::mutex> lk(m_fileMutex);
+        if (m_opts.directory.empty()) return out;
+        if (isOpen()) {
+            // Make buffered records visible; no fsync needed for reading
+            std::string data;
+            {
+                std::lock_guard<std::mutex> blk(m_bufferMutex);
+                data.swap(m_buffer);
+            }
+            writeOut(data);
+        }
+        for (uint32_t index : listSegments()) {
+            paths.push_back(segmentPath(index));
+        }
+    }
+
+    // Scan with no lock held — mappings are private snapshots
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (maxEntries > 0 && out.size() >= maxEntries) break;
+
+        // Everything in segment i predates the first record of i + 1
+        if (fromTime > 0 && i + 1 < paths.size()) {
+            Mapping next(paths[i + 1]);
+            int64_t nextFirst = 0;
+            bool have = false;
+            if (next.valid()) {
+                scanRecords(next.data(), next.size(),
+                    [&](const RecordView& r) {
+                        nextFirst = r.timestamp;
+                        have = true;
+                        return false;
+                    });
+            }
+            if (have && nextFirst < fromTime) continue;
+        }
+
+        Mapping map(paths[i]);
+        if (!map.valid()) continue;
+        bool past = false;
+        scanRecords(map.data(), map.size(), [&](const RecordView& r) {
+            if (toTime > 0 && r.timestamp >= toTime) {
+                past = true;
+                return false;
+            }
+            if (r.timestamp < fromTime) return true;
+            if (!hubUrl.empty() &&
+                    hubUrl.compare(0, std::string::npos, r.hub, r.hubLen) != 0) {
+                return true;
+            }
+            out.emplace_back();
+            ChatLogEntry& e = out.back();
+            e.timestamp = r.timestamp;
+            e.kind = r.kind;
+            e.thirdPerson = r.thirdPerson;
+            e.hubUrl.assign(r.hub, r.hubLen);
+            e.nick.assign(r.nick, r.nickLen);
+            e.to.assign(r.to, r.toLen);
+            e.text.assign(r.text, r.textLen);
+            return maxEntries == 0 || out.size() < maxEntries;
+        });
+        if (past) break;
+    }
+    return out;
+}
+
+} // namespace eiskaltdcpp_py
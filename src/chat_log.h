@@ -0,0 +1,121 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * chat_log.h — Opt-in append-only chat / PM / status log on disk.
+ *
+ * Lines are appended from the hub socket threads straight into a memory
+ * buffer (one short lock, no I/O); the Second tick writes the buffer out
+ * and fsyncs at most once per fsync interval, so a burst of chat costs
+ * one write() and one fsync() rather than one per line — and never a
+ * trip through Python.
+ *
+ * The log is a directory of numbered segments, chat-00000001.dclog, ...
+ * A segment is closed and a new one started once it reaches the size
+ * limit; the oldest segments are deleted beyond maxSegments (0 = keep
+ * them all).
+ *
+ * query() maps each segment read-only and scans it in place, copying out
+ * only the records that match the hub and time range.  Segments whose
+ * time span lies outside the range are skipped after reading their first
+ * record.  A record torn by a crash ends the scan of its segment.
+ *
+ * Timestamps are the time the bridge received the line, so they only
+ * move forward from one segment to the next.
+ *
+ * Thread-safe: m_bufferMutex guards the pending buffer, m_fileMutex the
+ * open segment.  Appenders take only m_bufferMutex; flushers take
+ * m_fileMutex, then m_bufferMutex just long enough to swap the buffer
+ * out, so buffers reach the file in order.  Both are leaves.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+namespace eiskaltdcpp_py {
+
+class ChatLog {
+public:
+    struct Options {
+        std::string directory;
+        int64_t maxSegmentBytes = 64LL << 20;   // 0 = never rotate
+        int maxSegments = 0;            // 0 = never delete
+        int fsyncIntervalMs = 1000;     // 0 = fsync on every flush
+    };
+
+    ChatLog() = default;
+    ~ChatLog();
+    ChatLog(const ChatLog&) = delete;
+    ChatLog& operator=(const ChatLog&) = delete;
+
+    /// Start logging into opts.directory (created if missing), appending
+    /// to its newest segment.  Returns false if it cannot be opened.
+    bool open(const Options& opts);
+
+    /// Flush, fsync and stop logging.
+    void close();
+
+    bool isOpen() const { return m_open.load(std::memory_order_acquire); }
+
+    /// Buffer one record.  Cheap no-op while closed.
+    void append(int kind, const std::string& hubUrl, const std::string& nick,
+                const std::string& to, const std::string& text,
+                int64_t timestamp, bool thirdPerson);
+
+    /// Write out buffered records; fsync if the interval has elapsed
+    /// (or force).  Called from the Second tick.
+    void flush(uint64_t nowMs, bool force = false);
+
+    /// Records for hubUrl ("" = every hub) with fromTime <= timestamp
+    /// and, if toTime > 0, timestamp < toTime, oldest first, at most
+    /// maxEntries (0 = all).  Buffered records are flushed first.
+    std::vector<ChatLogEntry> query(const std::string& hubUrl,
+                                    int64_t fromTime, int64_t toTime,
+                                    size_t maxEntries);
+
+    /// Records buffered so far, and records dropped because the buffer
+    /// was full (the disk fell behind by MAX_BUFFER_BYTES).
+    uint64_t recordsLogged() const {
+        return m_records.load(std::memory_order_relaxed);
+    }
+    uint64_t recordsDropped() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    static const size_t MAX_BUFFER_BYTES = 8 << 20;
+
+private:
+    std::string segmentPath(uint32_t index) const;
+    std::vector<uint32_t> listSegments() const;
+    // Callers hold m_fileMutex
+    bool openSegment(uint32_t index);
+    void closeSegment();
+    void writeOut(const std::string& data);
+    void sync(uint64_t nowMs);
+
+    std::atomic<bool> m_open{false};
+    std::atomic<uint64_t> m_records{0};
+    std::atomic<uint64_t> m_dropped{0};
+
+    std::mutex m_bufferMutex;
+    std::string m_buffer;
+
+    std::mutex m_fileMutex;
+    Options m_opts;
+    int m_fd = -1;
+    uint32_t m_segment = 0;
+    int64_t m_segmentBytes = 0;
+    uint64_t m_lastSyncMs = 0;
+    bool m_unsynced = false;
+};
+
+} // namespace eiskaltdcpp_py
@@ -0,0 +1,123 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * event_ring.h — Bounded lock-free ring used for queued event dispatch.
+ *
+ * dcpp socket / timer / UDP threads are the producers; Python drains the
+ * ring through DCBridge::pollEvents().  This is Dmitry Vyukov's bounded
+ * MPMC queue: every cell carries a sequence number so producers claim a
+ * slot with a single CAS and never wait on each other or on the consumer.
+ * When the ring is full the new record is dropped and counted — a
+ * producer never blocks, which is the whole point of queued mode.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace eiskaltdcpp_py {
+
+template <typename T>
+class EventRing {
+public:
+    /// @param capacity  Number of slots; rounded up to a power of two.
+    explicit EventRing(size_t capacity) {
+        size_t n = 2;
+        while (n < capacity) n <<= 1;
+        m_mask = n - 1;
+        m_cells.reset(new Cell[n]);
+        for (size_t i = 0; i < n; ++i) {
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    EventRing(const EventRing&) = delete;
+    EventRing& operator=(const EventRing&) = delete;
+
+    /// Append a record.  Returns false (and counts a drop) when full.
+    bool push(T&& item) {
+        Cell* cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t dif = static_cast<intptr_t>(seq) -
+                           static_cast<intptr_t>(pos);
+            if (dif == 0) {
+                if (m_enqueuePos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(item);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Remove the oldest record.  Returns false when empty.
+    bool pop(T& out) {
+        Cell* cell;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t dif = static_cast<intptr_t>(seq) -
+                           static_cast<intptr_t>(pos + 1);
+            if (dif == 0) {
+                if (m_dequeuePos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->data);
+        cell->seq.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+    /// Approximate number of queued records (exact when quiescent).
+    size_t size() const {
+        size_t head = m_dequeuePos.load(std::memory_order_relaxed);
+        size_t tail = m_enqueuePos.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    uint64_t pushed() const { return m_pushed.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq{0};
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask = 0;
+
+    // Producer and consumer cursors on separate cache lines
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) std::atomic<size_t> m_dequeuePos{0};
+
+    std::atomic<uint64_t> m_pushed{0};
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+} // namespace eiskaltdcpp_py
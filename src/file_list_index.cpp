@@ -0,0 +1,96 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * file_list_index.cpp — Per-directory child hash maps for file lists.
+ */
+
+#include "file_list_index.h"
+
+#include <vector>
+
+namespace eiskaltdcpp_py {
+
+FileListIndex::FileListIndex(Directory* root) : m_root(root) {
+    if (root) build(root);
+}
+
+void FileListIndex::build(Directory* root) {
+    // Explicit stack: file lists can nest deeply enough that recursion
+    // on a loader thread's stack is not something to rely on.
+    std::vector<Directory*> stack{root};
+    while (!stack.empty()) {
+        Directory* dir = stack.back();
+        stack.pop_back();
+
+        if (dir->directories.size() + dir->files.size() >=
+                MIN_INDEXED_CHILDREN) {
+            Children& c = m_children[dir];
+            c.dirs.reserve(dir->directories.size());
+            c.files.reserve(dir->files.size());
+            // emplace keeps the first of any duplicate names, which is
+            // what a front-to-back scan would have found
+            for (auto* d : dir->directories) {
+                c.dirs.emplace(std::string_view(d->getName()), d);
+            }
+            for (auto* f : dir->files) {
+                c.files.emplace(std::string_view(f->getName()), f);
+            }
+        }
+        for (auto* d : dir->directories) stack.push_back(d);
+    }
+}
+
+FileListIndex::Directory* FileListIndex::childDir(
+        const Directory* dir, std::string_view name) const {
+    auto it = m_children.find(dir);
+    if (it != m_children.end()) {
+        auto c = it->second.dirs.find(name);
+        return c == it->second.dirs.end() ? nullptr : c->second;
+    }
+    for (auto* d : dir->directories) {
+        if (d->getName() == name) return d;
+    }
+    return nullptr;
+}
+
+FileListIndex::File* FileListIndex::childFile(
+        const Directory* dir, std::string_view name) const {
+    auto it = m_children.find(dir);
+    if (it != m_children.end()) {
+        auto c = it->second.files.find(name);
+        return c == it->second.files.end() ? nullptr : c->second;
+    }
+    for (auto* f : dir->files) {
+        if (f->getName() == name) return f;
+    }
+    return nullptr;
+}
+
+FileListIndex::Directory* FileListIndex::findDir(std::string_view path) const {
+    Directory* dir = m_root;
+    size_t i = 0;
+    while (dir && i < path.size()) {
+        size_t j = path.find('/', i);
+        if (j == std::string_view::npos) j = path.size();
+        // Empty components ("//", leading or trailing '/') are skipped
+        if (j > i) dir = childDir(dir, path.substr(i, j - i));
+        i = j + 1;
+    }
+    return dir;
+}
+
+FileListIndex::File* FileListIndex::findFile(std::string_view path) const {
+    size_t slash = path.rfind('/');
+    std::string_view name = slash == std::string_view::npos
+        ? path : path.substr(slash + 1);
+    if (name.empty()) return nullptr;
+
+    Directory* dir = slash == std::string_view::npos
+        ? m_root : findDir(path.substr(0, slash));
+    return dir ? childFile(dir, name) : nullptr;
+}
+
+} // namespace eiskaltdcpp_py
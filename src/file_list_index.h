@@ -0,0 +1,106 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * file_list_index.h — Hashed path lookup for an opened file list.
+ *
+ * DirectoryListing keeps each directory's children in plain vectors, so
+ * resolving "/a/b/c.iso" by name is a linear scan per path component —
+ * O(n) per level in directories with 100k entries.  FileListIndex is
+ * built once, right after parsing, and gives every large directory a
+ * name → child hash map; lookups are then O(depth).  Directories with
+ * only a handful of children are left unindexed and scanned, which is
+ * as fast and costs no memory.
+ *
+ * Keys are string_views of the listing's own node names, so the index
+ * holds no string copies.  It is valid for as long as the listing it was
+ * built from, which must not be modified afterwards.
+ */
+
+#pragma once
+
+#include "dcpp_compat.h"  // must precede dcpp headers
+
+#include <dcpp/DirectoryListing.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "file_list_search.h"
+#include "types.h"
+
+namespace eiskaltdcpp_py {
+
+class FileListIndex {
+public:
+    using Directory = dcpp::DirectoryListing::Directory;
+    using File = dcpp::DirectoryListing::File;
+
+    /// Index the tree under root (may be null for an empty listing).
+    explicit FileListIndex(Directory* root);
+
+    /// Directory at a '/'-separated path; "" and "/" are the root.
+    /// Returns nullptr if any component is missing.
+    Directory* findDir(std::string_view path) const;
+
+    /// File at a '/'-separated path.  Returns nullptr if missing.
+    File* findFile(std::string_view path) const;
+
+    /// Child lookup within one directory.
+    Directory* childDir(const Directory* dir, std::string_view name) const;
+    File* childFile(const Directory* dir, std::string_view name) const;
+
+    Directory* root() const { return m_root; }
+
+    /// Directories with fewer children than this are scanned, not hashed.
+    static const size_t MIN_INDEXED_CHILDREN = 16;
+
+private:
+    struct Children {
+        std::unordered_map<std::string_view, Directory*> dirs;
+        std::unordered_map<std::string_view, File*> files;
+    };
+
+    void build(Directory* dir);
+
+    Directory* m_root;
+    std::unordered_map<const Directory*, Children> m_children;
+};
+
+/// Listing entries for one child; a file's TTH is copied raw.
+inline FileListEntry dirEntry(FileListIndex::Directory* d) {
+    FileListEntry entry;
+    entry.name = d->getName();
+    entry.isDirectory = true;
+    entry.size = d->getTotalSize();
+    return entry;
+}
+
+inline FileListEntry fileEntry(const FileListIndex::File* f) {
+    FileListEntry entry;
+    entry.name = f->getName();
+    entry.size = f->getSize();
+    memcpy(entry.rawTTH.data(), f->getTTH().data, entry.rawTTH.size());
+    entry.hasRawTTH = true;
+    return entry;
+}
+
+/// An opened file list: the parsed listing plus its path and word
+/// indexes.  All are immutable once published in DCBridge::m_fileLists,
+/// so any number of threads may read them without a lock.
+struct OpenFileList {
+    explicit OpenFileList(std::shared_ptr<dcpp::DirectoryListing> l)
+        : listing(std::move(l)), index(listing->getRoot()),
+          words(listing->getRoot()) {}
+
+    std::shared_ptr<dcpp::DirectoryListing> listing;
+    FileListIndex index;
+    FileListSearchIndex words;
+};
+
+} // namespace eiskaltdcpp_py
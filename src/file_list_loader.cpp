@@ -0,0 +1,110 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * file_list_loader.cpp — Keyed worker pool for background list parsing.
+ */
+
+#include "file_list_loader.h"
+
+#include <algorithm>
+
+namespace eiskaltdcpp_py {
+
+size_t FileListLoader::limit() const {
+    if (m_threads > 0) return m_threads;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void FileListLoader::setThreads(size_t n) {
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_threads = n;
+    }
+    // Parked workers re-check the limit and retire if over it
+    m_cv.notify_all();
+}
+
+size_t FileListLoader::threads() const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return limit();
+}
+
+bool FileListLoader::submit(const std::string& key, Job job) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_stopping || !m_keys.insert(key).second) return false;
+
+    m_jobs.emplace_back(key, std::move(job));
+    if (m_idle > 0) {
+        m_cv.notify_one();
+    } else if (m_live < limit()) {
+        ++m_live;
+        m_workers.emplace_back(&FileListLoader::run, this);
+    }
+    return true;
+}
+
+bool FileListLoader::busy(const std::string& key) const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_keys.count(key) != 0;
+}
+
+size_t FileListLoader::pending() const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_keys.size();
+}
+
+void FileListLoader::run() {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    for (;;) {
+        if (m_stopping || m_live > limit()) break;
+        if (m_jobs.empty()) {
+            ++m_idle;
+            m_cv.wait(lk);
+            --m_idle;
+            continue;
+        }
+
+        std::pair<std::string, Job> item = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lk.unlock();
+        try {
+            item.second();
+        } catch (...) {
+            // A job reports its own failure; never let one kill the worker
+        }
+        lk.lock();
+        m_keys.erase(item.first);
+    }
+    --m_live;
+}
+
+void FileListLoader::stop() {
+    std::vector<std::thread> workers;
+    std::deque<std::pair<std::string, Job>> dropped;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_stopping = true;
+        for (const auto& item : m_jobs) m_keys.erase(item.first);
+        dropped.swap(m_jobs);
+        workers.swap(m_workers);
+    }
+    m_cv.notify_all();
+
+    for (auto& t : workers) {
+        // stop() from inside a job (e.g. a load callback shutting the
+        // client down) cannot join its own thread
+        if (t.get_id() == std::this_thread::get_id()) {
+            t.detach();
+        } else if (t.joinable()) {
+            t.join();
+        }
+    }
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_stopping = false;
+}
+
+} // namespace eiskaltdcpp_py
@@ -0,0 +1,80 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * file_list_loader.h — Worker pool for DCBridge::openFileListAsync().
+ * DCBridge keeps a second instance for the helpers of searchFileLists().
+ *
+ * Decompressing and parsing a large files.xml.bz2 is pure CPU work that
+ * touches no bridge state until the finished listing is published, so it
+ * runs here instead of on the caller's thread.  Jobs are keyed by file
+ * list id: submitting an id that is already queued or running is a no-op,
+ * so bulk-opening the same list twice parses it once.
+ *
+ * Workers are started lazily (never more than there are jobs waiting)
+ * and then stay parked on the condition variable until stop().
+ *
+ * m_mutex is a leaf lock: jobs run with it released.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace eiskaltdcpp_py {
+
+class FileListLoader {
+public:
+    using Job = std::function<void()>;
+
+    FileListLoader() = default;
+    ~FileListLoader() { stop(); }
+    FileListLoader(const FileListLoader&) = delete;
+    FileListLoader& operator=(const FileListLoader&) = delete;
+
+    /// Maximum concurrent loads; 0 means one per hardware thread.
+    /// Lowering it retires surplus workers as they finish their job.
+    void setThreads(size_t n);
+    size_t threads() const;
+
+    /// Queue job under key.  Returns false (and drops job) if key is
+    /// already queued or running.
+    bool submit(const std::string& key, Job job);
+
+    /// Whether key is queued or running.
+    bool busy(const std::string& key) const;
+
+    /// Jobs queued or running.
+    size_t pending() const;
+
+    /// Discard queued jobs and join every worker.  Running jobs finish
+    /// first.  The pool accepts work again afterwards.
+    void stop();
+
+private:
+    void run();
+    size_t limit() const;   // m_mutex held
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::pair<std::string, Job>> m_jobs;
+    std::unordered_set<std::string> m_keys;     // queued + running
+    std::vector<std::thread> m_workers;
+    size_t m_threads = 0;       // configured limit (0 = hardware)
+    size_t m_live = 0;          // workers not yet retired
+    size_t m_idle = 0;          // workers parked in wait()
+    bool m_stopping = false;
+};
+
+} // namespace eiskaltdcpp_py
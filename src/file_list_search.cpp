@@ -0,0 +1,311 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * file_list_search.cpp — Word postings, prefix lookup and filters.
+ */
+
+#include "file_list_search.h"
+#include "tth_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+
+namespace eiskaltdcpp_py {
+
+// Extensions per search() file type, as the core's ShareManager sorts
+// them
+static const std::unordered_map<std::string, int>& extensionTypes() {
+    static const std::unordered_map<std::string, int> types = [] {
+        static const char* const lists[6][16] = {
+            {"mp3", "mp2", "mid", "wav", "ogg", "wma", "flac", "ape",
+             "aac", "m4a", "opus", nullptr},
+            {"zip", "ace", "rar", "arj", "hqx", "lha", "sea", "tar",
+             "tgz", "z", "bz2", "gz", "7z", "xz", nullptr},
+            {"htm", "html", "doc", "docx", "txt", "nfo", "pdf", "rtf",
+             "xls", "ppt", "odt", "ods", "odp", "epub", nullptr},
+            {"exe", "com", "bat", "msi", nullptr},
+            {"jpg", "jpeg", "gif", "png", "eps", "img", "pct", "psp",
+             "pic", "tif", "tiff", "rle", "bmp", "pcx", "webp", nullptr},
+            {"mpg", "mpeg", "mov", "asf", "avi", "pxp", "wmv", "ogm",
+             "mkv", "m1v", "m2v", "mpe", "mp4", "divx", "webm", nullptr},
+        };
+        std::unordered_map<std::string, int> m;
+        for (int t = 0; t < 6; ++t) {
+            for (const char* const* e = lists[t]; *e; ++e) m.emplace(*e, t + 1);
+        }
+        return m;
+    }();
+    return types;
+}
+
+static bool isWordByte(unsigned char c) {
+    return c >= 0x80 || (c >= '0' && c <= '9') ||
+           (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static char lowerAscii(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+void FileListSearchIndex::tokenize(const std::string& text,
+                                   std::vector<std::string>& out) {
+    size_t i = 0;
+    while (i < text.size()) {
+        while (i < text.size() &&
+               !isWordByte(static_cast<unsigned char>(text[i]))) ++i;
+        size_t j = i;
+        while (j < text.size() &&
+               isWordByte(static_cast<unsigned char>(text[j]))) ++j;
+        if (j > i) {
+            out.emplace_back(text, i, j - i);
+            for (char& c : out.back()) c = lowerAscii(c);
+        }
+        i = j;
+    }
+}
+
+int FileListSearchIndex::fileTypeOf(const std::string& name) {
+    size_t dot = name.rfind('.');
+    if (dot == std::string::npos || dot + 1 == name.size()) return 0;
+    if (name.size() - dot > 8) return 0;    // no extension is that long
+    std::string ext(name, dot + 1);
+    for (char& c : ext) c = lowerAscii(c);
+    const auto& types = extensionTypes();
+    auto it = types.find(ext);
+    return it == types.end() ? 0 : it->second;
+}
+
+bool FileListSearchIndex::parseQuery(const std::string& text, int fileType,
+                                     int sizeMode, int64_t size,
+                                     Query& out) {
+    out = Query();
+    out.fileType = fileType;
+    out.sizeMode = sizeMode;
+    out.size = size;
+    if (fileType == 8) {
+        std::string tth = text.compare(0, 4, "TTH:") == 0
+            ? text.substr(4) : text;
+        return TTHIndex::decodeTTH(tth, out.tth);
+    }
+    tokenize(text, out.terms);
+    // Dedupe, so "a a" costs one lookup
+    std::sort(out.terms.begin(), out.terms.end());
+    out.terms.erase(std::unique(out.terms.begin(), out.terms.end()),
+                    out.terms.end());
+    return !out.terms.empty() || fileType != 0;
+}
+
+FileListSearchIndex::FileListSearchIndex(Directory* root) {
+    if (!root) return;
+
+    // Pre-order, as FileListWalker hands entries out: a directory's
+    // files, then each subdirectory followed by its subtree
+    struct Frame {
+        Directory* dir;
+        uint32_t node;
+        size_t nextDir;
+    };
+    std::unordered_map<std::string, std::vector<uint32_t>> postings;
+    std::vector<std::string> words;
+    auto addNode = [&](Node n, const std::string& name) {
+        uint32_t id = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(n);
+        words.clear();
+        tokenize(name, words);
+        for (auto& w : words) {
+            auto& list = postings[std::move(w)];
+            if (list.empty() || list.back() != id) list.push_back(id);
+        }
+        return id;
+    };
+    auto addFiles = [&](Directory* dir, uint32_t parent) {
+        for (auto* f : dir->files) {
+            Node n;
+            n.file = f;
+            n.parent = parent;
+            n.type = static_cast<uint8_t>(fileTypeOf(f->getName()));
+            n.size = f->getSize();
+            uint32_t id = addNode(n, f->getName());
+            std::array<uint8_t, 24> tth;
+            memcpy(tth.data(), f->getTTH().data, tth.size());
+            m_tths.emplace_back(tth, id);
+        }
+    };
+
+    addFiles(root, NO_PARENT);
+    std::vector<Frame> stack{{root, NO_PARENT, 0}};
+    while (!stack.empty()) {
+        Frame& top = stack.back();
+        if (top.nextDir == top.dir->directories.size()) {
+            stack.pop_back();
+            continue;
+        }
+        Directory* child = top.dir->directories[top.nextDir++];
+        Node n;
+        n.dir = child;
+        n.parent = top.node;
+        n.type = TYPE_DIRECTORY;
+        uint32_t id = addNode(n, child->getName());
+        addFiles(child, id);
+        stack.push_back({child, id, 0});     // top is invalidated
+    }
+
+    // Children come after their parent, so one backwards pass totals
+    // every directory's size
+    for (size_t i = m_nodes.size(); i-- > 0;) {
+        if (m_nodes[i].parent != NO_PARENT) {
+            m_nodes[m_nodes[i].parent].size += m_nodes[i].size;
+        }
+    }
+
+    m_words.reserve(postings.size());
+    for (auto& p : postings) m_words.push_back(p.first);
+    std::sort(m_words.begin(), m_words.end());
+    m_wordStart.reserve(m_words.size() + 1);
+    size_t total = 0;
+    for (auto& p : postings) total += p.second.size();
+    m_postings.reserve(total);
+    for (const auto& w : m_words) {
+        m_wordStart.push_back(static_cast<uint32_t>(m_postings.size()));
+        auto& list = postings[w];
+        m_postings.insert(m_postings.end(), list.begin(), list.end());
+        std::vector<uint32_t>().swap(list);
+    }
+    m_wordStart.push_back(static_cast<uint32_t>(m_postings.size()));
+
+    std::sort(m_tths.begin(), m_tths.end());
+    m_tths.shrink_to_fit();
+    m_nodes.shrink_to_fit();
+}
+
+std::vector<uint32_t> FileListSearchIndex::termNodes(
+        const std::string& term) const {
+    std::vector<uint32_t> out;
+    auto it = std::lower_bound(m_words.begin(), m_words.end(), term);
+    size_t first = static_cast<size_t>(it - m_words.begin());
+    size_t last = first;
+    while (last < m_words.size() &&
+           m_words[last].compare(0, term.size(), term) == 0) ++last;
+    if (first == last) return out;
+
+    out.assign(m_postings.begin() + m_wordStart[first],
+               m_postings.begin() + m_wordStart[last]);
+    if (last - first > 1) {
+        // Several words share the prefix; their lists interleave
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+    return out;
+}
+
+bool FileListSearchIndex::passesFilters(const Node& n, const Query& q) const {
+    if (q.fileType == TYPE_DIRECTORY) {
+        if (!n.dir) return false;
+    } else if (q.fileType > 0 && q.fileType < TYPE_DIRECTORY) {
+        if (n.type != q.fileType) return false;
+    }
+    if (q.size > 0) {
+        if (q.sizeMode == 1 && n.size < q.size) return false;
+        if (q.sizeMode == 2 && n.size > q.size) return false;
+    }
+    return true;
+}
+
+std::vector<uint32_t> FileListSearchIndex::match(const Query& q) const {
+    std::vector<uint32_t> result;
+
+    if (q.fileType == 8) {
+        auto lo = std::lower_bound(
+            m_tths.begin(), m_tths.end(), q.tth,
+            [](const std::pair<std::array<uint8_t, 24>, uint32_t>& e,
+               const std::array<uint8_t, 24>& t) { return e.first < t; });
+        for (auto it = lo; it != m_tths.end() && it->first == q.tth; ++it) {
+            if (passesFilters(m_nodes[it->second], q)) {
+                result.push_back(it->second);
+            }
+        }
+        return result;  // equal TTHs are sorted by node already
+    }
+
+    if (q.terms.empty()) {
+        for (uint32_t i = 0; i < m_nodes.size(); ++i) {
+            if (passesFilters(m_nodes[i], q)) result.push_back(i);
+        }
+        return result;
+    }
+
+    // Intersect from the rarest term up
+    std::vector<std::vector<uint32_t>> sets;
+    sets.reserve(q.terms.size());
+    for (const auto& term : q.terms) {
+        sets.push_back(termNodes(term));
+        if (sets.back().empty()) return result;
+    }
+    std::sort(sets.begin(), sets.end(),
+              [](const std::vector<uint32_t>& a,
+                 const std::vector<uint32_t>& b) {
+                  return a.size() < b.size();
+              });
+    result.swap(sets[0]);
+    std::vector<uint32_t> next;
+    for (size_t i = 1; i < sets.size() && !result.empty(); ++i) {
+        next.clear();
+        std::set_intersection(result.begin(), result.end(),
+                              sets[i].begin(), sets[i].end(),
+                              std::back_inserter(next));
+        result.swap(next);
+    }
+    result.erase(std::remove_if(result.begin(), result.end(),
+                                [&](uint32_t id) {
+                                    return !passesFilters(m_nodes[id], q);
+                                }),
+                 result.end());
+    return result;
+}
+
+FileListEntry FileListSearchIndex::entry(uint32_t node) const {
+    const Node& n = m_nodes[node];
+    FileListEntry e;
+    e.size = n.size;
+    if (n.dir) {
+        e.name = n.dir->getName();
+        e.isDirectory = true;
+    } else {
+        e.name = n.file->getName();
+        memcpy(e.rawTTH.data(), n.file->getTTH().data, e.rawTTH.size());
+        e.hasRawTTH = true;
+    }
+
+    std::vector<const std::string*> parts;
+    for (uint32_t p = n.parent; p != NO_PARENT; p = m_nodes[p].parent) {
+        parts.push_back(&m_nodes[p].dir->getName());
+    }
+    size_t len = e.name.size();
+    for (auto* part : parts) len += part->size() + 1;
+    e.path.reserve(len);
+    for (auto it = parts.rbegin(); it != parts.rend(); ++it) {
+        e.path += **it;
+        e.path += '/';
+    }
+    e.path += e.name;
+    return e;
+}
+
+size_t FileListSearchIndex::memoryUsage() const {
+    size_t bytes = m_nodes.capacity() * sizeof(Node) +
+                   m_words.capacity() * sizeof(std::string) +
+                   m_wordStart.capacity() * sizeof(uint32_t) +
+                   m_postings.capacity() * sizeof(uint32_t) +
+                   m_tths.capacity() * sizeof(m_tths[0]);
+    for (const auto& w : m_words) {
+        if (w.capacity() > 15) bytes += w.capacity() + 1;
+    }
+    return bytes;
+}
+
+} // namespace eiskaltdcpp_py
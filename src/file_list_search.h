@@ -0,0 +1,107 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * file_list_search.h — Word index over one opened file list.
+ *
+ * Built once per list, right after FileListIndex, on the thread that
+ * parsed it.  Every file and directory becomes a numbered node, in
+ * pre-order, with its parent, size and file type.  Names are split into
+ * lowercased words, and each word maps to the sorted nodes containing
+ * it.  The postings are flat CSR arrays: one vector of words, one of
+ * offsets, one of node ids.
+ *
+ * A query term matches every word it is a prefix of, so "beat" finds
+ * "Beatles"; a node matches when all terms do.  Type and size filters
+ * mean the same as for DCBridge::search().  TTH queries (type 8) use a
+ * sorted TTH table instead of the words.
+ *
+ * Paths are put together from the parent links only for the hits handed
+ * out.  Like FileListIndex, the index points into the listing and is
+ * immutable, so concurrent queries need no lock.
+ */
+
+#pragma once
+
+#include "dcpp_compat.h"  // must precede dcpp headers
+
+#include <dcpp/DirectoryListing.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+
+namespace eiskaltdcpp_py {
+
+class FileListSearchIndex {
+public:
+    using Directory = dcpp::DirectoryListing::Directory;
+    using File = dcpp::DirectoryListing::File;
+
+    /// A parsed query, shared by every list it is run against.
+    struct Query {
+        std::vector<std::string> terms;     // lowercased words
+        int fileType = 0;                   // as DCBridge::search()
+        int sizeMode = 0;
+        int64_t size = 0;
+        std::array<uint8_t, 24> tth{};      // fileType 8
+    };
+
+    /// Parse search() arguments.  Returns false if the query can match
+    /// nothing: no terms and no type filter, or a malformed TTH.
+    static bool parseQuery(const std::string& text, int fileType,
+                           int sizeMode, int64_t size, Query& out);
+
+    /// Index the tree under root (may be null for an empty listing).
+    explicit FileListSearchIndex(Directory* root);
+
+    /// Matching nodes in listing order.
+    std::vector<uint32_t> match(const Query& q) const;
+
+    /// Entry for a node, with its path from the list root.
+    FileListEntry entry(uint32_t node) const;
+
+    size_t nodeCount() const { return m_nodes.size(); }
+
+    /// Approximate heap bytes held.
+    size_t memoryUsage() const;
+
+    /// Split text into lowercased words (ASCII letters and digits, and
+    /// any non-ASCII byte, so UTF-8 words stay whole).
+    static void tokenize(const std::string& text,
+                         std::vector<std::string>& out);
+
+    /// search() file type (1-6) for a file name's extension, or 0.
+    static int fileTypeOf(const std::string& name);
+
+private:
+    static const uint32_t NO_PARENT = UINT32_MAX;
+    static const uint8_t TYPE_DIRECTORY = 7;
+
+    struct Node {
+        Directory* dir = nullptr;       // exactly one of dir / file
+        File* file = nullptr;
+        uint32_t parent = NO_PARENT;    // directory node, or root
+        uint8_t type = 0;               // fileTypeOf(), or TYPE_DIRECTORY
+        int64_t size = 0;
+    };
+
+    bool passesFilters(const Node& n, const Query& q) const;
+    /// Sorted, unique nodes with a word that term is a prefix of.
+    std::vector<uint32_t> termNodes(const std::string& term) const;
+
+    std::vector<Node> m_nodes;
+    std::vector<std::string> m_words;       // sorted
+    std::vector<uint32_t> m_wordStart;      // m_words.size() + 1 offsets
+    std::vector<uint32_t> m_postings;       // into m_nodes, sorted per word
+    // (TTH, node) sorted by TTH, for type-8 lookups
+    std::vector<std::pair<std::array<uint8_t, 24>, uint32_t>> m_tths;
+};
+
+} // namespace eiskaltdcpp_py
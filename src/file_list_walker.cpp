@@ -0,0 +1,99 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * file_list_walker.cpp — Resumable pre-order walk with an explicit stack.
+ */
+
+#include "file_list_walker.h"
+#include "file_list_index.h"
+
+#include <utility>
+
+namespace eiskaltdcpp_py {
+
+struct FileListWalker::State {
+    struct Frame {
+        FileListIndex::Directory* dir;
+        std::string prefix;     // path of dir with a trailing '/', or ""
+        size_t nextFile = 0;
+        size_t nextDir = 0;
+    };
+
+    std::shared_ptr<const OpenFileList> list;
+    std::vector<Frame> stack;
+    uint64_t visited = 0;
+};
+
+// Root path as walk prefix: components joined by '/', with a trailing
+// '/' unless it is the root itself
+static std::string rootPrefix(const std::string& root) {
+    std::string prefix;
+    size_t i = 0;
+    while (i < root.size()) {
+        size_t j = root.find('/', i);
+        if (j == std::string::npos) j = root.size();
+        if (j > i) {
+            prefix.append(root, i, j - i);
+            prefix += '/';
+        }
+        i = j + 1;
+    }
+    return prefix;
+}
+
+FileListWalker::FileListWalker(std::shared_ptr<const OpenFileList> list,
+                               const std::string& root)
+    : m_state(std::make_shared<State>()) {
+    if (!list) return;
+    auto* dir = list->index.findDir(root);
+    if (!dir) return;
+    m_state->list = std::move(list);
+    m_state->stack.push_back({dir, rootPrefix(root)});
+}
+
+std::vector<FileListEntry> FileListWalker::next(size_t maxEntries) {
+    std::vector<FileListEntry> out;
+    if (!m_state) return out;
+    auto& stack = m_state->stack;
+    if (maxEntries > 0) out.reserve(maxEntries);
+
+    while (!stack.empty() && (maxEntries == 0 || out.size() < maxEntries)) {
+        State::Frame& top = stack.back();
+        const auto* dir = top.dir;
+
+        if (top.nextFile < dir->files.size()) {
+            FileListEntry entry = fileEntry(dir->files[top.nextFile++]);
+            entry.path = top.prefix + entry.name;
+            out.push_back(std::move(entry));
+            continue;
+        }
+        if (top.nextDir < dir->directories.size()) {
+            auto* child = dir->directories[top.nextDir++];
+            FileListEntry entry = dirEntry(child);
+            entry.path = top.prefix + entry.name;
+            std::string prefix = entry.path + '/';
+            out.push_back(std::move(entry));
+            // top is invalidated by the push
+            stack.push_back({child, std::move(prefix)});
+            continue;
+        }
+        stack.pop_back();
+    }
+
+    if (stack.empty()) m_state->list.reset();
+    m_state->visited += out.size();
+    return out;
+}
+
+bool FileListWalker::done() const {
+    return !m_state || m_state->stack.empty();
+}
+
+uint64_t FileListWalker::visited() const {
+    return m_state ? m_state->visited : 0;
+}
+
+} // namespace eiskaltdcpp_py
@@ -0,0 +1,67 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * file_list_walker.h — Depth-first cursor over an opened file list.
+ *
+ * Crawling a list one browseFileList() call per directory costs a
+ * SWIG round trip and a full copy per node.  A walker keeps its place
+ * in the tree on the C++ side and hands the listing out in chunks of
+ * entries carrying their full path, so Python pays one call per chunk
+ * however the tree is shaped.
+ *
+ * Order is pre-order: a directory's files, then each subdirectory's
+ * entry followed by everything under it.  The walker holds the opened
+ * list alive, so closeFileList() during a walk is harmless.  Copies of
+ * a walker share one position; a walker is not safe to advance from
+ * two threads at once.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base32.h"
+#include "types.h"
+
+namespace eiskaltdcpp_py {
+
+struct OpenFileList;
+
+/// Fill entry.tth from the raw TTH, if it has not been already.
+inline void fillTTH(FileListEntry& entry) {
+    if (entry.hasRawTTH && entry.tth.empty()) {
+        entry.tth = base32Encode(entry.rawTTH.data(), entry.rawTTH.size());
+    }
+}
+
+class FileListWalker {
+public:
+    /// An exhausted walker.
+    FileListWalker() = default;
+
+    /// Walk the directory at root (as for FileListIndex::findDir).  An
+    /// unknown root gives an exhausted walker.
+    FileListWalker(std::shared_ptr<const OpenFileList> list,
+                   const std::string& root);
+
+    /// Up to maxEntries more entries (0 = all that remain).  Empty once
+    /// the walk is done.
+    std::vector<FileListEntry> next(size_t maxEntries);
+
+    bool done() const;
+
+    /// Entries handed out so far.
+    uint64_t visited() const;
+
+private:
+    struct State;
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace eiskaltdcpp_py
@@ -0,0 +1,144 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * metrics.h — Always-on counters and latency histograms for hot paths.
+ *
+ * Everything is a relaxed atomic, so recording costs a few uncontended
+ * increments and never takes a lock.  Histograms use power-of-two
+ * microsecond buckets (see LatencyStats), which a bit scan finds.
+ *
+ * Lock wait times come from lockCounted(): it tries the lock first and
+ * only reads the clock when that fails, so an uncontended acquisition
+ * costs only the counter increment.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+#include "types.h"
+
+namespace eiskaltdcpp_py {
+
+inline uint64_t metricsNowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+class LatencyHistogram {
+public:
+    void record(uint64_t ns) {
+        uint64_t us = ns / 1000;
+        int bucket = us ? 64 - __builtin_clzll(us) : 0;
+        if (bucket >= LatencyStats::BUCKET_COUNT) {
+            bucket = LatencyStats::BUCKET_COUNT - 1;
+        }
+        m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sumNs.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t max = m_maxNs.load(std::memory_order_relaxed);
+        while (ns > max && !m_maxNs.compare_exchange_weak(
+                   max, ns, std::memory_order_relaxed)) {}
+    }
+
+    LatencyStats snapshot() const {
+        LatencyStats st;
+        st.count = m_count.load(std::memory_order_relaxed);
+        st.sumNs = m_sumNs.load(std::memory_order_relaxed);
+        st.maxNs = m_maxNs.load(std::memory_order_relaxed);
+        st.buckets.reserve(LatencyStats::BUCKET_COUNT);
+        for (const auto& b : m_buckets) {
+            st.buckets.push_back(b.load(std::memory_order_relaxed));
+        }
+        return st;
+    }
+
+private:
+    std::atomic<uint64_t> m_buckets[LatencyStats::BUCKET_COUNT] = {};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sumNs{0};
+    std::atomic<uint64_t> m_maxNs{0};
+};
+
+/// Contention counters for one mutex; see lockCounted().
+class LockCounters {
+public:
+    explicit LockCounters(const char* name) : m_name(name) {}
+
+    void acquired() {
+        m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+    void waited(uint64_t ns) {
+        m_contended.fetch_add(1, std::memory_order_relaxed);
+        m_wait.record(ns);
+    }
+
+    LockMetrics snapshot() const {
+        LockMetrics st;
+        st.name = m_name;
+        st.acquisitions = m_acquisitions.load(std::memory_order_relaxed);
+        st.contended = m_contended.load(std::memory_order_relaxed);
+        st.wait = m_wait.snapshot();
+        return st;
+    }
+
+private:
+    const char* m_name;
+    std::atomic<uint64_t> m_acquisitions{0};
+    std::atomic<uint64_t> m_contended{0};
+    LatencyHistogram m_wait;
+};
+
+/// Lock m, recording the acquisition and, if it had to wait, for how long.
+template <typename Mutex>
+std::unique_lock<Mutex> lockCounted(Mutex& m, LockCounters& counters) {
+    std::unique_lock<Mutex> lock(m, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        uint64_t t0 = metricsNowNs();
+        lock.lock();
+        counters.waited(metricsNowNs() - t0);
+    }
+    counters.acquired();
+    return lock;
+}
+
+/// lockCounted() for the shared side of a shared_mutex.
+template <typename Mutex>
+std::shared_lock<Mutex> lockCountedShared(Mutex& m, LockCounters& counters) {
+    std::shared_lock<Mutex> lock(m, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        uint64_t t0 = metricsNowNs();
+        lock.lock();
+        counters.waited(metricsNowNs() - t0);
+    }
+    counters.acquired();
+    return lock;
+}
+
+/// Times one callback invocation into a histogram.
+class CallbackTimer {
+public:
+    CallbackTimer(std::atomic<uint64_t>& calls, LatencyHistogram& latency)
+        : m_latency(latency), m_start(metricsNowNs()) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+    }
+    ~CallbackTimer() { m_latency.record(metricsNowNs() - m_start); }
+
+    CallbackTimer(const CallbackTimer&) = delete;
+    CallbackTimer& operator=(const CallbackTimer&) = delete;
+
+private:
+    LatencyHistogram& m_latency;
+    uint64_t m_start;
+};
+
+} // namespace eiskaltdcpp_py
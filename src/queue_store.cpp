@@ -0,0 +1,111 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * queue_store.cpp — Ordered queue mirror with revision-based deltas.
+ */
+
+#include "queue_store.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace eiskaltdcpp_py {
+
+static bool sameState(const QueueItemInfo& a, const QueueItemInfo& b) {
+    return a.size == b.size && a.downloadedBytes == b.downloadedBytes &&
+           a.priority == b.priority && a.sources == b.sources &&
+           a.onlineSources == b.onlineSources && a.status == b.status &&
+           a.tth == b.tth && a.filename == b.filename;
+}
+
+void QueueStore::upsert(QueueItemInfo info) {
+    auto it = m_items.find(info.target);
+    if (it == m_items.end()) {
+        std::string target = info.target;
+        it = m_items.emplace(std::move(target), Entry{}).first;
+    } else if (sameState(it->second.info, info)) {
+        // SourcesUpdated fires for every source change; only real
+        // differences should show up in a delta
+        return;
+    }
+    it->second.info = std::move(info);
+    it->second.rev = ++m_revision;
+}
+
+void QueueStore::logRemoval(const std::string& target) {
+    m_removals.push_back({++m_revision, target});
+    if (m_removals.size() > MAX_REMOVAL_LOG) {
+        m_logFloor = m_removals.front().revision;
+        m_removals.pop_front();
+    }
+}
+
+bool QueueStore::erase(const std::string& target) {
+    auto it = m_items.find(target);
+    if (it == m_items.end()) return false;
+    m_items.erase(it);
+    logRemoval(target);
+    return true;
+}
+
+void QueueStore::reset(std::vector<QueueItemInfo> items) {
+    m_items.clear();
+    m_removals.clear();
+    m_logFloor = ++m_revision;
+    for (auto& info : items) {
+        std::string target = info.target;
+        m_items[std::move(target)] = Entry{std::move(info), m_revision};
+    }
+}
+
+void QueueStore::clear() {
+    m_items.clear();
+    m_removals.clear();
+    m_logFloor = ++m_revision;
+}
+
+void QueueStore::appendAll(std::vector<QueueItemInfo>& out) const {
+    out.reserve(out.size() + m_items.size());
+    for (const auto& [target, e] : m_items) out.push_back(e.info);
+}
+
+void QueueStore::page(size_t offset, size_t limit, QueuePage& out) const {
+    out.revision = m_revision;
+    out.total = static_cast<int>(m_items.size());
+    out.items.clear();
+    if (offset >= m_items.size()) return;
+
+    size_t n = std::min(limit, m_items.size() - offset);
+    out.items.reserve(n);
+    auto it = std::next(m_items.begin(), static_cast<std::ptrdiff_t>(offset));
+    for (; n > 0; --n, ++it) out.items.push_back(it->second.info);
+}
+
+void QueueStore::changesSince(uint64_t sinceRevision,
+                              QueueChanges& out) const {
+    out.revision = m_revision;
+    out.fullResync = sinceRevision == 0 || sinceRevision < m_logFloor ||
+                     sinceRevision > m_revision;
+    out.updated.clear();
+    out.removed.clear();
+
+    if (out.fullResync) {
+        appendAll(out.updated);
+        return;
+    }
+    if (sinceRevision == m_revision) return;
+
+    // Removal log is in revision order — walk back from the newest entry
+    for (auto it = m_removals.rbegin();
+         it != m_removals.rend() && it->revision > sinceRevision; ++it) {
+        out.removed.push_back(it->target);
+    }
+    for (const auto& [target, e] : m_items) {
+        if (e.rev > sinceRevision) out.updated.push_back(e.info);
+    }
+}
+
+} // namespace eiskaltdcpp_py
@@ -0,0 +1,88 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * queue_store.h — Bridge-side mirror of the download queue.
+ *
+ * Kept current from QueueManagerListener events (Added / Removed /
+ * Moved / Finished / SourcesUpdated / StatusUpdated), so listQueue(),
+ * paging and delta queries never take QueueManager::lockQueue() and
+ * never stall download scheduling while a large queue is formatted.
+ *
+ * Entries are ordered by target, which gives pages a stable order.
+ * The revision / removal-log scheme is the same as UserStore's.
+ *
+ * Not thread-safe — callers hold DCBridge::m_queueMutex.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+namespace eiskaltdcpp_py {
+
+class QueueStore {
+public:
+    /// Insert or replace the entry for info.target.
+    void upsert(QueueItemInfo info);
+
+    /// Remove target; returns false if it was not present.
+    bool erase(const std::string& target);
+
+    /// Replace everything (initial snapshot).  Counts as one revision;
+    /// older revisions get a full resync.
+    void reset(std::vector<QueueItemInfo> items);
+
+    void clear();
+
+    size_t size() const { return m_items.size(); }
+    bool contains(const std::string& target) const {
+        return m_items.count(target) != 0;
+    }
+
+    /// Append every item to out, in target order.
+    void appendAll(std::vector<QueueItemInfo>& out) const;
+
+    /// Up to limit items starting at offset, in target order.
+    void page(size_t offset, size_t limit, QueuePage& out) const;
+
+    /// Monotonic revision, bumped by every change; never reset.
+    uint64_t revision() const { return m_revision; }
+
+    /// Items added or changed and targets removed after sinceRevision,
+    /// or everything (fullResync) when the removal log is too short.
+    void changesSince(uint64_t sinceRevision, QueueChanges& out) const;
+
+    /// How many removals are remembered for delta queries.
+    static const size_t MAX_REMOVAL_LOG = 8192;
+
+private:
+    struct Entry {
+        QueueItemInfo info;
+        uint64_t rev = 0;           // revision of last upsert
+    };
+
+    void logRemoval(const std::string& target);
+
+    std::map<std::string, Entry> m_items;   // target → entry
+
+    // Anything at or below m_logFloor has been trimmed from the removal
+    // log (or predates a reset / clear) and forces a full resync.
+    struct Removal {
+        uint64_t revision;
+        std::string target;
+    };
+    std::deque<Removal> m_removals;
+    uint64_t m_revision = 0;
+    uint64_t m_logFloor = 0;
+};
+
+} // namespace eiskaltdcpp_py
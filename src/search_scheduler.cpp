@@ -0,0 +1,221 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * search_scheduler.cpp — Priority order, hub intervals and TTH merging.
+ */
+
+#include "search_scheduler.h"
+
+#include <algorithm>
+
+namespace eiskaltdcpp_py {
+
+std::string SearchScheduler::tthKey(const Request& req) {
+    if (req.fileType != 8) return std::string();
+    std::string key = req.query.compare(0, 4, "TTH:") == 0
+        ? req.query.substr(4) : req.query;
+    for (char& c : key) {
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+    }
+    return key;
+}
+
+std::string SearchScheduler::enqueue(Request req,
+                                     const std::vector<std::string>& hubs,
+                                     uint64_t nowMs) {
+    if (hubs.empty()) return std::string();
+
+    std::string tth = tthKey(req);
+    if (!tth.empty()) {
+        for (auto it = m_recentTTH.begin(); it != m_recentTTH.end();) {
+            if (nowMs - it->second.sentAt >= RECENT_TTH_MS) {
+                it = m_recentTTH.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        auto recent = m_recentTTH.find(tth);
+        if (recent != m_recentTTH.end() &&
+            std::all_of(hubs.begin(), hubs.end(),
+                        [&](const std::string& h) {
+                            return recent->second.hubs.count(h) != 0;
+                        })) {
+            return recent->second.token;
+        }
+
+        auto same = m_pendingTTH.find(tth);
+        if (same != m_pendingTTH.end()) {
+            auto keyIt = m_byToken.find(same->second);
+            auto it = m_entries.find(keyIt->second);
+            Entry& e = it->second;
+            for (const auto& h : hubs) {
+                if (!e.sentTo.count(h)) e.hubs.insert(h);
+            }
+            if (req.priority > e.request.priority) {
+                // Re-key under the higher priority, keeping its place
+                // among searches queued before it
+                Key key(-req.priority, it->first.second);
+                e.request.priority = req.priority;
+                auto node = m_entries.extract(it);
+                node.key() = key;
+                m_entries.insert(std::move(node));
+                keyIt->second = key;
+            }
+            return same->second;
+        }
+    }
+
+    Key key(-req.priority, m_nextSeq++);
+    Entry e;
+    e.hubs.insert(hubs.begin(), hubs.end());
+    e.queuedAt = nowMs;
+    e.request = std::move(req);
+    std::string token = e.request.token;
+    m_byToken[token] = key;
+    if (!tth.empty()) m_pendingTTH[tth] = token;
+    m_entries.emplace(key, std::move(e));
+    return token;
+}
+
+bool SearchScheduler::cancel(const std::string& token) {
+    auto keyIt = m_byToken.find(token);
+    if (keyIt == m_byToken.end()) return false;
+    erase(m_entries.find(keyIt->second));
+    return true;
+}
+
+std::map<SearchScheduler::Key, SearchScheduler::Entry>::iterator
+SearchScheduler::erase(std::map<Key, Entry>::iterator it) {
+    const Request& req = it->second.request;
+    std::string tth = tthKey(req);
+    if (!tth.empty()) {
+        auto p = m_pendingTTH.find(tth);
+        if (p != m_pendingTTH.end() && p->second == req.token) {
+            m_pendingTTH.erase(p);
+        }
+    }
+    m_byToken.erase(req.token);
+    return m_entries.erase(it);
+}
+
+std::vector<SearchScheduler::Dispatch> SearchScheduler::due(
+        uint64_t nowMs,
+        const std::unordered_set<std::string>& known,
+        const std::unordered_set<std::string>& connected) {
+    std::vector<Dispatch> out;
+    std::unordered_set<std::string> free;
+    for (const auto& h : connected) {
+        if (ready(h, nowMs)) free.insert(h);
+    }
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        Entry& e = it->second;
+        Dispatch d;
+        for (auto h = e.hubs.begin(); h != e.hubs.end();) {
+            if (!known.count(*h)) {
+                h = e.hubs.erase(h);
+            } else if (free.count(*h)) {
+                d.hubs.push_back(*h);
+                h = e.hubs.erase(h);
+            } else {
+                ++h;
+            }
+        }
+
+        if (!d.hubs.empty()) {
+            std::sort(d.hubs.begin(), d.hubs.end());
+            for (const auto& h : d.hubs) {
+                free.erase(h);
+                e.sentTo.insert(h);
+                markSent(h, nowMs);
+            }
+            std::string tth = tthKey(e.request);
+            if (!tth.empty()) {
+                RecentTTH& r = m_recentTTH[tth];
+                if (r.token != e.request.token) {
+                    r.token = e.request.token;
+                    r.hubs.clear();
+                }
+                r.hubs.insert(d.hubs.begin(), d.hubs.end());
+                r.sentAt = nowMs;
+            }
+            d.request = e.request;
+            out.push_back(std::move(d));
+        }
+
+        if (e.hubs.empty()) {
+            it = erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return out;
+}
+
+void SearchScheduler::noteSent(const std::vector<std::string>& hubs,
+                               uint64_t nowMs) {
+    for (const auto& h : hubs) markSent(h, nowMs);
+}
+
+void SearchScheduler::noteFlood(const std::string& hubUrl, uint64_t nowMs) {
+    HubState& st = m_hubState[hubUrl];
+    st.backoff = std::min(st.backoff + 1, MAX_BACKOFF);
+    st.cleanSends = 0;
+    // Restart the clock: the hub has just seen (and refused) a search
+    st.lastSent = nowMs;
+    st.sent = true;
+}
+
+uint64_t SearchScheduler::hubInterval(const std::string& hubUrl) const {
+    auto it = m_hubState.find(hubUrl);
+    int backoff = it == m_hubState.end() ? 0 : it->second.backoff;
+    return m_intervalMs << backoff;
+}
+
+bool SearchScheduler::ready(const std::string& hubUrl, uint64_t nowMs) const {
+    auto it = m_hubState.find(hubUrl);
+    if (it == m_hubState.end() || !it->second.sent) return true;
+    return nowMs - it->second.lastSent >= hubInterval(hubUrl);
+}
+
+void SearchScheduler::markSent(const std::string& hubUrl, uint64_t nowMs) {
+    HubState& st = m_hubState[hubUrl];
+    st.lastSent = nowMs;
+    st.sent = true;
+    if (st.backoff > 0 && ++st.cleanSends >= CLEAN_SENDS_TO_EASE) {
+        --st.backoff;
+        st.cleanSends = 0;
+    }
+}
+
+std::vector<QueuedSearchInfo> SearchScheduler::pending() const {
+    std::vector<QueuedSearchInfo> out;
+    out.reserve(m_entries.size());
+    for (const auto& kv : m_entries) {
+        const Entry& e = kv.second;
+        QueuedSearchInfo info;
+        info.token = e.request.token;
+        info.query = e.request.query;
+        info.fileType = e.request.fileType;
+        info.priority = e.request.priority;
+        info.pendingHubs.assign(e.hubs.begin(), e.hubs.end());
+        std::sort(info.pendingHubs.begin(), info.pendingHubs.end());
+        info.sentHubs = static_cast<int>(e.sentTo.size());
+        info.queuedAt = static_cast<int64_t>(e.queuedAt);
+        out.push_back(std::move(info));
+    }
+    return out;
+}
+
+void SearchScheduler::clear() {
+    m_entries.clear();
+    m_byToken.clear();
+    m_pendingTTH.clear();
+    m_recentTTH.clear();
+    m_hubState.clear();
+}
+
+} // namespace eiskaltdcpp_py
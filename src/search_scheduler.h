@@ -0,0 +1,136 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * search_scheduler.h — Paces queued searches per hub.
+ *
+ * Hubs punish clients that search more often than their minimum interval
+ * (SearchFlood) and drop the searches.  DCBridge::queueSearch() files a
+ * search here instead of sending it, with the hubs it should reach.
+ * Whenever a hub's interval has passed, it is given the highest-priority
+ * pending search that still needs it (FIFO among equal priorities).
+ * Searches are sent to every hub that is ready at the same moment in one
+ * SearchManager call, so a search fans out as fast as the hubs allow.
+ *
+ * A hub that reports a flood has its interval doubled (up to 8x) and
+ * eases back one step after ten clean sends.  Searches sent directly with
+ * DCBridge::startSearch() are noted too, so queued ones keep their
+ * distance.
+ *
+ * TTH searches are deduplicated: queueing a TTH that is still pending
+ * merges the hubs into that search (keeping the higher priority), and one
+ * sent to the same hubs within the last minute is not repeated.  Either
+ * way the caller gets the existing token.
+ *
+ * Not thread-safe — callers hold DCBridge::m_schedulerMutex.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+
+namespace eiskaltdcpp_py {
+
+class SearchScheduler {
+public:
+    struct Request {
+        std::string token;
+        std::string query;
+        int fileType = 0;           // as DCBridge::search()
+        int sizeMode = 0;
+        int64_t size = 0;
+        int priority = 0;           // higher goes first
+    };
+
+    /// One SearchManager call: a request and the hubs it goes to now.
+    struct Dispatch {
+        Request request;
+        std::vector<std::string> hubs;
+    };
+
+    static constexpr uint64_t DEFAULT_INTERVAL_MS = 10 * 1000;
+
+    void setInterval(uint64_t ms) { m_intervalMs = ms; }
+    uint64_t interval() const { return m_intervalMs; }
+
+    /// Queue req for hubs.  Returns the token the results will be filed
+    /// under: req.token, or that of the TTH search it was merged into.
+    std::string enqueue(Request req, const std::vector<std::string>& hubs,
+                        uint64_t nowMs);
+
+    bool cancel(const std::string& token);
+
+    /// Searches to send now.  known holds every tracked hub and connected
+    /// those online: pending hubs that are no longer known are dropped,
+    /// ones that are offline wait.  Searches with no hubs left are
+    /// removed.
+    std::vector<Dispatch> due(uint64_t nowMs,
+                              const std::unordered_set<std::string>& known,
+                              const std::unordered_set<std::string>& connected);
+
+    /// A search went to these hubs outside the scheduler.
+    void noteSent(const std::vector<std::string>& hubs, uint64_t nowMs);
+
+    /// The hub rejected a search as a flood.
+    void noteFlood(const std::string& hubUrl, uint64_t nowMs);
+
+    /// Current interval for a hub, with any flood backoff.
+    uint64_t hubInterval(const std::string& hubUrl) const;
+
+    std::vector<QueuedSearchInfo> pending() const;
+    size_t size() const { return m_entries.size(); }
+    void clear();
+
+private:
+    static constexpr int MAX_BACKOFF = 3;           // interval << 3 = 8x
+    static constexpr int CLEAN_SENDS_TO_EASE = 10;
+    static constexpr uint64_t RECENT_TTH_MS = 60 * 1000;
+
+    // Ordered by (-priority, seq), so iteration is scheduling order
+    using Key = std::pair<int, uint64_t>;
+
+    struct Entry {
+        Request request;
+        std::unordered_set<std::string> hubs;   // still to send to
+        std::unordered_set<std::string> sentTo;
+        uint64_t queuedAt = 0;
+    };
+
+    struct HubState {
+        uint64_t lastSent = 0;
+        bool sent = false;
+        int backoff = 0;
+        int cleanSends = 0;
+    };
+
+    struct RecentTTH {
+        std::string token;
+        std::unordered_set<std::string> hubs;
+        uint64_t sentAt = 0;
+    };
+
+    bool ready(const std::string& hubUrl, uint64_t nowMs) const;
+    void markSent(const std::string& hubUrl, uint64_t nowMs);
+    std::map<Key, Entry>::iterator erase(std::map<Key, Entry>::iterator it);
+    static std::string tthKey(const Request& req);
+
+    uint64_t m_intervalMs = DEFAULT_INTERVAL_MS;
+    uint64_t m_nextSeq = 0;
+    std::map<Key, Entry> m_entries;
+    std::unordered_map<std::string, Key> m_byToken;
+    std::unordered_map<std::string, std::string> m_pendingTTH;  // → token
+    std::unordered_map<std::string, RecentTTH> m_recentTTH;
+    std::unordered_map<std::string, HubState> m_hubState;
+};
+
+} // namespace eiskaltdcpp_py
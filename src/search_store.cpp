@@ -0,0 +1,320 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * search_store.cpp — Token-keyed, deduplicated, bounded search results.
+ */
+
+#include "search_store.h"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace eiskaltdcpp_py {
+
+// =========================================================================
+// SearchResultChunk / SearchResultSnapshot
+// =========================================================================
+
+SearchResultChunk::~SearchResultChunk() {
+    auto* items = reinterpret_cast<SearchResultInfo*>(m_storage);
+    for (size_t i = 0; i < m_count; ++i) items[i].~SearchResultInfo();
+}
+
+void SearchResultChunk::push(SearchResultInfo&& info) {
+    new (m_storage + m_count * sizeof(SearchResultInfo))
+        SearchResultInfo(std::move(info));
+    ++m_count;
+}
+
+SearchResultInfo SearchResultSnapshot::at(size_t i) const {
+    if (i >= m_count) {
+        throw std::out_of_range("search result index out of range");
+    }
+    SearchResultInfo out = item(i);
+    fillTTH(out);
+    return out;
+}
+
+std::vector<SearchResultInfo> SearchResultSnapshot::slice(size_t offset,
+                                                          int limit) const {
+    std::vector<SearchResultInfo> out;
+    if (offset >= m_count) return out;
+    size_t end = m_count;
+    if (limit > 0) end = std::min(end, offset + static_cast<size_t>(limit));
+    out.reserve(end - offset);
+    for (size_t i = offset; i < end; ++i) {
+        out.push_back(item(i));
+        fillTTH(out.back());
+    }
+    return out;
+}
+
+// =========================================================================
+// SearchResultStore
+// =========================================================================
+
+// ASCII-only lower-casing: leaves UTF-8 multibyte sequences untouched,
+// which is what NMDC hubs do when matching search terms anyway.
+static std::string lowerAscii(const std::string& s) {
+    std::string out(s);
+    for (char& ch : out) {
+        if (ch >= 'A' && ch <= 'Z') ch = static_cast<char>(ch - 'A' + 'a');
+    }
+    return out;
+}
+
+static std::vector<std::string> splitTerms(const std::string& query) {
+    std::vector<std::string> terms;
+    std::string lower = lowerAscii(query);
+    size_t i = 0;
+    while (i < lower.size()) {
+        while (i < lower.size() && (lower[i] == ' ' || lower[i] == '$')) ++i;
+        size_t j = i;
+        while (j < lower.size() && lower[j] != ' ' && lower[j] != '$') ++j;
+        if (j > i) terms.push_back(lower.substr(i, j - i));
+        i = j;
+    }
+    return terms;
+}
+
+SearchResultStore::Session& SearchResultStore::touch(Session& s,
+                                                     uint64_t nowMs) {
+    s.touchedMs = nowMs;
+    if (s.lru != m_lru.begin()) {
+        m_lru.splice(m_lru.begin(), m_lru, s.lru);
+    }
+    return s;
+}
+
+SearchResultStore::Session& SearchResultStore::session(
+        const std::string& token, uint64_t nowMs) {
+    auto it = m_sessions.find(token);
+    if (it != m_sessions.end()) return touch(it->second, nowMs);
+
+    // Make room first so the new session is never its own eviction victim
+    while (!m_lru.empty() && m_sessions.size() >= m_limits.maxSearches) {
+        dropSession(m_sessions.find(m_lru.back()));
+    }
+
+    Session& s = m_sessions[token];
+    s.token = token;
+    s.touchedMs = nowMs;
+    m_lru.push_front(token);
+    s.lru = m_lru.begin();
+    return s;
+}
+
+void SearchResultStore::dropSession(
+        std::unordered_map<std::string, Session>::iterator it) {
+    if (it == m_sessions.end()) return;
+    m_totalResults -= it->second.count;
+    for (const auto& [hubUrl, used] : it->second.hubs) {
+        auto hub = m_hubUsage.find(hubUrl);
+        hub->second.count -= used.count;
+        hub->second.bytes -= used.bytes;
+        if (hub->second.count == 0) m_hubUsage.erase(hub);
+    }
+    m_lru.erase(it->second.lru);
+    m_sessions.erase(it);
+}
+
+void SearchResultStore::beginSearch(const std::string& token,
+                                    const std::string& query, bool isTTH,
+                                    const std::string& hubUrl,
+                                    uint64_t nowMs) {
+    Session& s = session(token, nowMs);
+    s.hubUrl = hubUrl;
+    s.terms.clear();
+    if (isTTH) {
+        // A malformed TTH leaves neither a TTH nor terms: matches nothing
+        s.isTTH = base32Decode(query, s.tth.data(), s.tth.size());
+    } else {
+        s.isTTH = false;
+        s.terms = splitTerms(query);
+    }
+}
+
+SearchResultStore::Session* SearchResultStore::attribute(
+        const SearchResultInfo& info) {
+    std::string name;   // lower-cased lazily, only if a term query needs it
+    std::array<uint8_t, 24> tth = info.rawTTH;
+    bool hasTTH = !info.isDirectory &&
+        (info.hasRawTTH || base32Decode(info.tth, tth.data(), tth.size()));
+    for (const std::string& token : m_lru) {
+        if (token.empty()) continue;
+        Session& s = m_sessions.find(token)->second;
+        if (!s.hubUrl.empty() && s.hubUrl != info.hubUrl) continue;
+
+        if (s.isTTH) {
+            if (hasTTH && s.tth == tth) return &s;
+            continue;
+        }
+        if (s.terms.empty()) continue;
+        if (name.empty()) {
+            name = lowerAscii(info.path.empty() ? info.file : info.path);
+        }
+        bool all = std::all_of(s.terms.begin(), s.terms.end(),
+            [&](const std::string& t) {
+                return name.find(t) != std::string::npos;
+            });
+        if (all) return &s;
+    }
+    return nullptr;
+}
+
+bool SearchResultStore::add(const std::string& token, SearchResultInfo&& info,
+                            const std::string& dedupKey, uint64_t nowMs) {
+    Session* s = nullptr;
+    if (!token.empty()) {
+        auto it = m_sessions.find(token);
+        if (it != m_sessions.end()) s = &touch(it->second, nowMs);
+    }
+    if (!s) s = attribute(info);
+    if (s) {
+        touch(*s, nowMs);
+    } else {
+        // Not touched: the unsolicited session's TTL runs from its start
+        auto it = m_sessions.find("");
+        s = it != m_sessions.end() ? &it->second : &session("", nowMs);
+    }
+
+    if (s->count >= m_limits.maxResultsPerSearch) return false;
+    if (m_limits.maxResultsPerHub > 0 &&
+        hubUsage(info.hubUrl).count >= m_limits.maxResultsPerHub) {
+        return false;
+    }
+    if (!s->seen.insert(dedupKey).second) return false;
+
+    info.token = s->token;
+    size_t bytes = resultBytes(info);
+    HubUsage& mine = s->hubs[info.hubUrl];
+    HubUsage& total = m_hubUsage[info.hubUrl];
+    ++mine.count;
+    mine.bytes += bytes;
+    ++total.count;
+    total.bytes += bytes;
+    append(*s, std::move(info));
+    ++m_totalResults;
+    return true;
+}
+
+size_t SearchResultStore::resultBytes(const SearchResultInfo& info) {
+    size_t bytes = sizeof(SearchResultInfo);
+    for (const std::string* str : {&info.file, &info.path, &info.tth,
+                                   &info.nick, &info.hubUrl,
+                                   &info.hubName, &info.token}) {
+        if (str->capacity() > 15) bytes += str->capacity() + 1;
+    }
+    return bytes;
+}
+
+void SearchResultStore::append(Session& s, SearchResultInfo&& info) {
+    if (s.chunks.empty() || s.chunks.back()->full()) {
+        s.chunks.push_back(std::make_shared<SearchResultChunk>());
+    }
+    s.chunks.back()->push(std::move(info));
+    ++s.count;
+}
+
+void SearchResultStore::page(const std::string& token, size_t offset,
+                             int limit,
+                             std::vector<SearchResultInfo>& out) const {
+    auto it = m_sessions.find(token);
+    if (it == m_sessions.end()) return;
+    const Session& s = it->second;
+    if (offset >= s.count) return;
+
+    size_t end = s.count;
+    if (limit > 0) end = std::min(end, offset + static_cast<size_t>(limit));
+    out.reserve(out.size() + (end - offset));
+    for (size_t i = offset; i < end; ++i) {
+        out.push_back(item(s, i));
+        fillTTH(out.back());
+    }
+}
+
+std::vector<SearchResultSnapshot> SearchResultStore::snapshots() const {
+    std::vector<SearchResultSnapshot> out;
+    out.reserve(m_lru.size());
+    for (const std::string& token : m_lru) {
+        out.push_back(snapshot(token));
+    }
+    return out;
+}
+
+size_t SearchResultStore::count(const std::string& token) const {
+    auto it = m_sessions.find(token);
+    return it == m_sessions.end() ? 0 : it->second.count;
+}
+
+SearchResultSnapshot SearchResultStore::snapshot(
+        const std::string& token) const {
+    SearchResultSnapshot snap;
+    snap.m_token = token;
+    auto it = m_sessions.find(token);
+    if (it == m_sessions.end()) return snap;
+    snap.m_chunks.assign(it->second.chunks.begin(), it->second.chunks.end());
+    snap.m_count = it->second.count;
+    return snap;
+}
+
+std::vector<std::string> SearchResultStore::tokens() const {
+    return std::vector<std::string>(m_lru.begin(), m_lru.end());
+}
+
+bool SearchResultStore::erase(const std::string& token) {
+    auto it = m_sessions.find(token);
+    if (it == m_sessions.end()) return false;
+    dropSession(it);
+    return true;
+}
+
+void SearchResultStore::clear(const std::string& hubUrl) {
+    if (hubUrl.empty()) {
+        m_sessions.clear();
+        m_lru.clear();
+        m_totalResults = 0;
+        m_hubUsage.clear();
+        return;
+    }
+    if (m_hubUsage.find(hubUrl) == m_hubUsage.end()) return;
+
+    // Keep the sessions (so later results still correlate), drop only
+    // this hub's results.  The dedup set is left alone: a hub re-sending
+    // the same result for the same search is still a duplicate.  Chunks
+    // are rebuilt rather than edited so live snapshots are unaffected.
+    for (auto& [token, s] : m_sessions) {
+        if (s.hubs.erase(hubUrl) == 0) continue;    // nothing from hubUrl
+        Session kept;
+        for (size_t i = 0; i < s.count; ++i) {
+            const auto& r = item(s, i);
+            if (r.hubUrl != hubUrl) append(kept, SearchResultInfo(r));
+        }
+        m_totalResults -= s.count - kept.count;
+        s.chunks.swap(kept.chunks);
+        s.count = kept.count;
+    }
+    m_hubUsage.erase(hubUrl);
+}
+
+SearchResultStore::HubUsage SearchResultStore::hubUsage(
+        const std::string& hubUrl) const {
+    auto it = m_hubUsage.find(hubUrl);
+    return it == m_hubUsage.end() ? HubUsage() : it->second;
+}
+
+void SearchResultStore::expire(uint64_t nowMs) {
+    if (m_limits.ttlMs == 0) return;
+    // LRU order: the oldest sessions are at the back
+    while (!m_lru.empty()) {
+        auto it = m_sessions.find(m_lru.back());
+        if (nowMs - it->second.touchedMs < m_limits.ttlMs) break;
+        dropSession(it);
+    }
+}
+
+} // namespace eiskaltdcpp_py
@@ -0,0 +1,214 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * search_store.h — Bounded, token-keyed search result store.
+ *
+ * Every DCBridge::startSearch() opens a session under its token.  Results
+ * are filed into the session they answer:
+ *   - ADC results carry the token back, so the match is exact;
+ *   - NMDC results do not, so they go to the most recent session whose
+ *     query they satisfy (TTH equality, or every query term present in
+ *     the path) and, for hub-restricted searches, whose hub they came from.
+ * Anything that matches no session lands in the unsolicited session ("").
+ * Filing it there does not count as use, so that session still expires
+ * one TTL after it opened and starts over rather than filling up once.
+ *
+ * Within a session results are deduplicated on (TTH, CID) — or (path, CID)
+ * for directories — and capped at maxResultsPerSearch.  Sessions are
+ * evicted least-recently-used beyond maxSearches, and dropped entirely
+ * once idle for longer than the TTL.  Results are also counted per hub,
+ * so one hub can be capped at maxResultsPerHub across all sessions and
+ * its share of the store reported (hubUsage).
+ *
+ * Results are stored with the raw TTH only; its base32 form is produced
+ * when a result is copied out (at, slice, page), so results
+ * nobody reads never pay for the encoding.
+ *
+ * Results live in fixed-size chunks that are never modified once a slot
+ * is written, so a SearchResultSnapshot is just the chunk pointers plus
+ * a count: taking one copies no results, and it stays valid (and
+ * unchanged) while the store keeps growing or is cleared underneath it.
+ *
+ * The store itself is not thread-safe — callers hold DCBridge::m_searchMutex.
+ * Snapshots may be read from any thread without it.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base32.h"
+#include "types.h"
+
+namespace eiskaltdcpp_py {
+
+/// Fill info.tth from the raw TTH, if it has not been already.
+inline void fillTTH(SearchResultInfo& info) {
+    if (info.hasRawTTH && info.tth.empty()) {
+        info.tth = base32Encode(info.rawTTH.data(), info.rawTTH.size());
+    }
+}
+
+/// Append-only block of results.  Slots below `count` are immutable.
+class SearchResultChunk {
+public:
+    static const size_t CAPACITY = 64;
+
+    SearchResultChunk() = default;
+    ~SearchResultChunk();
+    SearchResultChunk(const SearchResultChunk&) = delete;
+    SearchResultChunk& operator=(const SearchResultChunk&) = delete;
+
+    bool full() const { return m_count == CAPACITY; }
+    size_t count() const { return m_count; }
+
+    /// Construct the next slot in place.  Must not be called when full.
+    void push(SearchResultInfo&& info);
+
+    const SearchResultInfo& operator[](size_t i) const {
+        return reinterpret_cast<const SearchResultInfo*>(m_storage)[i];
+    }
+
+private:
+    // Raw storage: slots are constructed on push, so an empty chunk costs
+    // no string constructors and a written slot never moves.
+    alignas(SearchResultInfo)
+        unsigned char m_storage[CAPACITY * sizeof(SearchResultInfo)];
+    size_t m_count = 0;
+};
+
+/// Immutable view of one search's results at the moment it was taken.
+class SearchResultSnapshot {
+public:
+    SearchResultSnapshot() = default;
+
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+    const std::string& token() const { return m_token; }
+
+    /// Copy of result i.  Throws std::out_of_range.
+    SearchResultInfo at(size_t i) const;
+
+    /// Results [offset, offset + limit) — limit <= 0 means to the end.
+    std::vector<SearchResultInfo> slice(size_t offset, int limit) const;
+
+    /// Unchecked reference access, for columnar packing.
+    const SearchResultInfo& item(size_t i) const {
+        return (*m_chunks[i / SearchResultChunk::CAPACITY])
+            [i % SearchResultChunk::CAPACITY];
+    }
+
+private:
+    friend class SearchResultStore;
+
+    std::string m_token;
+    std::vector<std::shared_ptr<const SearchResultChunk>> m_chunks;
+    size_t m_count = 0;
+};
+
+class SearchResultStore {
+public:
+    struct Limits {
+        size_t maxResultsPerSearch = 5000;
+        size_t maxSearches = 64;
+        uint64_t ttlMs = 30 * 60 * 1000;    // idle time before expiry
+        size_t maxResultsPerHub = 0;        // 0 = unlimited
+    };
+
+    /// Results stored from one hub and their approximate heap bytes.
+    struct HubUsage {
+        size_t count = 0;
+        size_t bytes = 0;
+    };
+
+    void setLimits(const Limits& limits) { m_limits = limits; }
+    const Limits& limits() const { return m_limits; }
+
+    /// Open a session for token.  isTTH marks a file-type-8 query.
+    void beginSearch(const std::string& token, const std::string& query,
+                     bool isTTH, const std::string& hubUrl, uint64_t nowMs);
+
+    /// File a result.  token may be empty (NMDC); dedupKey identifies the
+    /// (TTH, CID) pair.  Returns false when the result was not stored: a
+    /// duplicate, or its session or hub is at its cap.  Storage only —
+    /// whether the result is announced is up to the caller.  Terms match
+    /// against info.path (info.file when it is empty).
+    bool add(const std::string& token, SearchResultInfo&& info,
+             const std::string& dedupKey, uint64_t nowMs);
+
+    /// Results of one session, [offset, offset + limit).  limit <= 0 means
+    /// "to the end".
+    void page(const std::string& token, size_t offset, int limit,
+              std::vector<SearchResultInfo>& out) const;
+
+    /// Zero-copy views of every session, most recently used first.
+    std::vector<SearchResultSnapshot> snapshots() const;
+
+    size_t count(const std::string& token) const;
+
+    /// Zero-copy view of a session's current results (empty if unknown).
+    SearchResultSnapshot snapshot(const std::string& token) const;
+
+    /// Tokens of the live sessions, most recently used first.
+    std::vector<std::string> tokens() const;
+
+    /// Drop one session.  Returns false if it did not exist.
+    bool erase(const std::string& token);
+
+    /// Remove results that came from hubUrl (all results when empty).
+    void clear(const std::string& hubUrl = "");
+
+    /// Drop sessions idle for longer than the TTL.
+    void expire(uint64_t nowMs);
+
+    /// Total stored results across sessions.
+    size_t size() const { return m_totalResults; }
+
+    /// What results from hubUrl currently hold.
+    HubUsage hubUsage(const std::string& hubUrl) const;
+
+private:
+    struct Session {
+        std::string token;
+        std::string hubUrl;                 // empty = all hubs
+        std::vector<std::string> terms;     // lower-cased query words
+        bool isTTH = false;
+        std::array<uint8_t, 24> tth{};      // TTH queries only
+        std::vector<std::shared_ptr<SearchResultChunk>> chunks;
+        size_t count = 0;
+        std::unordered_set<std::string> seen;
+        std::unordered_map<std::string, HubUsage> hubs;    // by hubUrl
+        uint64_t touchedMs = 0;
+        std::list<std::string>::iterator lru;
+    };
+
+    Session& touch(Session& s, uint64_t nowMs);
+    Session& session(const std::string& token, uint64_t nowMs);
+    Session* attribute(const SearchResultInfo& info);
+    void dropSession(std::unordered_map<std::string, Session>::iterator it);
+    static void append(Session& s, SearchResultInfo&& info);
+    static size_t resultBytes(const SearchResultInfo& info);
+    static const SearchResultInfo& item(const Session& s, size_t i) {
+        return (*s.chunks[i / SearchResultChunk::CAPACITY])
+            [i % SearchResultChunk::CAPACITY];
+    }
+
+    // token → session; m_lru has the tokens, most recently used at front
+    std::unordered_map<std::string, Session> m_sessions;
+    std::list<std::string> m_lru;
+    Limits m_limits;
+    size_t m_totalResults = 0;
+    std::unordered_map<std::string, HubUsage> m_hubUsage;  // by hubUrl
+};
+
+} // namespace eiskaltdcpp_py
@@ -0,0 +1,245 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * tth_index.cpp — Chained TTH postings with on-disk persistence.
+ */
+
+#include "tth_index.h"
+#include "base32.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace eiskaltdcpp_py {
+
+// File layout (native byte order; the marker rejects a foreign one):
+//   char[8] MAGIC, uint32 VERSION, uint32 ENDIAN_MARK, uint32 nSources
+//   per source: uint32 idLen, char[idLen], int64 mtime, int64 fileSize,
+//               uint32 nTTH, uint8[nTTH][24]
+static const char MAGIC[8] = {'D', 'C', 'P', 'Y', 'T', 'T', 'H', 'I'};
+static const uint32_t VERSION = 1;
+static const uint32_t ENDIAN_MARK = 0x01020304;
+static const uint32_t MAX_TTHS_PER_SOURCE = 1u << 26;   // sanity bound
+
+template <typename T>
+static void put(std::ofstream& out, const T& v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+template <typename T>
+static bool get(std::ifstream& in, T& v) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), sizeof(v)));
+}
+
+void TTHIndex::kill(uint32_t slot) {
+    SourceSlot& s = m_sources[slot];
+    s.live = false;
+    m_deadPostings += s.postings;
+    s.postings = 0;
+}
+
+void TTHIndex::setSource(const Source& src, std::vector<RawTTH> tths) {
+    auto it = m_byId.find(src.fileListId);
+    if (it != m_byId.end()) {
+        kill(it->second);
+        m_byId.erase(it);
+    }
+
+    std::sort(tths.begin(), tths.end());
+    tths.erase(std::unique(tths.begin(), tths.end()), tths.end());
+
+    uint32_t slot = static_cast<uint32_t>(m_sources.size());
+    m_sources.push_back({src, static_cast<uint32_t>(tths.size()), true});
+    m_byId.emplace(src.fileListId, slot);
+
+    m_postings.reserve(m_postings.size() + tths.size());
+    m_heads.reserve(m_heads.size() + tths.size());
+    for (const auto& tth : tths) {
+        auto [h, inserted] = m_heads.try_emplace(tth, NONE);
+        m_postings.push_back({slot, h->second});
+        h->second = static_cast<uint32_t>(m_postings.size() - 1);
+    }
+    m_dirty = true;
+
+    if (m_deadPostings > m_postings.size() / 2) compact();
+}
+
+bool TTHIndex::removeSource(const std::string& fileListId) {
+    auto it = m_byId.find(fileListId);
+    if (it == m_byId.end()) return false;
+    kill(it->second);
+    m_byId.erase(it);
+    m_dirty = true;
+
+    if (m_deadPostings > m_postings.size() / 2) compact();
+    return true;
+}
+
+const TTHIndex::Source* TTHIndex::source(const std::string& fileListId) const {
+    auto it = m_byId.find(fileListId);
+    return it == m_byId.end() ? nullptr : &m_sources[it->second].info;
+}
+
+std::vector<std::string> TTHIndex::sourceIds() const {
+    std::vector<std::string> ids;
+    ids.reserve(m_byId.size());
+    for (const auto& [id, slot] : m_byId) ids.push_back(id);
+    return ids;
+}
+
+void TTHIndex::find(const RawTTH& tth,
+                    std::vector<const Source*>& out) const {
+    auto it = m_heads.find(tth);
+    if (it == m_heads.end()) return;
+    for (uint32_t p = it->second; p != NONE; p = m_postings[p].next) {
+        const SourceSlot& s = m_sources[m_postings[p].source];
+        if (s.live) out.push_back(&s.info);
+    }
+}
+
+void TTHIndex::compact() {
+    // Renumber live sources, then rebuild each chain without the dead
+    // postings.  Chain order (newest first) is preserved.
+    std::vector<uint32_t> remap(m_sources.size(), NONE);
+    std::vector<SourceSlot> sources;
+    sources.reserve(m_byId.size());
+    for (uint32_t i = 0; i < m_sources.size(); ++i) {
+        if (!m_sources[i].live) continue;
+        remap[i] = static_cast<uint32_t>(sources.size());
+        sources.push_back(std::move(m_sources[i]));
+    }
+    for (auto& [id, slot] : m_byId) slot = remap[slot];
+
+    std::vector<Posting> postings;
+    postings.reserve(m_postings.size() - m_deadPostings);
+    std::vector<uint32_t> chain;
+    for (auto it = m_heads.begin(); it != m_heads.end();) {
+        chain.clear();
+        for (uint32_t p = it->second; p != NONE; p = m_postings[p].next) {
+            uint32_t s = remap[m_postings[p].source];
+            if (s != NONE) chain.push_back(s);
+        }
+        if (chain.empty()) {
+            it = m_heads.erase(it);
+            continue;
+        }
+        uint32_t head = NONE;
+        for (auto s = chain.rbegin(); s != chain.rend(); ++s) {
+            postings.push_back({*s, head});
+            head = static_cast<uint32_t>(postings.size() - 1);
+        }
+        it->second = head;
+        ++it;
+    }
+
+    m_sources.swap(sources);
+    m_postings.swap(postings);
+    m_deadPostings = 0;
+}
+
+void TTHIndex::clear() {
+    m_heads.clear();
+    m_postings.clear();
+    m_sources.clear();
+    m_byId.clear();
+    m_deadPostings = 0;
+    m_dirty = true;
+}
+
+bool TTHIndex::save(const std::string& path) {
+    // Regroup the postings by source
+    std::vector<std::vector<RawTTH>> bySource(m_sources.size());
+    for (const auto& [tth, head] : m_heads) {
+        for (uint32_t p = head; p != NONE; p = m_postings[p].next) {
+            if (m_sources[m_postings[p].source].live) {
+                bySource[m_postings[p].source].push_back(tth);
+            }
+        }
+    }
+
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(MAGIC, sizeof(MAGIC));
+        put(out, VERSION);
+        put(out, ENDIAN_MARK);
+        put(out, static_cast<uint32_t>(m_byId.size()));
+        for (uint32_t i = 0; i < m_sources.size(); ++i) {
+            const SourceSlot& s = m_sources[i];
+            if (!s.live) continue;
+            put(out, static_cast<uint32_t>(s.info.fileListId.size()));
+            out.write(s.info.fileListId.data(), s.info.fileListId.size());
+            put(out, s.info.mtime);
+            put(out, s.info.fileSize);
+            put(out, static_cast<uint32_t>(bySource[i].size()));
+            out.write(reinterpret_cast<const char*>(bySource[i].data()),
+                      bySource[i].size() * TTH_SIZE);
+        }
+        if (!out.flush()) return false;
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool TTHIndex::load(const std::string& path) {
+    clear();
+    m_dirty = false;
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    char magic[sizeof(MAGIC)];
+    uint32_t version = 0, mark = 0, nSources = 0;
+    if (!in.read(magic, sizeof(magic)) ||
+            memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            !get(in, version) || version != VERSION ||
+            !get(in, mark) || mark != ENDIAN_MARK ||
+            !get(in, nSources)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < nSources; ++i) {
+        uint32_t idLen = 0, nTTH = 0;
+        Source src;
+        if (!get(in, idLen) || idLen > 4096) break;
+        src.fileListId.resize(idLen);
+        if (!in.read(&src.fileListId[0], idLen) ||
+                !get(in, src.mtime) || !get(in, src.fileSize) ||
+                !get(in, nTTH) || nTTH > MAX_TTHS_PER_SOURCE) {
+            break;
+        }
+        std::vector<RawTTH> tths(nTTH);
+        if (!in.read(reinterpret_cast<char*>(tths.data()),
+                     static_cast<std::streamsize>(nTTH) * TTH_SIZE)) {
+            break;
+        }
+        setSource(src, std::move(tths));
+    }
+
+    if (m_byId.size() != nSources) {
+        clear();
+        m_dirty = false;
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool TTHIndex::decodeTTH(const std::string& base32, RawTTH& out) {
+    return base32Decode(base32, out.data(), out.size());
+}
+
+std::string TTHIndex::encodeTTH(const RawTTH& raw) {
+    return base32Encode(raw.data(), raw.size());
+}
+
+} // namespace eiskaltdcpp_py
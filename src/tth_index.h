@@ -0,0 +1,117 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * tth_index.h — TTH → file-list sources, across every downloaded list.
+ *
+ * Each downloaded file list is a "source": the set of TTHs it contains.
+ * The index maps a raw 24-byte TTH to the sources that have it, so
+ * matchAllLists() and findSources() answer in O(1) per TTH instead of
+ * re-parsing every files.xml.bz2.
+ *
+ * Layout: one hash entry per distinct TTH pointing at the head of a
+ * singly linked chain of postings in a flat vector — no per-TTH heap
+ * vector.  Replacing or dropping a source only marks it dead; its
+ * postings are skipped on lookup and reclaimed by compacting once they
+ * outnumber the live ones.
+ *
+ * The index is saved next to the settings (save/load), recording each
+ * source's file mtime and size, so a restart only re-indexes lists that
+ * appeared or changed since.
+ *
+ * Not thread-safe — callers hold DCBridge::m_tthMutex.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace eiskaltdcpp_py {
+
+class TTHIndex {
+public:
+    static const size_t TTH_SIZE = 24;
+    using RawTTH = std::array<uint8_t, TTH_SIZE>;
+
+    struct Source {
+        std::string fileListId;     // file name in Util::getListPath()
+        int64_t mtime = 0;          // of the list file when indexed
+        int64_t fileSize = 0;
+    };
+
+    /// Add or replace fileListId's TTHs (duplicates are ignored).
+    void setSource(const Source& src, std::vector<RawTTH> tths);
+
+    /// Forget a source.  Returns false if it was not indexed.
+    bool removeSource(const std::string& fileListId);
+
+    /// Indexed state of one source, or nullptr.
+    const Source* source(const std::string& fileListId) const;
+
+    /// Ids of every indexed source.
+    std::vector<std::string> sourceIds() const;
+
+    /// Append the sources containing tth to out.
+    void find(const RawTTH& tth, std::vector<const Source*>& out) const;
+
+    size_t sourceCount() const { return m_byId.size(); }
+    size_t tthCount() const { return m_heads.size(); }
+
+    /// Whether anything changed since the last save() / load().
+    bool dirty() const { return m_dirty; }
+
+    /// Write atomically (temp file + rename).  Returns false on I/O error.
+    bool save(const std::string& path);
+
+    /// Replace the contents from a file written by save().  Returns false
+    /// (leaving the index empty) if it is missing, foreign or truncated.
+    bool load(const std::string& path);
+
+    void clear();
+
+    /// Base32 ⇄ raw TTH; decode returns false on malformed input.
+    static bool decodeTTH(const std::string& base32, RawTTH& out);
+    static std::string encodeTTH(const RawTTH& raw);
+
+private:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    struct Posting {
+        uint32_t source;
+        uint32_t next;              // NONE ends the chain
+    };
+
+    struct SourceSlot {
+        Source info;
+        uint32_t postings = 0;
+        bool live = false;
+    };
+
+    struct TTHHash {
+        // TTHs are uniformly distributed — any 8 bytes make a fine hash
+        size_t operator()(const RawTTH& t) const {
+            size_t h;
+            memcpy(&h, t.data(), sizeof(h));
+            return h;
+        }
+    };
+
+    void kill(uint32_t slot);
+    void compact();
+
+    std::unordered_map<RawTTH, uint32_t, TTHHash> m_heads;  // → m_postings
+    std::vector<Posting> m_postings;
+    std::vector<SourceSlot> m_sources;
+    std::unordered_map<std::string, uint32_t> m_byId;       // → m_sources
+    size_t m_deadPostings = 0;
+    bool m_dirty = false;
+};
+
+} // namespace eiskaltdcpp_py
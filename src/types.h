@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <cstdint>
 #include <vector>
@@ -27,6 +28,31 @@ struct HubInfo {
     bool isSecure = false;         ///< TLS-encrypted connection to hub
     bool isTrusted = false;        ///< Hub TLS certificate is trusted
     std::string cipherName;        ///< TLS cipher in use (empty if not TLS)
+    int hubId = 0;                 ///< Bridge-assigned handle, never reused
+};
+
+/// Approximate heap held by one hub's bridge-side data
+/// (DCBridge::getHubMemoryStats).
+struct HubMemoryStats {
+    std::string hubUrl;
+    int hubId = 0;
+    int userCount = 0;
+    uint64_t usersDropped = 0;    ///< users refused by the maxUsers cap,
+                                  ///< each nick counted once
+    int64_t userBytes = 0;
+    int chatLines = 0;
+    int64_t chatBytes = 0;
+    int searchResults = 0;        ///< stored results from this hub
+    int64_t searchBytes = 0;
+    int64_t totalBytes = 0;
+};
+
+/// Per-hub caps (DCBridge::setHubLimits).  0 = unlimited, except
+/// maxChatLines, which is the chat history capacity (0 = no history).
+struct HubLimits {
+    int maxUsers = 0;
+    int maxChatLines = 0;
+    int maxResults = 0;
 };
 
 /// Information about a hub user.
@@ -41,9 +67,59 @@ struct UserInfo {
     bool isBot = false;
 };
 
+/// Incremental user-list delta returned by DCBridge::getHubUserChanges().
+///
+/// Apply `removed` first, then `updated`.  When fullResync is set the
+/// requested revision is no longer covered by the change log (too old,
+/// or the hub was re-added): drop the local copy and take `updated` as
+/// the complete list.
+struct UserChanges {
+    uint64_t revision = 0;        // pass back as sinceRevision next time
+    bool fullResync = false;
+    std::vector<UserInfo> updated;    // joined or changed since then
+    std::vector<std::string> removed; // nicks that left since then
+};
+
+/// One line of a hub's chat history.
+struct ChatEntry {
+    uint64_t seq = 0;             // per-hub, increasing by one per line
+    int64_t timestamp = 0;        // Unix seconds
+    std::string nick;             // empty for hub / status lines
+    std::string text;
+    bool thirdPerson = false;     // /me
+    bool isPrivate = false;
+};
+
+/// Chat lines after a given seq (DCBridge::getChatHistorySince()).
+struct ChatHistoryPage {
+    uint64_t lastSeq = 0;         // pass back as sinceSeq next time
+    bool gap = false;             // lines were evicted (or numbering
+                                  // restarted) before the first entry
+    std::vector<ChatEntry> entries;
+};
+
+/// What a ChatLogEntry records.
+enum ChatLogKind {
+    CHAT_LOG_CHAT = 0,
+    CHAT_LOG_PRIVATE = 1,
+    CHAT_LOG_STATUS = 2
+};
+
+/// One record of the on-disk chat log (DCBridge::queryChatLog()).
+struct ChatLogEntry {
+    int64_t timestamp = 0;        // Unix seconds, when it was received
+    int kind = CHAT_LOG_CHAT;     // ChatLogKind
+    std::string hubUrl;
+    std::string nick;             // sender; empty for status lines
+    std::string to;               // PM recipient
+    std::string text;
+    bool thirdPerson = false;
+};
+
 /// A search result.
 struct SearchResultInfo {
     std::string file;
+    std::string path;    // full path as sent; NMDC hubs match terms on it
     int64_t size = 0;
     std::string tth;
     std::string nick;
@@ -52,6 +128,23 @@ struct SearchResultInfo {
     int freeSlots = 0;
     int totalSlots = 0;
     bool isDirectory = false;
+    std::string token;   // search session this result was filed under
+
+    // Results coming off the wire carry the TTH as raw bytes; `tth` is
+    // only base32-encoded when a result is handed out (fillTTH()).
+    std::array<uint8_t, 24> rawTTH{};
+    bool hasRawTTH = false;
+};
+
+/// A search waiting in the scheduler (DCBridge::listQueuedSearches).
+struct QueuedSearchInfo {
+    std::string token;
+    std::string query;
+    int fileType = 0;
+    int priority = 0;
+    std::vector<std::string> pendingHubs;   ///< not sent to yet
+    int sentHubs = 0;                       ///< hubs already searched
+    int64_t queuedAt = 0;                   ///< ms tick it was queued at
 };
 
 /// An item in the download queue.
@@ -67,7 +160,34 @@ struct QueueItemInfo {
     int status = 0;           // 0=queued, 1=running, 2=finished
 };
 
-/// An active transfer (upload or download).
+/// One file for DCBridge::addToQueueBatch() (same fields as addToQueue).
+struct QueueAddItem {
+    std::string directory;
+    std::string name;
+    int64_t size = 0;
+    std::string tth;
+};
+
+/// One page of the download queue, in target order
+/// (DCBridge::listQueuePage()).
+struct QueuePage {
+    uint64_t revision = 0;        // queue revision the page was cut at
+    int total = 0;                // items in the whole queue
+    std::vector<QueueItemInfo> items;
+};
+
+/// Incremental queue delta returned by DCBridge::getQueueChanges().
+/// Applied like UserChanges: `removed` first, then `updated`; on
+/// fullResync, `updated` is the whole queue.
+struct QueueChanges {
+    uint64_t revision = 0;        // pass back as sinceRevision next time
+    bool fullResync = false;
+    std::vector<QueueItemInfo> updated;   // added or changed since then
+    std::vector<std::string> removed;     // targets gone since then
+};
+
+/// An active transfer (upload or download).  size and pos are those of
+/// the segment being transferred, as the core tracks them.
 struct TransferInfo {
     std::string filename;
     std::string nick;
@@ -97,8 +217,26 @@ struct HashStatus {
 struct FileListEntry {
     std::string name;
     int64_t size = 0;
-    std::string tth;            // empty for directories
+    std::string tth;            // empty for directories; see rawTTH
     bool isDirectory = false;
+    std::string path;           // from the list root (walk / search)
+    std::string fileListId;     // searchFileLists only
+    // Listings hand the TTH out raw; Python's `tth` base32-encodes it
+    // only when read.  C++ callers use fillTTH().
+    std::array<uint8_t, 24> rawTTH{};
+    bool hasRawTTH = false;
+};
+
+/// One page of DCBridge::searchFileLists() hits.
+struct FileListSearchPage {
+    uint64_t total = 0;             // hits across every list searched
+    std::vector<FileListEntry> hits;
+};
+
+/// A downloaded file list that contains a TTH (DCBridge::findSources).
+struct TTHSource {
+    std::string tth;
+    std::string fileListId;     // as in listLocalFileLists()
 };
 
 /// Aggregate transfer statistics.
@@ -111,4 +249,164 @@ struct TransferStats {
     int uploadCount = 0;
 };
 
+/// Consolidated status, rebuilt once a second on the core's timer
+/// thread (DCBridge::getStatusSnapshot).
+struct StatusSnapshot {
+    uint64_t seq = 0;             ///< 0 until the first tick, then +1 each
+    int64_t timestamp = 0;        ///< unix time it was taken
+    int hubs = 0;                 ///< hubs added to the bridge
+    int connectedHubs = 0;
+    int users = 0;                ///< summed over connected hubs
+    int64_t shareSize = 0;
+    int64_t sharedFiles = 0;
+    uint64_t queueItems = 0;
+    int activeTransfers = 0;
+    TransferStats transfers;
+    HashStatus hashing;
+};
+
+/// Startup progress (DCBridge::getInitPhase).
+enum InitPhase {
+    INIT_NONE = 0,      ///< not started, or shut down
+    INIT_LOADING = 1,   ///< dcpp::startup() running in the background
+    INIT_READY = 2,     ///< loaded; isInitialized() is true
+    INIT_FAILED = 3     ///< startup threw; see getInitStep()
+};
+
+/// How BridgeListeners hands events to the embedding process.
+enum DispatchMode {
+    DISPATCH_DIRECT = 0,   ///< call DCClientCallback synchronously (default)
+    DISPATCH_QUEUED = 1    ///< pack into a ring drained by pollEvents()
+};
+
+/// What BridgeListeners does with events of one EventType
+/// (DCBridge::setEventPolicy).  Applies in both dispatch modes.
+enum EventPolicy {
+    POLICY_DELIVER = 0,    ///< pass every event on (default)
+    POLICY_DROP = 1,       ///< discard, only counting them
+    POLICY_COALESCE = 2,   ///< keep the latest per (hub, nick), deliver
+                           ///< once a second
+    POLICY_RATE_LIMIT = 3  ///< at most N per second per hub, excess
+                           ///< discarded
+};
+
+/// Type tag of a queued BridgeEvent.  One per DCClientCallback method;
+/// the comment lists which BridgeEvent fields carry that method's args.
+enum EventType {
+    EVENT_HUB_CONNECTING = 0,       ///< hubUrl
+    EVENT_HUB_CONNECTED,            ///< hubUrl, text=hubName
+    EVENT_HUB_DISCONNECTED,         ///< hubUrl, text=reason
+    EVENT_HUB_REDIRECT,             ///< hubUrl, text=newUrl
+    EVENT_HUB_PASSWORD_REQUEST,     ///< hubUrl
+    EVENT_HUB_UPDATED,              ///< hubUrl, text=hubName
+    EVENT_NICK_TAKEN,               ///< hubUrl
+    EVENT_HUB_FULL,                 ///< hubUrl
+    EVENT_CHAT_MESSAGE,             ///< hubUrl, nick, text, flag=thirdPerson
+    EVENT_PRIVATE_MESSAGE,          ///< hubUrl, nick=from, extra=to, text
+    EVENT_STATUS_MESSAGE,           ///< hubUrl, text
+    EVENT_USER_CONNECTED,           ///< hubUrl, nick
+    EVENT_USER_DISCONNECTED,        ///< hubUrl, nick
+    EVENT_USER_UPDATED,             ///< hubUrl, nick
+    EVENT_SEARCH_RESULT,            ///< hubUrl, text=file, size, freeSlots,
+                                    ///< totalSlots, extra=tth, nick,
+                                    ///< flag=isDirectory
+    EVENT_DOWNLOAD_STARTING,        ///< text=target, nick, size
+    EVENT_DOWNLOAD_COMPLETE,        ///< text=target, nick, size, value=speed
+    EVENT_DOWNLOAD_FAILED,          ///< text=target, extra=reason
+    EVENT_UPLOAD_STARTING,          ///< text=file, nick, size
+    EVENT_UPLOAD_COMPLETE,          ///< text=file, nick, size
+    EVENT_QUEUE_ITEM_ADDED,         ///< text=target, size, extra=tth
+    EVENT_QUEUE_ITEM_FINISHED,      ///< text=target, size
+    EVENT_QUEUE_ITEM_REMOVED,       ///< text=target
+    EVENT_HASH_PROGRESS,            ///< text=currentFile, size=bytesLeft,
+                                    ///< value=filesLeft
+    EVENT_FILE_LIST_PROGRESS,       ///< text=fileListId, value=percent
+    EVENT_FILE_LIST_LOADED,         ///< text=fileListId, flag=success,
+                                    ///< extra=error
+    EVENT_TRANSFER_PROGRESS,        ///< text=file, nick, hubUrl, size, pos,
+                                    ///< value=speed, flag=isDownload
+                                    ///< (one record per transfer)
+    EVENT_CORE_READY,               ///< flag=success, text=error
+    EVENT_TYPE_COUNT
+};
+
+/// A typed event record, as returned by DCBridge::pollEvents().
+struct BridgeEvent {
+    int type = 0;                 ///< EventType
+    uint64_t seq = 0;             ///< global sequence number (gaps = drops)
+    std::string hubUrl;
+    std::string nick;
+    std::string text;
+    std::string extra;
+    int64_t size = 0;
+    int64_t value = 0;
+    int64_t pos = 0;              ///< EVENT_TRANSFER_PROGRESS only
+    int freeSlots = 0;
+    int totalSlots = 0;
+    bool flag = false;
+};
+
+/// Policy and counters for one EventType (DCBridge::getEventPolicyStats).
+/// Counters run from process start or the last resetEventPolicies().
+struct EventPolicyStats {
+    int type = 0;                 ///< EventType
+    int policy = POLICY_DELIVER;  ///< EventPolicy
+    int ratePerSecond = 0;        ///< POLICY_RATE_LIMIT only
+    uint64_t delivered = 0;       ///< passed on to the callback / ring
+    uint64_t dropped = 0;         ///< discarded by DROP or RATE_LIMIT
+    uint64_t coalesced = 0;       ///< replaced by a later event (COALESCE)
+};
+
+/// Counters for the queued-dispatch ring.
+struct EventQueueStats {
+    size_t capacity = 0;          ///< 0 until queued mode is first enabled
+    size_t depth = 0;             ///< records waiting to be polled
+    uint64_t queued = 0;          ///< records accepted since creation
+    uint64_t dropped = 0;         ///< records rejected because ring was full
+    uint64_t polled = 0;          ///< records handed out by pollEvents()
+};
+
+/// A latency distribution.  buckets[0] counts samples under 1 us and
+/// buckets[i] those in [2^(i-1), 2^i) us; the last bucket also takes
+/// everything slower.
+struct LatencyStats {
+    static const int BUCKET_COUNT = 22;     ///< last bound 2^21 us, ~2 s
+    uint64_t count = 0;
+    uint64_t sumNs = 0;
+    uint64_t maxNs = 0;
+    std::vector<uint64_t> buckets;
+};
+
+/// Per-EventType counters (DCBridge::getMetrics).  Batch callbacks count
+/// once per batch.
+struct EventMetrics {
+    int type = 0;                 ///< EventType
+    uint64_t raised = 0;          ///< produced (a batch counts per item)
+    uint64_t skipped = 0;         ///< masked, or nobody listening
+    uint64_t callbacks = 0;       ///< direct-mode callback invocations
+    LatencyStats callbackLatency; ///< time spent in those callbacks
+};
+
+/// Acquisitions of one bridge mutex and how long contended ones waited.
+struct LockMetrics {
+    std::string name;
+    uint64_t acquisitions = 0;
+    uint64_t contended = 0;       ///< had to wait
+    LatencyStats wait;            ///< contended acquisitions only
+};
+
+/// Snapshot of the bridge's always-on instrumentation.  Counters only
+/// grow; each read is atomic on its own, not across the whole struct.
+struct BridgeMetrics {
+    std::vector<EventMetrics> events;       ///< indexed by EventType
+    std::vector<LockMetrics> locks;
+    EventQueueStats ring;                   ///< queued dispatch
+    uint64_t pendingUserEvents = 0;         ///< coalesced, not yet flushed
+    uint64_t heldCoalescedEvents = 0;       ///< POLICY_COALESCE backlog
+    uint64_t searchResults = 0;
+    uint64_t queueItems = 0;
+    int pendingFileListLoads = 0;
+    int hubs = 0;
+};
+
 } // namespace eiskaltdcpp_py
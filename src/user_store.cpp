@@ -0,0 +1,296 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * user_store.cpp — Interned, columnar per-hub user list.
+ */
+
+#include "user_store.h"
+#include "base32.h"
+
+namespace eiskaltdcpp_py {
+
+// =========================================================================
+// StringPool
+// =========================================================================
+
+StringPool::StringPool() {
+    m_entries.emplace_back();   // id 0 = "" — never indexed or released
+}
+
+StringPool::Id StringPool::intern(std::string_view s) {
+    if (s.empty()) return 0;
+
+    auto it = m_index.find(s);
+    if (it != m_index.end()) {
+        ++m_entries[it->second].refs;
+        return it->second;
+    }
+
+    Id id;
+    if (!m_free.empty()) {
+        id = m_free.back();
+        m_free.pop_back();
+    } else {
+        id = static_cast<Id>(m_entries.size());
+        m_entries.emplace_back();
+    }
+    Entry& e = m_entries[id];
+    e.str.assign(s.data(), s.size());
+    e.refs = 1;
+    m_index.emplace(std::string_view(e.str), id);
+    return id;
+}
+
+void StringPool::release(Id id) {
+    if (id == 0) return;
+    Entry& e = m_entries[id];
+    if (e.refs == 0 || --e.refs > 0) return;
+
+    m_index.erase(std::string_view(e.str));
+    std::string().swap(e.str);      // give the heap buffer back
+    m_free.push_back(id);
+}
+
+size_t StringPool::memoryUsage() const {
+    size_t bytes = m_entries.size() * sizeof(Entry) +
+                   m_free.capacity() * sizeof(Id) +
+                   m_index.size() * (sizeof(std::string_view) + sizeof(Id) +
+                                     2 * sizeof(void*)) +
+                   m_index.bucket_count() * sizeof(void*);
+    for (const auto& e : m_entries) {
+        if (e.str.capacity() > 15) bytes += e.str.capacity() + 1;
+    }
+    return bytes;
+}
+
+void StringPool::clear() {
+    m_index.clear();
+    m_free.clear();
+    m_entries.clear();
+    m_entries.emplace_back();
+}
+
+// =========================================================================
+// UserStore
+// =========================================================================
+
+uint32_t UserStore::allocSlot() {
+    if (!m_freeSlots.empty()) {
+        uint32_t slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return slot;
+    }
+    uint32_t slot = static_cast<uint32_t>(m_nick.size());
+    m_nick.push_back(nullptr);
+    m_description.push_back(0);
+    m_connection.push_back(0);
+    m_email.push_back(0);
+    m_cid.emplace_back();
+    m_shareSize.push_back(0);
+    m_flags.push_back(0);
+    m_rev.push_back(0);
+    return slot;
+}
+
+void UserStore::releaseStrings(uint32_t slot) {
+    m_pool.release(m_description[slot]);
+    m_pool.release(m_connection[slot]);
+    m_pool.release(m_email[slot]);
+}
+
+void UserStore::unindexCID(uint32_t slot) {
+    if (!(m_flags[slot] & FLAG_HAS_CID)) return;
+    auto it = m_byCID.find(m_cid[slot]);
+    if (it != m_byCID.end() && it->second == slot) m_byCID.erase(it);
+}
+
+void UserStore::upsert(const UserInfo& ui) {
+    auto [it, inserted] = m_byNick.try_emplace(ui.nick, 0);
+    uint32_t slot;
+    if (inserted) {
+        slot = allocSlot();
+        it->second = slot;
+        m_nick[slot] = &it->first;
+    } else {
+        slot = it->second;
+        m_totalShare -= m_shareSize[slot];
+        unindexCID(slot);
+    }
+
+    // Intern the new values before releasing the old ones so an unchanged
+    // string keeps its pool entry instead of being freed and re-added.
+    StringPool::Id desc = m_pool.intern(ui.description);
+    StringPool::Id conn = m_pool.intern(ui.connection);
+    StringPool::Id mail = m_pool.intern(ui.email);
+    if (!inserted) releaseStrings(slot);
+    m_description[slot] = desc;
+    m_connection[slot] = conn;
+    m_email[slot] = mail;
+
+    uint8_t flags = 0;
+    if (ui.isOp)  flags |= FLAG_OP;
+    if (ui.isBot) flags |= FLAG_BOT;
+    if (decodeCID(ui.cid, m_cid[slot])) {
+        flags |= FLAG_HAS_CID;
+        m_byCID[m_cid[slot]] = slot;
+    }
+    m_flags[slot] = flags;
+
+    m_shareSize[slot] = ui.shareSize;
+    m_totalShare += ui.shareSize;
+    m_rev[slot] = ++m_revision;
+}
+
+bool UserStore::erase(const std::string& nick) {
+    auto it = m_byNick.find(nick);
+    if (it == m_byNick.end()) return false;
+
+    uint32_t slot = it->second;
+    releaseStrings(slot);
+    unindexCID(slot);
+    m_totalShare -= m_shareSize[slot];
+    m_nick[slot] = nullptr;
+    m_description[slot] = m_connection[slot] = m_email[slot] = 0;
+    m_shareSize[slot] = 0;
+    m_flags[slot] = 0;
+    m_rev[slot] = 0;
+    m_freeSlots.push_back(slot);
+
+    m_removals.push_back({++m_revision, it->first});
+    if (m_removals.size() > MAX_REMOVAL_LOG) {
+        m_logFloor = m_removals.front().revision;
+        m_removals.pop_front();
+    }
+    m_byNick.erase(it);
+    return true;
+}
+
+void UserStore::clear() {
+    m_byNick.clear();
+    m_byCID.clear();
+    m_nick.clear();
+    m_description.clear();
+    m_connection.clear();
+    m_email.clear();
+    m_cid.clear();
+    m_shareSize.clear();
+    m_flags.clear();
+    m_rev.clear();
+    m_freeSlots.clear();
+    m_pool.clear();
+    m_totalShare = 0;
+
+    // Removed nicks are not logged individually — push the floor past
+    // every revision handed out so far instead.
+    m_removals.clear();
+    m_logFloor = ++m_revision;
+}
+
+void UserStore::reserve(size_t n) {
+    m_byNick.reserve(n);
+    m_byCID.reserve(n);
+    m_nick.reserve(n);
+    m_description.reserve(n);
+    m_connection.reserve(n);
+    m_email.reserve(n);
+    m_cid.reserve(n);
+    m_shareSize.reserve(n);
+    m_flags.reserve(n);
+    m_rev.reserve(n);
+}
+
+void UserStore::fill(uint32_t slot, UserInfo& out) const {
+    out.nick = *m_nick[slot];
+    out.description = m_pool.get(m_description[slot]);
+    out.connection = m_pool.get(m_connection[slot]);
+    out.email = m_pool.get(m_email[slot]);
+    if (m_flags[slot] & FLAG_HAS_CID) {
+        out.cid = encodeCID(m_cid[slot]);
+    } else {
+        out.cid.clear();
+    }
+    out.shareSize = m_shareSize[slot];
+    out.isOp = (m_flags[slot] & FLAG_OP) != 0;
+    out.isBot = (m_flags[slot] & FLAG_BOT) != 0;
+}
+
+bool UserStore::get(const std::string& nick, UserInfo& out) const {
+    auto it = m_byNick.find(nick);
+    if (it == m_byNick.end()) return false;
+    fill(it->second, out);
+    return true;
+}
+
+const std::string* UserStore::nickForCID(const RawCID& cid) const {
+    auto it = m_byCID.find(cid);
+    return it == m_byCID.end() ? nullptr : m_nick[it->second];
+}
+
+void UserStore::appendAll(std::vector<UserInfo>& out) const {
+    out.reserve(out.size() + m_byNick.size());
+    for (uint32_t slot = 0; slot < m_nick.size(); ++slot) {
+        if (!m_nick[slot]) continue;
+        out.emplace_back();
+        fill(slot, out.back());
+    }
+}
+
+void UserStore::changesSince(uint64_t sinceRevision, UserChanges& out) const {
+    out.revision = m_revision;
+    out.fullResync = sinceRevision == 0 || sinceRevision < m_logFloor ||
+                     sinceRevision > m_revision;
+    out.updated.clear();
+    out.removed.clear();
+
+    if (out.fullResync) {
+        appendAll(out.updated);
+        return;
+    }
+    if (sinceRevision == m_revision) return;
+
+    // Removal log is in revision order — walk back from the newest entry
+    for (auto it = m_removals.rbegin();
+         it != m_removals.rend() && it->revision > sinceRevision; ++it) {
+        out.removed.push_back(it->nick);
+    }
+    for (uint32_t slot = 0; slot < m_nick.size(); ++slot) {
+        if (m_nick[slot] && m_rev[slot] > sinceRevision) {
+            out.updated.emplace_back();
+            fill(slot, out.updated.back());
+        }
+    }
+}
+
+size_t UserStore::memoryUsage() const {
+    size_t perSlot = sizeof(const std::string*) + 3 * sizeof(StringPool::Id) +
+                     sizeof(RawCID) + sizeof(int64_t) + sizeof(uint8_t) +
+                     sizeof(uint64_t);
+    size_t bytes = m_nick.capacity() * perSlot +
+                   m_freeSlots.capacity() * sizeof(uint32_t) +
+                   m_byNick.bucket_count() * sizeof(void*) +
+                   m_byCID.size() * (sizeof(RawCID) + sizeof(uint32_t) +
+                                     2 * sizeof(void*)) +
+                   m_byCID.bucket_count() * sizeof(void*);
+    for (const auto& [nick, slot] : m_byNick) {
+        bytes += sizeof(std::string) + sizeof(uint32_t) + 2 * sizeof(void*);
+        if (nick.capacity() > 15) bytes += nick.capacity() + 1;
+    }
+    for (const auto& r : m_removals) {
+        bytes += sizeof(Removal);
+        if (r.nick.capacity() > 15) bytes += r.nick.capacity() + 1;
+    }
+    return bytes + m_pool.memoryUsage();
+}
+
+bool UserStore::decodeCID(const std::string& base32, RawCID& out) {
+    return base32Decode(base32, out.data(), out.size());
+}
+
+std::string UserStore::encodeCID(const RawCID& raw) {
+    return base32Encode(raw.data(), raw.size());
+}
+
+} // namespace eiskaltdcpp_py
@@ -0,0 +1,182 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * user_store.h — Compact per-hub user list.
+ *
+ * Replaces the nick → UserInfo map in HubData.  A UserInfo carries six
+ * heap strings, and description / connection / email repeat across
+ * thousands of users on a large hub, so the store keeps:
+ *   - one refcounted, interned copy of each distinct string (StringPool)
+ *   - parallel per-field columns indexed by slot, with freed slots reused
+ *   - the 24-byte CID as raw bytes instead of 39 characters of base32
+ *   - op / bot flags packed in a byte
+ *   - a CID → slot index, so search results can be attributed to a nick
+ *     without asking ClientManager
+ * UserInfo values are materialized only when asked for (getHubUsers,
+ * getUserInfo, batch callbacks).
+ *
+ * Not thread-safe — callers hold the owning hub's HubData::mutex.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "types.h"
+
+namespace eiskaltdcpp_py {
+
+/// Refcounted string interning.  Id 0 is always the empty string.
+class StringPool {
+public:
+    using Id = uint32_t;
+
+    StringPool();
+
+    /// Return the id for s, adding a reference (none for the empty string).
+    Id intern(std::string_view s);
+
+    /// Drop one reference; the entry is freed when the last one goes.
+    void release(Id id);
+
+    const std::string& get(Id id) const { return m_entries[id].str; }
+
+    /// Number of distinct live strings (excluding the empty string).
+    size_t size() const { return m_index.size(); }
+
+    /// Approximate heap bytes held by pooled strings and the index.
+    size_t memoryUsage() const;
+
+    void clear();
+
+private:
+    struct Entry {
+        std::string str;
+        uint32_t refs = 0;
+    };
+
+    // deque: entries never move, so the string_view keys below stay valid
+    std::deque<Entry> m_entries;
+    std::vector<Id> m_free;
+    std::unordered_map<std::string_view, Id> m_index;
+};
+
+/// Columnar nick-keyed user table for one hub.
+class UserStore {
+public:
+    static const size_t CID_SIZE = 24;
+    using RawCID = std::array<uint8_t, CID_SIZE>;
+
+    /// Insert or replace the entry for ui.nick.
+    void upsert(const UserInfo& ui);
+
+    /// Remove nick; returns false if it was not present.
+    bool erase(const std::string& nick);
+
+    void clear();
+    void reserve(size_t n);
+
+    size_t size() const { return m_byNick.size(); }
+    bool empty() const { return m_byNick.empty(); }
+    bool contains(const std::string& nick) const {
+        return m_byNick.count(nick) != 0;
+    }
+
+    /// Materialize one user.  Returns false if nick is unknown.
+    bool get(const std::string& nick, UserInfo& out) const;
+
+    /// Nick of the user with this CID, or nullptr.  Valid until the next
+    /// change to the store.
+    const std::string* nickForCID(const RawCID& cid) const;
+
+    /// Materialize every user, appended to out (unordered).
+    void appendAll(std::vector<UserInfo>& out) const;
+
+    /// Sum of shareSize over all users.
+    int64_t totalShare() const { return m_totalShare; }
+
+    /// Approximate heap bytes held by the store (columns, index, pool).
+    size_t memoryUsage() const;
+
+    /// Monotonic revision, bumped by every upsert / erase / clear.  It is
+    /// never reset, so a revision handed out before clear() stays valid.
+    uint64_t revision() const { return m_revision; }
+
+    /// Users changed and nicks removed after sinceRevision.  Falls back
+    /// to a full list (fullResync) when the removal log no longer reaches
+    /// back that far.
+    void changesSince(uint64_t sinceRevision, UserChanges& out) const;
+
+    /// How many removals are remembered for delta queries.
+    static const size_t MAX_REMOVAL_LOG = 8192;
+
+    /// Base32 (RFC 4648, unpadded) ⇄ raw CID.  decode returns false on
+    /// malformed input and leaves out zeroed.
+    static bool decodeCID(const std::string& base32, RawCID& out);
+    static std::string encodeCID(const RawCID& raw);
+
+private:
+    enum : uint8_t {
+        FLAG_OP      = 1 << 0,
+        FLAG_BOT     = 1 << 1,
+        FLAG_HAS_CID = 1 << 2,
+    };
+
+    struct CIDHash {
+        // CIDs are hash output — any 8 bytes are as good as the rest
+        size_t operator()(const RawCID& c) const {
+            size_t h;
+            memcpy(&h, c.data(), sizeof(h));
+            return h;
+        }
+    };
+
+    uint32_t allocSlot();
+    void releaseStrings(uint32_t slot);
+    void unindexCID(uint32_t slot);
+    void fill(uint32_t slot, UserInfo& out) const;
+
+    // nick → slot.  Node-based map, so each key's address is stable and
+    // m_nick can point at it instead of holding a second copy.
+    std::unordered_map<std::string, uint32_t> m_byNick;
+
+    // CID → slot, for slots with FLAG_HAS_CID.  Last upsert wins if two
+    // nicks share a CID.
+    std::unordered_map<RawCID, uint32_t, CIDHash> m_byCID;
+
+    // Columns, indexed by slot.  m_nick[slot] == nullptr marks a free slot.
+    std::vector<const std::string*> m_nick;
+    std::vector<StringPool::Id> m_description;
+    std::vector<StringPool::Id> m_connection;
+    std::vector<StringPool::Id> m_email;
+    std::vector<RawCID> m_cid;
+    std::vector<int64_t> m_shareSize;
+    std::vector<uint8_t> m_flags;
+    std::vector<uint64_t> m_rev;        // revision of last upsert
+    std::vector<uint32_t> m_freeSlots;
+
+    // Removal log for changesSince(); anything at or below m_logFloor
+    // has been trimmed (or predates a clear) and forces a full resync.
+    struct Removal {
+        uint64_t revision;
+        std::string nick;
+    };
+    std::deque<Removal> m_removals;
+    uint64_t m_revision = 0;
+    uint64_t m_logFloor = 0;
+
+    StringPool m_pool;
+    int64_t m_totalShare = 0;
+};
+
+} // namespace eiskaltdcpp_py
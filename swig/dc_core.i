@@ -16,6 +16,7 @@
 // Standard SWIG includes
 %include <std_string.i>
 %include <std_vector.i>
+%include <std_map.i>
 %include <exception.i>
 %include <stdint.i>
 
@@ -55,6 +56,8 @@
             PyErr_SetString(PyExc_RuntimeError, e.what());
         }
         SWIG_fail;
+    } catch (const std::out_of_range& e) {
+        SWIG_exception(SWIG_IndexError, e.what());
     } catch (const std::exception& e) {
         SWIG_exception(SWIG_RuntimeError, e.what());
     } catch (...) {
@@ -69,7 +72,10 @@
 %{
 #include "types.h"
 #include "callbacks.h"
+#include "search_store.h"
+#include "file_list_walker.h"
 #include "bridge.h"
+#include "base32.h"
 
 using namespace eiskaltdcpp_py;
 %}
@@ -80,13 +86,25 @@ using namespace eiskaltdcpp_py;
 
 namespace std {
     %template(StringVector)         vector<string>;
+    %template(StringMap)            map<string, string>;
     %template(UserInfoVector)       vector<eiskaltdcpp_py::UserInfo>;
     %template(SearchResultVector)   vector<eiskaltdcpp_py::SearchResultInfo>;
     %template(QueueItemVector)      vector<eiskaltdcpp_py::QueueItemInfo>;
+    %template(QueuedSearchVector)   vector<eiskaltdcpp_py::QueuedSearchInfo>;
     %template(HubInfoVector)        vector<eiskaltdcpp_py::HubInfo>;
+    %template(HubMemoryStatsVector) vector<eiskaltdcpp_py::HubMemoryStats>;
     %template(ShareDirVector)       vector<eiskaltdcpp_py::ShareDirInfo>;
     %template(FileListEntryVector)  vector<eiskaltdcpp_py::FileListEntry>;
+    %template(TTHSourceVector)      vector<eiskaltdcpp_py::TTHSource>;
+    %template(QueueAddItemVector)   vector<eiskaltdcpp_py::QueueAddItem>;
     %template(TransferInfoVector)   vector<eiskaltdcpp_py::TransferInfo>;
+    %template(BridgeEventVector)    vector<eiskaltdcpp_py::BridgeEvent>;
+    %template(EventPolicyStatsVector) vector<eiskaltdcpp_py::EventPolicyStats>;
+    %template(ChatEntryVector)      vector<eiskaltdcpp_py::ChatEntry>;
+    %template(ChatLogEntryVector)   vector<eiskaltdcpp_py::ChatLogEntry>;
+    %template(UInt64Vector)         vector<uint64_t>;
+    %template(EventMetricsVector)   vector<eiskaltdcpp_py::EventMetrics>;
+    %template(LockMetricsVector)    vector<eiskaltdcpp_py::LockMetrics>;
 }
 
 // ============================================================================
@@ -143,6 +161,40 @@ namespace std {
     }
 }
 
+// --- HubMemoryStats ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::HubMemoryStats::__str__;
+%extend eiskaltdcpp_py::HubMemoryStats {
+    std::string __str__() {
+        return "HubMemoryStats(url='" + $self->hubUrl +
+               "', id=" + std::to_string($self->hubId) +
+               ", users=" + std::to_string($self->userCount) +
+               ", chat=" + std::to_string($self->chatLines) +
+               ", results=" + std::to_string($self->searchResults) +
+               ", bytes=" + std::to_string($self->totalBytes) + ")";
+    }
+}
+
+// --- FileListEntry ---
+// The TTH travels raw; it is base32-encoded only when Python reads it
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::FileListEntry::__str__;
+%extend eiskaltdcpp_py::FileListEntry {
+    std::string getTTH() const {
+        if (!$self->tth.empty() || !$self->hasRawTTH) return $self->tth;
+        return eiskaltdcpp_py::base32Encode($self->rawTTH.data(),
+                                            $self->rawTTH.size());
+    }
+
+    std::string __str__() {
+        return std::string($self->isDirectory ? "Dir" : "File") +
+               "(path='" + ($self->path.empty() ? $self->name : $self->path) +
+               "', size=" + std::to_string($self->size) + ")";
+    }
+
+    %pythoncode %{
+    tth = property(getTTH)
+    %}
+}
+
 // --- UserInfo ---
 %feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::UserInfo::__str__;
 %extend eiskaltdcpp_py::UserInfo {
@@ -156,6 +208,82 @@ namespace std {
     }
 }
 
+// --- UserChanges ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::UserChanges::__str__;
+%extend eiskaltdcpp_py::UserChanges {
+    std::string __str__() {
+        return "UserChanges(revision=" + std::to_string($self->revision) +
+               ", full=" + ($self->fullResync ? "True" : "False") +
+               ", updated=" + std::to_string($self->updated.size()) +
+               ", removed=" + std::to_string($self->removed.size()) + ")";
+    }
+}
+
+// --- ChatEntry ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::ChatEntry::__str__;
+%extend eiskaltdcpp_py::ChatEntry {
+    std::string __str__() {
+        return "ChatEntry(seq=" + std::to_string($self->seq) +
+               ", nick='" + $self->nick +
+               "', private=" + ($self->isPrivate ? "True" : "False") + ")";
+    }
+}
+
+// --- ChatHistoryPage ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::ChatHistoryPage::__str__;
+%extend eiskaltdcpp_py::ChatHistoryPage {
+    std::string __str__() {
+        return "ChatHistoryPage(lastSeq=" + std::to_string($self->lastSeq) +
+               ", gap=" + ($self->gap ? "True" : "False") +
+               ", entries=" + std::to_string($self->entries.size()) + ")";
+    }
+}
+
+// --- StatusSnapshot ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::StatusSnapshot::__str__;
+%extend eiskaltdcpp_py::StatusSnapshot {
+    std::string __str__() {
+        return "StatusSnapshot(seq=" + std::to_string($self->seq) +
+               ", hubs=" + std::to_string($self->connectedHubs) +
+               "/" + std::to_string($self->hubs) +
+               ", queue=" + std::to_string($self->queueItems) +
+               ", down=" + std::to_string($self->transfers.downloadSpeed) +
+               ", up=" + std::to_string($self->transfers.uploadSpeed) + ")";
+    }
+}
+
+// --- FileListSearchPage ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::FileListSearchPage::__str__;
+%extend eiskaltdcpp_py::FileListSearchPage {
+    std::string __str__() {
+        return "FileListSearchPage(total=" + std::to_string($self->total) +
+               ", hits=" + std::to_string($self->hits.size()) + ")";
+    }
+}
+
+// --- ChatLogEntry ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::ChatLogEntry::__str__;
+%extend eiskaltdcpp_py::ChatLogEntry {
+    std::string __str__() {
+        return "ChatLogEntry(timestamp=" + std::to_string($self->timestamp) +
+               ", kind=" + std::to_string($self->kind) +
+               ", hub='" + $self->hubUrl +
+               "', nick='" + $self->nick + "')";
+    }
+}
+
+// --- BridgeMetrics ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::BridgeMetrics::__str__;
+%extend eiskaltdcpp_py::BridgeMetrics {
+    std::string __str__() {
+        uint64_t raised = 0;
+        for (const auto& e : $self->events) raised += e.raised;
+        return "BridgeMetrics(raised=" + std::to_string(raised) +
+               ", ring_depth=" + std::to_string($self->ring.depth) +
+               ", hubs=" + std::to_string($self->hubs) + ")";
+    }
+}
+
 // --- SearchResultInfo ---
 %feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::SearchResultInfo::__str__;
 %extend eiskaltdcpp_py::SearchResultInfo {
@@ -168,6 +296,18 @@ namespace std {
     }
 }
 
+// --- QueuedSearchInfo ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::QueuedSearchInfo::__str__;
+%extend eiskaltdcpp_py::QueuedSearchInfo {
+    std::string __str__() {
+        return "QueuedSearchInfo(token='" + $self->token +
+               "', query='" + $self->query +
+               "', priority=" + std::to_string($self->priority) +
+               ", pending=" + std::to_string($self->pendingHubs.size()) +
+               ", sent=" + std::to_string($self->sentHubs) + ")";
+    }
+}
+
 // --- QueueItemInfo ---
 %feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::QueueItemInfo::__str__;
 %extend eiskaltdcpp_py::QueueItemInfo {
@@ -178,6 +318,27 @@ namespace std {
     }
 }
 
+// --- QueuePage ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::QueuePage::__str__;
+%extend eiskaltdcpp_py::QueuePage {
+    std::string __str__() {
+        return "QueuePage(revision=" + std::to_string($self->revision) +
+               ", items=" + std::to_string($self->items.size()) +
+               "/" + std::to_string($self->total) + ")";
+    }
+}
+
+// --- QueueChanges ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::QueueChanges::__str__;
+%extend eiskaltdcpp_py::QueueChanges {
+    std::string __str__() {
+        return "QueueChanges(revision=" + std::to_string($self->revision) +
+               ", full=" + ($self->fullResync ? "True" : "False") +
+               ", updated=" + std::to_string($self->updated.size()) +
+               ", removed=" + std::to_string($self->removed.size()) + ")";
+    }
+}
+
 // --- TransferInfo ---
 %feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::TransferInfo::__str__;
 %extend eiskaltdcpp_py::TransferInfo {
@@ -211,6 +372,148 @@ namespace std {
     }
 }
 
+// --- BridgeEvent ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::BridgeEvent::__str__;
+%extend eiskaltdcpp_py::BridgeEvent {
+    std::string __str__() {
+        return "BridgeEvent(type=" + std::to_string($self->type) +
+               ", seq=" + std::to_string($self->seq) +
+               ", hub='" + $self->hubUrl + "')";
+    }
+}
+
+// --- EventQueueStats ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::EventQueueStats::__str__;
+%extend eiskaltdcpp_py::EventQueueStats {
+    std::string __str__() {
+        return "EventQueueStats(depth=" + std::to_string($self->depth) +
+               "/" + std::to_string($self->capacity) +
+               ", queued=" + std::to_string($self->queued) +
+               ", dropped=" + std::to_string($self->dropped) + ")";
+    }
+}
+
+// --- EventPolicyStats ---
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::EventPolicyStats::__str__;
+%extend eiskaltdcpp_py::EventPolicyStats {
+    std::string __str__() {
+        return "EventPolicyStats(type=" + std::to_string($self->type) +
+               ", policy=" + std::to_string($self->policy) +
+               ", delivered=" + std::to_string($self->delivered) +
+               ", dropped=" + std::to_string($self->dropped) +
+               ", coalesced=" + std::to_string($self->coalesced) + ")";
+    }
+}
+
+// --- SearchResultSnapshot ---
+//
+// Zero-copy view over the bridge's result chunks.  Indexing copies one
+// result; the *Column() methods pack a single field for every row into
+// one bytes object (native byte order) for numpy / array / Arrow use.
+%nothread eiskaltdcpp_py::SearchResultSnapshot::sizeColumn;
+%nothread eiskaltdcpp_py::SearchResultSnapshot::freeSlotsColumn;
+%nothread eiskaltdcpp_py::SearchResultSnapshot::totalSlotsColumn;
+%nothread eiskaltdcpp_py::SearchResultSnapshot::isDirectoryColumn;
+%nothread eiskaltdcpp_py::SearchResultSnapshot::tthColumn;
+%feature("python:slot", "tp_str", functype="reprfunc") eiskaltdcpp_py::SearchResultSnapshot::__str__;
+%extend eiskaltdcpp_py::SearchResultSnapshot {
+    std::string __str__() {
+        return "SearchResultSnapshot(token='" + $self->token() +
+               "', results=" + std::to_string($self->size()) + ")";
+    }
+
+    size_t __len__() {
+        return $self->size();
+    }
+
+    /// int64 per row
+    PyObject* sizeColumn() {
+        size_t n = $self->size();
+        PyObject* out = PyBytes_FromStringAndSize(nullptr, n * sizeof(int64_t));
+        if (!out) return nullptr;
+        auto* p = reinterpret_cast<int64_t*>(PyBytes_AS_STRING(out));
+        for (size_t i = 0; i < n; ++i) p[i] = $self->item(i).size;
+        return out;
+    }
+
+    /// int32 per row
+    PyObject* freeSlotsColumn() {
+        size_t n = $self->size();
+        PyObject* out = PyBytes_FromStringAndSize(nullptr, n * sizeof(int32_t));
+        if (!out) return nullptr;
+        auto* p = reinterpret_cast<int32_t*>(PyBytes_AS_STRING(out));
+        for (size_t i = 0; i < n; ++i) p[i] = $self->item(i).freeSlots;
+        return out;
+    }
+
+    /// int32 per row
+    PyObject* totalSlotsColumn() {
+        size_t n = $self->size();
+        PyObject* out = PyBytes_FromStringAndSize(nullptr, n * sizeof(int32_t));
+        if (!out) return nullptr;
+        auto* p = reinterpret_cast<int32_t*>(PyBytes_AS_STRING(out));
+        for (size_t i = 0; i < n; ++i) p[i] = $self->item(i).totalSlots;
+        return out;
+    }
+
+    /// uint8 (0/1) per row
+    PyObject* isDirectoryColumn() {
+        size_t n = $self->size();
+        PyObject* out = PyBytes_FromStringAndSize(nullptr, n);
+        if (!out) return nullptr;
+        auto* p = reinterpret_cast<uint8_t*>(PyBytes_AS_STRING(out));
+        for (size_t i = 0; i < n; ++i) p[i] = $self->item(i).isDirectory ? 1 : 0;
+        return out;
+    }
+
+    /// 24 raw TTH bytes per row (all zero for directories)
+    PyObject* tthColumn() {
+        size_t n = $self->size();
+        PyObject* out = PyBytes_FromStringAndSize(nullptr, n * 24);
+        if (!out) return nullptr;
+        auto* p = reinterpret_cast<uint8_t*>(PyBytes_AS_STRING(out));
+        for (size_t i = 0; i < n; ++i) {
+            const auto& sr = $self->item(i);
+            if (sr.hasRawTTH) {
+                memcpy(p + i * 24, sr.rawTTH.data(), 24);
+            } else {
+                eiskaltdcpp_py::base32Decode(sr.tth, p + i * 24, 24);
+            }
+        }
+        return out;
+    }
+
+    %pythoncode %{
+    def __getitem__(self, key):
+        if isinstance(key, slice):
+            start, stop, step = key.indices(len(self))
+            if stop <= start and step > 0:
+                return []
+            if step == 1:
+                return list(self.slice(start, stop - start))
+            return [self.at(i) for i in range(start, stop, step)]
+        if key < 0:
+            key += len(self)
+        if key < 0:
+            raise IndexError("search result index out of range")
+        return self.at(key)
+
+    def __iter__(self):
+        for i in range(len(self)):
+            yield self.at(i)
+
+    def columns(self):
+        """Typed memoryviews over each numeric column, plus raw TTHs."""
+        return {
+            "size": memoryview(self.sizeColumn()).cast("q"),
+            "freeSlots": memoryview(self.freeSlotsColumn()).cast("i"),
+            "totalSlots": memoryview(self.totalSlotsColumn()).cast("i"),
+            "isDirectory": memoryview(self.isDirectoryColumn()).cast("B"),
+            "tth": self.tthColumn(),
+        }
+    %}
+}
+
 // ============================================================================
 // DCBridge — Main API class
 // ============================================================================
@@ -246,6 +549,11 @@ Example:
 %ignore eiskaltdcpp_py::DCBridge::HubData;
 %ignore eiskaltdcpp_py::DCBridge::findHub;
 %ignore eiskaltdcpp_py::DCBridge::findClient;
+%ignore eiskaltdcpp_py::SearchResultInfo::rawTTH;
+%ignore eiskaltdcpp_py::SearchResultInfo::hasRawTTH;
+%ignore eiskaltdcpp_py::FileListEntry::tth;
+%ignore eiskaltdcpp_py::FileListEntry::rawTTH;
+%ignore eiskaltdcpp_py::FileListEntry::hasRawTTH;
 
 // ============================================================================
 // Include the headers to generate wrappers
@@ -260,6 +568,45 @@ Example:
 
 %include "types.h"
 %include "callbacks.h"
+
+// Only the snapshot's public face — search_store.h itself holds the
+// chunk storage and the store, which Python never touches.
+namespace eiskaltdcpp_py {
+class SearchResultSnapshot {
+public:
+    SearchResultSnapshot();
+    size_t size() const;
+    bool empty() const;
+    const std::string& token() const;
+    SearchResultInfo at(size_t i) const;
+    std::vector<SearchResultInfo> slice(size_t offset, int limit) const;
+};
+
+class FileListWalker {
+public:
+    FileListWalker();
+    std::vector<FileListEntry> next(size_t maxEntries);
+    bool done() const;
+    uint64_t visited() const;
+};
+}
+
+%extend eiskaltdcpp_py::FileListWalker {
+    %pythoncode %{
+    def chunks(self, size=1000):
+        """Yield lists of up to size entries until the walk is done."""
+        while True:
+            chunk = self.next(size)
+            if len(chunk) == 0:
+                return
+            yield list(chunk)
+
+    def __iter__(self):
+        for chunk in self.chunks():
+            yield from chunk
+    %}
+}
+
 %include "bridge.h"
 
 // ============================================================================
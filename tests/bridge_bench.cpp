@@ -0,0 +1,384 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * bridge_bench.cpp — Synthetic load for the bridge hot paths.
+ *
+ * Drives BridgeListeners' on(...) overloads directly with made-up users,
+ * search results and chat on hubs that are never connected, then times
+ * the API accessors over the data that produced.  Each phase reports
+ * throughput, p50 / p99 / max latency per call and heap allocations per
+ * call (operator new on the calling thread).
+ *
+ * Events go to a no-op C++ callback, so the numbers cover the bridge's
+ * own work — conversion, stashing, policies, dispatch — without Python.
+ * With --queued they go through the event ring instead, drained between
+ * phases.
+ *
+ * Build with -DBUILD_BENCHMARKS=ON, then:
+ *   bridge_bench [--hubs N] [--users N] [--results N] [--chat N]
+ *                [--queue N] [--files N] [--iterations N] [--queued]
+ * --users and --chat are per hub; the default sizes resemble a busy
+ * public hub.
+ */
+
+#include "bridge.h"
+#include "bridge_listeners.h"
+#include "callbacks.h"
+
+#include <dcpp/CID.h>
+#include <dcpp/ClientManager.h>
+#include <dcpp/MerkleTree.h>
+#include <dcpp/SearchResult.h>
+#include <dcpp/User.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+// =========================================================================
+// Allocation counting
+// =========================================================================
+
+// Counted per thread, so dcpp's own threads do not show up in a phase
+static thread_local uint64_t t_allocs = 0;
+
+void* operator new(std::size_t n) {
+    ++t_allocs;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace eiskaltdcpp_py {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    int hubs = 4;
+    int users = 10000;
+    int results = 50000;
+    int chat = 20000;
+    int queue = 20000;
+    int files = 20000;
+    int iterations = 200;
+    bool queued = false;
+};
+
+class NullCallback : public DCClientCallback {};
+
+/// Times n calls of f(i) and prints one report line.
+class Phase {
+public:
+    template <typename F>
+    static void run(const char* name, size_t n, F&& f) {
+        std::vector<uint64_t> ns;
+        ns.reserve(n);
+        uint64_t allocs0 = t_allocs;
+        auto start = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            auto t0 = Clock::now();
+            f(i);
+            ns.push_back(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - t0).count()));
+        }
+        double secs = std::chrono::duration<double>(Clock::now() - start)
+                          .count();
+        // The samples were reserved up front, so only f() is counted
+        uint64_t allocs = t_allocs - allocs0;
+        report(name, ns, secs, allocs);
+    }
+
+private:
+    static void report(const char* name, std::vector<uint64_t>& ns,
+                       double secs, uint64_t allocs) {
+        if (ns.empty()) return;
+        std::sort(ns.begin(), ns.end());
+        auto pct = [&](double p) {
+            return ns[std::min(ns.size() - 1,
+                               static_cast<size_t>(p * ns.size()))];
+        };
+        printf("%-28s %9zu ops %12.0f ops/s  p50 %8.2f us  p99 %8.2f us"
+               "  max %9.2f us  %7.2f allocs/op\n",
+               name, ns.size(), ns.size() / secs, pct(0.50) / 1e3,
+               pct(0.99) / 1e3, ns.back() / 1e3,
+               static_cast<double>(allocs) / ns.size());
+    }
+};
+
+std::string randomTTH() {
+    uint8_t raw[24];
+    for (auto& b : raw) b = static_cast<uint8_t>(std::rand());
+    return base32Encode(raw, sizeof(raw));
+}
+
+} // namespace
+
+/// Friend of DCBridge: publishes hubs and queue items without a hub
+/// connection or a real download queue.
+class BridgeBench {
+public:
+    static dcpp::Client* addHub(DCBridge& bridge, const std::string& url) {
+        // getClient() only creates the client; it is never connected
+        dcpp::Client* client = dcpp::ClientManager::getInstance()->getClient(url);
+        auto hd = std::make_shared<DCBridge::HubData>();
+        hd->client = client;
+        hd->chatHistory.setCapacity(bridge.m_chatCapacity.load());
+        hd->cachedInfo.url = url;
+        std::unique_lock<std::shared_mutex> lock(bridge.m_hubsMutex);
+        hd->id = bridge.m_nextHubId++;
+        hd->cachedInfo.hubId = hd->id;
+        bridge.m_hubsByClient[client] = hd;
+        bridge.m_hubs[url] = std::move(hd);
+        return client;
+    }
+
+    static void fillQueue(DCBridge& bridge, int n) {
+        std::lock_guard<std::mutex> lock(bridge.m_queueMutex);
+        for (int i = 0; i < n; ++i) {
+            QueueItemInfo info;
+            info.target = "/downloads/bench/dir" + std::to_string(i % 100) +
+                          "/file" + std::to_string(i) + ".bin";
+            info.filename = "file" + std::to_string(i) + ".bin";
+            info.size = 1000000 + i;
+            info.tth = randomTTH();
+            info.priority = 3;
+            info.sources = 1;
+            bridge.m_queue.upsert(std::move(info));
+        }
+    }
+};
+
+namespace {
+
+/// A plain-XML file list of n files in 100 directories.  Returns its id.
+std::string writeFileList(int n) {
+    std::string id = "bench." + dcpp::CID::generate().toBase32() + ".xml";
+    std::ofstream out(dcpp::Util::getListPath() + id);
+    out << "<?xml version=\"1.0\" encoding=\"utf-8\" standalone=\"yes\"?>\n"
+           "<FileListing Version=\"1\" Base=\"/\" Generator=\"bridge_bench\">\n";
+    int dirs = 100;
+    for (int d = 0; d < dirs; ++d) {
+        out << "<Directory Name=\"dir" << d << "\">\n";
+        for (int i = d; i < n; i += dirs) {
+            out << "<File Name=\"file" << i << ".bin\" Size=\"" << 1000 + i
+                << "\" TTH=\"" << randomTTH() << "\"/>\n";
+        }
+        out << "</Directory>\n";
+    }
+    out << "</FileListing>\n";
+    return id;
+}
+
+/// Let the Second tick flush coalesced events and drain the ring, so
+/// every phase starts empty.
+void settle(DCBridge& bridge, BridgeListeners& listeners, uint64_t& tick) {
+    tick += 1000;
+    listeners.on(dcpp::TimerManagerListener::Second(), tick);
+    while (!bridge.pollEvents(0).empty()) {}
+}
+
+bool parseArgs(int argc, char** argv, Options& opts) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&](int& out) {
+            if (i + 1 >= argc) return false;
+            out = std::atoi(argv[++i]);
+            return out > 0;
+        };
+        bool ok = true;
+        if (arg == "--hubs") ok = value(opts.hubs);
+        else if (arg == "--users") ok = value(opts.users);
+        else if (arg == "--results") ok = value(opts.results);
+        else if (arg == "--chat") ok = value(opts.chat);
+        else if (arg == "--queue") ok = value(opts.queue);
+        else if (arg == "--files") ok = value(opts.files);
+        else if (arg == "--iterations") ok = value(opts.iterations);
+        else if (arg == "--queued") opts.queued = true;
+        else ok = false;
+        if (!ok) {
+            fprintf(stderr, "usage: %s [--hubs N] [--users N] [--results N]"
+                    " [--chat N] [--queue N] [--files N] [--iterations N]"
+                    " [--queued]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+} // namespace eiskaltdcpp_py
+
+int main(int argc, char** argv) {
+    using namespace eiskaltdcpp_py;
+
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) return 2;
+    std::srand(1);
+
+    char dir[] = "/tmp/bridge_bench.XXXXXX";
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+
+    DCBridge bridge;
+    if (!bridge.initialize(dir)) {
+        fprintf(stderr, "bridge_bench: initialize(%s) failed\n", dir);
+        return 1;
+    }
+    NullCallback callback;
+    bridge.setCallback(&callback);
+    if (opts.queued) bridge.setDispatchMode(DISPATCH_QUEUED, 1 << 20);
+    bridge.setSearchLimits(opts.results, 64, 0);
+
+    auto& listeners = BridgeListeners::getInstance();
+    uint64_t tick = 0;
+
+    printf("bridge_bench: %d hubs x %d users, %d results, %d chat lines/hub,"
+           " %d queued, %d listed files%s\n\n",
+           opts.hubs, opts.users, opts.results, opts.chat, opts.queue,
+           opts.files, opts.queued ? ", queued dispatch" : "");
+
+    // ----- Synthetic hubs and users (untimed) -----
+
+    std::vector<dcpp::Client*> clients;
+    std::vector<std::string> urls;
+    std::vector<dcpp::OnlineUser*> users;   // hub-major; never freed
+    for (int h = 0; h < opts.hubs; ++h) {
+        urls.push_back("dchub://bench-" + std::to_string(h) + ".invalid:411");
+        dcpp::Client* c = BridgeBench::addHub(bridge, urls.back());
+        clients.push_back(c);
+        for (int u = 0; u < opts.users; ++u) {
+            dcpp::UserPtr user(new dcpp::User(dcpp::CID::generate()));
+            auto* ou = new dcpp::OnlineUser(user, *c, u + 1);
+            auto& id = ou->getIdentity();
+            id.set("NI", "user" + std::to_string(u));
+            id.set("DE", "bench user");
+            id.set("CO", "100");
+            id.set("EM", "");
+            id.set("SS", std::to_string(1000000000LL + u));
+            users.push_back(ou);
+        }
+    }
+    auto hubOf = [&](size_t i) { return clients[i / opts.users]; };
+
+    // ----- Listener event storms -----
+
+    Phase::run("UserUpdated (join)", users.size(), [&](size_t i) {
+        listeners.on(dcpp::ClientListener::UserUpdated(), hubOf(i),
+                     *users[i]);
+    });
+    settle(bridge, listeners, tick);
+
+    Phase::run("UserUpdated (update)", users.size(), [&](size_t i) {
+        listeners.on(dcpp::ClientListener::UserUpdated(), hubOf(i),
+                     *users[i]);
+    });
+    settle(bridge, listeners, tick);
+
+    const size_t batch = 100;
+    Phase::run("UsersUpdated (x100)", users.size() / batch, [&](size_t i) {
+        dcpp::OnlineUserList list;
+        for (size_t j = i * batch; j < (i + 1) * batch; ++j) {
+            list.push_back(users[j]);
+        }
+        listeners.on(dcpp::ClientListener::UsersUpdated(),
+                     hubOf(i * batch), list);
+    });
+    settle(bridge, listeners, tick);
+
+    std::vector<dcpp::SearchResultPtr> results;
+    results.reserve(opts.results);
+    for (int r = 0; r < opts.results; ++r) {
+        size_t u = static_cast<size_t>(r) % users.size();
+        results.push_back(dcpp::SearchResultPtr(new dcpp::SearchResult(
+            users[u]->getUser(), dcpp::SearchResult::TYPE_FILE, 5, 2,
+            1000000 + r, "share\\music\\track" + std::to_string(r) + ".mp3",
+            "Bench hub", urls[u / opts.users], "127.0.0.1",
+            dcpp::TTHValue(randomTTH()), "")));
+    }
+    Phase::run("SR", results.size(), [&](size_t i) {
+        listeners.on(dcpp::SearchManagerListener::SR(), results[i]);
+    });
+    settle(bridge, listeners, tick);
+
+    Phase::run("Message (chat)", static_cast<size_t>(opts.chat) * opts.hubs,
+               [&](size_t i) {
+        dcpp::Client* c = clients[i % opts.hubs];
+        dcpp::OnlineUser* from = users[(i % opts.hubs) * opts.users +
+                                       (i / opts.hubs) % opts.users];
+        dcpp::ChatMessage msg = {"chat line " + std::to_string(i) +
+                                 " with a typical amount of text in it",
+                                 from, nullptr, nullptr, false, 0};
+        listeners.on(dcpp::ClientListener::Message(), c, msg);
+    });
+    settle(bridge, listeners, tick);
+
+    // ----- API accessors at those sizes -----
+
+    printf("\n");
+    BridgeBench::fillQueue(bridge, opts.queue);
+    std::string listId = writeFileList(opts.files);
+    bool listOpen = bridge.openFileList(listId);
+    size_t n = static_cast<size_t>(opts.iterations);
+
+    Phase::run("getHubUsers", n, [&](size_t i) {
+        bridge.getHubUsers(urls[i % urls.size()]);
+    });
+    Phase::run("getSearchResults(\"\")", n, [&](size_t) {
+        bridge.getSearchResults("");
+    });
+    Phase::run("getSearchResults(page)", n, [&](size_t i) {
+        bridge.getSearchResults("", static_cast<int>(i * 100 % opts.results),
+                                100);
+    });
+    Phase::run("listHubs", n, [&](size_t) { bridge.listHubs(); });
+    Phase::run("listQueue", n, [&](size_t) { bridge.listQueue(); });
+    if (listOpen) {
+        Phase::run("browseFileList", n, [&](size_t i) {
+            bridge.browseFileList(listId, "/dir" + std::to_string(i % 100));
+        });
+        Phase::run("walkFileList(1000)", std::max<size_t>(1, n / 100),
+                   [&](size_t) {
+            FileListWalker walker = bridge.walkFileList(listId);
+            while (!walker.next(1000).empty()) {}
+        });
+        Phase::run("searchFileLists(page)", n, [&](size_t i) {
+            bridge.searchFileLists("file" + std::to_string(i % 10), 0, 0, 0,
+                                   0, 100);
+        });
+    } else {
+        fprintf(stderr, "bridge_bench: could not open %s, skipping"
+                " file-list phases\n", listId.c_str());
+    }
+
+    // ----- Parts -----
+
+    printf("\n");
+    Phase::run("UserRemoved", users.size(), [&](size_t i) {
+        listeners.on(dcpp::ClientListener::UserRemoved(), hubOf(i),
+                     *users[i]);
+    });
+    settle(bridge, listeners, tick);
+
+    bridge.setCallback(nullptr);
+    bridge.shutdown();
+    return 0;
+}
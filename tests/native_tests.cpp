@@ -0,0 +1,698 @@
+/*
+ * eiskaltdcpp-py — Python SWIG bindings for libeiskaltdcpp
+ *
+ * Copyright (C) 2026 Verlihub Team
+ * Licensed under GPL-3.0-or-later
+ *
+ * native_tests.cpp — Behaviour checks for the bridge's self-contained
+ *                    stores and schedulers.
+ *
+ * These classes touch neither dcpp nor Python, so they are compiled in
+ * straight from src/ and exercised without a hub.  Each group is one
+ * ctest test:
+ *   native_tests [group...]     (no argument runs every group)
+ * A failed CHECK prints its location and fails the run; the group
+ * carries on so one run reports every broken expectation.
+ */
+
+#include "chat_log.h"
+#include "queue_store.h"
+#include "search_scheduler.h"
+#include "tth_index.h"
+#include "user_store.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace eiskaltdcpp_py {
+
+namespace {
+
+int g_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", \
+                     __FILE__, __LINE__, #cond); \
+        ++g_failures; \
+    } \
+} while (0)
+
+/// Scratch directory, removed with everything in it on destruction.
+class TempDir {
+public:
+    TempDir() {
+        const char* base = std::getenv("TMPDIR");
+        std::string tmpl = std::string(base && *base ? base : "/tmp") +
+                           "/dcpy-native-XXXXXX";
+        std::vector<char> buf(tmpl.begin(), tmpl.end());
+        buf.push_back('\0');
+        if (mkdtemp(buf.data())) m_path = buf.data();
+    }
+
+    ~TempDir() {
+        if (m_path.empty()) return;
+        std::string cmd = "rm -rf '" + m_path + "'";
+        if (std::system(cmd.c_str()) != 0) {
+            std::fprintf(stderr, "could not remove %s\n", m_path.c_str());
+        }
+    }
+
+    bool ok() const { return !m_path.empty(); }
+    std::string file(const std::string& name) const {
+        return m_path + "/" + name;
+    }
+
+private:
+    std::string m_path;
+};
+
+// =========================================================================
+// TTHIndex
+// =========================================================================
+
+TTHIndex::RawTTH tthOf(unsigned n) {
+    TTHIndex::RawTTH t{};
+    for (size_t i = 0; i < t.size(); ++i) {
+        t[i] = static_cast<uint8_t>((n * 131u + i * 7u) ^ (n >> (i % 24)));
+    }
+    return t;
+}
+
+std::vector<std::string> sourcesOf(const TTHIndex& idx, unsigned n) {
+    std::vector<const TTHIndex::Source*> found;
+    idx.find(tthOf(n), found);
+    std::vector<std::string> ids;
+    for (auto* s : found) ids.push_back(s->fileListId);
+    return ids;
+}
+
+TTHIndex::Source sourceNamed(const std::string& id, int64_t mtime = 0) {
+    TTHIndex::Source src;
+    src.fileListId = id;
+    src.mtime = mtime;
+    src.fileSize = mtime * 10;
+    return src;
+}
+
+void testTTHIndex() {
+    TTHIndex idx;
+    idx.setSource(sourceNamed("a.xml.bz2", 1), {tthOf(1), tthOf(2), tthOf(2)});
+    idx.setSource(sourceNamed("b.xml.bz2", 2), {tthOf(2), tthOf(3)});
+    CHECK(idx.sourceCount() == 2);
+    CHECK(idx.tthCount() == 3);
+    CHECK(idx.dirty());
+
+    // Duplicates within a source collapse; chains are newest first
+    CHECK(sourcesOf(idx, 1) == std::vector<std::string>{"a.xml.bz2"});
+    CHECK((sourcesOf(idx, 2) ==
+           std::vector<std::string>{"b.xml.bz2", "a.xml.bz2"}));
+    CHECK(sourcesOf(idx, 4).empty());
+
+    // Replacing a source drops its old TTHs
+    idx.setSource(sourceNamed("a.xml.bz2", 5), {tthOf(4)});
+    CHECK(sourcesOf(idx, 1).empty());
+    CHECK(sourcesOf(idx, 2) == std::vector<std::string>{"b.xml.bz2"});
+    CHECK(sourcesOf(idx, 4) == std::vector<std::string>{"a.xml.bz2"});
+    CHECK(idx.source("a.xml.bz2") && idx.source("a.xml.bz2")->mtime == 5);
+
+    CHECK(idx.removeSource("b.xml.bz2"));
+    CHECK(!idx.removeSource("b.xml.bz2"));
+    CHECK(idx.source("b.xml.bz2") == nullptr);
+    CHECK(sourcesOf(idx, 3).empty());
+
+    // Churn far past the compaction threshold: lookups must stay exact
+    // and TTHs nobody has any more must leave the hash
+    for (unsigned round = 0; round < 50; ++round) {
+        std::vector<TTHIndex::RawTTH> tths;
+        for (unsigned i = 0; i < 20; ++i) tths.push_back(tthOf(100 + round + i));
+        idx.setSource(sourceNamed("churn.xml.bz2", round), std::move(tths));
+    }
+    CHECK(idx.sourceCount() == 2);
+    CHECK(idx.tthCount() <= 1 + 20 + 20);
+    CHECK(sourcesOf(idx, 100).empty());
+    CHECK(sourcesOf(idx, 149 + 19) ==
+          std::vector<std::string>{"churn.xml.bz2"});
+    CHECK(sourcesOf(idx, 4) == std::vector<std::string>{"a.xml.bz2"});
+
+    // Round trip through disk
+    TempDir dir;
+    CHECK(dir.ok());
+    std::string path = dir.file("tth.idx");
+    CHECK(idx.save(path));
+    CHECK(!idx.dirty());
+
+    TTHIndex loaded;
+    CHECK(loaded.load(path));
+    CHECK(!loaded.dirty());
+    CHECK(loaded.sourceCount() == idx.sourceCount());
+    // Only live TTHs are written: a's one and churn's last twenty
+    CHECK(loaded.tthCount() == 21);
+    CHECK(sourcesOf(loaded, 4) == std::vector<std::string>{"a.xml.bz2"});
+    CHECK(sourcesOf(loaded, 160) ==
+          std::vector<std::string>{"churn.xml.bz2"});
+    const TTHIndex::Source* churn = loaded.source("churn.xml.bz2");
+    CHECK(churn && churn->mtime == 49 && churn->fileSize == 490);
+
+    // A truncated file loads nothing rather than part of the sources
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)),
+                          std::istreambuf_iterator<char>());
+        std::ofstream out(dir.file("short.idx"), std::ios::binary);
+        out.write(bytes.data(), bytes.size() - 5);
+    }
+    CHECK(!loaded.load(dir.file("short.idx")));
+    CHECK(loaded.sourceCount() == 0 && loaded.tthCount() == 0);
+    {
+        std::ofstream out(dir.file("foreign.idx"), std::ios::binary);
+        out << "not an index at all";
+    }
+    CHECK(!loaded.load(dir.file("foreign.idx")));
+    CHECK(!loaded.load(dir.file("missing.idx")));
+
+    // Base32 round trip, and rejection of anything non-canonical
+    std::string text = TTHIndex::encodeTTH(tthOf(7));
+    CHECK(text.size() == 39);
+    TTHIndex::RawTTH raw{};
+    CHECK(TTHIndex::decodeTTH(text, raw) && raw == tthOf(7));
+    CHECK(!TTHIndex::decodeTTH(text.substr(1), raw));
+    CHECK(!TTHIndex::decodeTTH(std::string(39, '1'), raw));
+}
+
+// =========================================================================
+// ChatLog
+// =========================================================================
+
+bool fileExists(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0;
+}
+
+int64_t fileSize(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 ? st.st_size : -1;
+}
+
+void testChatLog() {
+    TempDir dir;
+    CHECK(dir.ok());
+    ChatLog::Options opts;
+    opts.directory = dir.file("logs/chat/");     // created, slash trimmed
+    opts.fsyncIntervalMs = 0;
+
+    ChatLog log;
+    log.append(CHAT_LOG_CHAT, "hub", "early", "", "lost", 1, false);
+    CHECK(log.recordsLogged() == 0);             // closed: a no-op
+    CHECK(log.open(opts));
+
+    // Two hubs, one record a second; query() sees unflushed records
+    for (int t = 100; t < 200; ++t) {
+        log.append(t % 2 ? CHAT_LOG_CHAT : CHAT_LOG_PRIVATE,
+                   t % 2 ? "dchub://a" : "dchub://b", "nick" +
+                   std::to_string(t), t % 2 ? "" : "me",
+                   "line " + std::to_string(t), t, t == 101);
+    }
+    CHECK(log.recordsLogged() == 100);
+
+    std::vector<ChatLogEntry> all = log.query("", 0, 0, 0);
+    CHECK(all.size() == 100);
+    CHECK(!all.empty() && all.front().timestamp == 100 &&
+          all.back().timestamp == 199);
+
+    std::vector<ChatLogEntry> range = log.query("", 120, 130, 0);
+    CHECK(range.size() == 10);
+    CHECK(!range.empty() && range.front().timestamp == 120 &&
+          range.back().timestamp == 129);
+
+    std::vector<ChatLogEntry> hubA = log.query("dchub://a", 0, 0, 5);
+    CHECK(hubA.size() == 5);
+    CHECK(!hubA.empty() && hubA[0].timestamp == 101 && hubA[0].thirdPerson &&
+          hubA[0].nick == "nick101" && hubA[0].text == "line 101" &&
+          hubA[0].kind == CHAT_LOG_CHAT);
+    CHECK(hubA.size() > 1 && !hubA[1].thirdPerson);
+
+    std::vector<ChatLogEntry> pms = log.query("dchub://b", 190, 0, 0);
+    CHECK(pms.size() == 5);
+    CHECK(!pms.empty() && pms[0].to == "me" &&
+          pms[0].kind == CHAT_LOG_PRIVATE);
+    CHECK(log.query("dchub://none", 0, 0, 0).empty());
+    log.close();
+
+    // Tear the last record the way a crash mid-write would
+    std::string segment = opts.directory.substr(0, opts.directory.size() - 1) +
+                          "/chat-00000001.dclog";
+    CHECK(fileExists(segment));
+    int64_t whole = fileSize(segment);
+    {
+        std::ofstream out(segment, std::ios::binary | std::ios::app);
+        uint32_t length = 500;                  // claims more than follows
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write("\0\0\0\0\0\0\0\0\0\0", 10);
+    }
+    CHECK(fileSize(segment) == whole + 14);
+
+    // Readable up to the tear, even before it is repaired
+    CHECK(log.query("", 0, 0, 0).size() == 100);
+
+    // Reopening cuts the torn tail off and appends after the last record
+    CHECK(log.open(opts));
+    CHECK(fileSize(segment) == whole);
+    log.append(CHAT_LOG_STATUS, "dchub://a", "", "", "after the crash", 300,
+               false);
+    log.flush(0, true);
+    all = log.query("", 0, 0, 0);
+    CHECK(all.size() == 101);
+    CHECK(!all.empty() && all.back().text == "after the crash" &&
+          all.back().kind == CHAT_LOG_STATUS);
+    log.close();
+
+    // Rotation: small segments, only the newest three kept
+    TempDir rotDir;
+    ChatLog::Options rot;
+    rot.directory = rotDir.file("rot");
+    rot.maxSegmentBytes = 512;
+    rot.maxSegments = 3;
+    rot.fsyncIntervalMs = 0;
+    CHECK(log.open(rot));
+    for (int t = 1; t <= 60; ++t) {
+        log.append(CHAT_LOG_CHAT, "dchub://a", "n", "",
+                   "message number " + std::to_string(t), t, false);
+        if (t % 5 == 0) log.flush(t, false);
+    }
+    log.flush(61, true);
+    CHECK(!fileExists(rot.directory + "/chat-00000001.dclog"));
+    std::vector<ChatLogEntry> kept = log.query("", 0, 0, 0);
+    CHECK(!kept.empty() && kept.back().timestamp == 60);
+    bool ordered = true;
+    for (size_t i = 1; i < kept.size(); ++i) {
+        if (kept[i].timestamp != kept[i - 1].timestamp + 1) ordered = false;
+    }
+    CHECK(ordered);
+    // A range starting past the older segments still finds its records
+    std::vector<ChatLogEntry> tail = log.query("", 58, 0, 0);
+    CHECK(tail.size() == 3);
+    CHECK(!tail.empty() && tail.front().timestamp == 58);
+    CHECK(log.recordsDropped() == 0);
+}
+
+// =========================================================================
+// SearchScheduler
+// =========================================================================
+
+SearchScheduler::Request searchFor(const std::string& token,
+                                   const std::string& query,
+                                   int priority = 0, int fileType = 0) {
+    SearchScheduler::Request req;
+    req.token = token;
+    req.query = query;
+    req.priority = priority;
+    req.fileType = fileType;
+    return req;
+}
+
+/// "token:hub,hub" per dispatch, in dispatch order.
+std::vector<std::string> describe(
+        const std::vector<SearchScheduler::Dispatch>& ds) {
+    std::vector<std::string> out;
+    for (const auto& d : ds) {
+        std::string s = d.request.token + ":";
+        for (size_t i = 0; i < d.hubs.size(); ++i) {
+            s += (i ? "," : "") + d.hubs[i];
+        }
+        out.push_back(s);
+    }
+    return out;
+}
+
+void testSearchScheduler() {
+    using Strings = std::vector<std::string>;
+    const std::unordered_set<std::string> hubs = {"a", "b", "c"};
+
+    // Priority first, FIFO within a priority, one search per hub per
+    // interval, ready hubs of one search sent together
+    SearchScheduler sched;
+    sched.setInterval(1000);
+    CHECK(sched.enqueue(searchFor("s1", "ubuntu"), {"a", "b"}, 0) == "s1");
+    CHECK(sched.enqueue(searchFor("s2", "debian", 5), {"a"}, 0) == "s2");
+    CHECK(sched.enqueue(searchFor("s3", "arch"), {"a"}, 0) == "s3");
+    CHECK(sched.enqueue(searchFor("s4", "none"), {}, 0).empty());
+    CHECK(sched.size() == 3);
+
+    CHECK((describe(sched.due(0, hubs, hubs)) == Strings{"s2:a", "s1:b"}));
+    CHECK(sched.due(999, hubs, hubs).empty());
+    CHECK(describe(sched.due(1000, hubs, hubs)) == Strings{"s1:a"});
+    CHECK(describe(sched.due(2000, hubs, hubs)) == Strings{"s3:a"});
+    CHECK(sched.size() == 0);
+
+    // Offline hubs wait, forgotten hubs are dropped
+    sched.enqueue(searchFor("s5", "waits"), {"b", "c"}, 3000);
+    CHECK(describe(sched.due(3000, hubs, {"a"})).empty());
+    CHECK(sched.size() == 1);
+    CHECK(describe(sched.due(3000, {"a", "b"}, {"a", "b"})) ==
+          Strings{"s5:b"});
+    CHECK(sched.size() == 0);
+
+    // A direct search keeps queued ones at a distance
+    sched.noteSent({"c"}, 4000);
+    sched.enqueue(searchFor("s6", "later"), {"c"}, 4000);
+    CHECK(sched.due(4500, hubs, hubs).empty());
+    CHECK(describe(sched.due(5000, hubs, hubs)) == Strings{"s6:c"});
+
+    // Floods double the interval up to 8x; ten clean sends ease a step
+    CHECK(sched.hubInterval("a") == 1000);
+    sched.noteFlood("a", 10000);
+    CHECK(sched.hubInterval("a") == 2000);
+    sched.enqueue(searchFor("s7", "after flood"), {"a"}, 10000);
+    CHECK(sched.due(11999, hubs, hubs).empty());
+    CHECK(describe(sched.due(12000, hubs, hubs)) == Strings{"s7:a"});
+    for (int i = 0; i < 5; ++i) sched.noteFlood("a", 12000);
+    CHECK(sched.hubInterval("a") == 8000);
+    for (int i = 0; i < 10; ++i) sched.noteSent({"a"}, 20000 + i);
+    CHECK(sched.hubInterval("a") == 4000);
+    CHECK(sched.hubInterval("b") == 1000);
+
+    // Cancelling removes a pending search
+    sched.enqueue(searchFor("s8", "cancel me"), {"b"}, 30000);
+    CHECK(sched.cancel("s8"));
+    CHECK(!sched.cancel("s8"));
+    CHECK(sched.size() == 0);
+
+    // TTH searches: pending ones merge hubs and take the higher
+    // priority, matching case-insensitively with or without "TTH:"
+    const std::string tth(39, 'A');
+    SearchScheduler dedup;
+    dedup.setInterval(1000);
+    dedup.enqueue(searchFor("plain", "plain"), {"a"}, 0);
+    CHECK(dedup.enqueue(searchFor("t1", "TTH:" + tth, 0, 8), {"a"}, 0) ==
+          "t1");
+    std::string lower(39, 'a');
+    CHECK(dedup.enqueue(searchFor("t2", lower, 9, 8), {"b"}, 0) == "t1");
+    CHECK(dedup.size() == 2);
+    std::vector<QueuedSearchInfo> queued = dedup.pending();
+    CHECK(!queued.empty() && queued[0].token == "t1" &&
+          queued[0].priority == 9 &&
+          queued[0].pendingHubs == Strings({"a", "b"}));
+    CHECK((describe(dedup.due(0, hubs, hubs)) == Strings{"t1:a,b"}));
+    CHECK(describe(dedup.due(1000, hubs, hubs)) == Strings{"plain:a"});
+
+    // ...and one sent to the same hubs within a minute is not repeated
+    CHECK(dedup.enqueue(searchFor("t3", tth, 0, 8), {"b"}, 30000) == "t1");
+    CHECK(dedup.size() == 0);
+    CHECK(dedup.enqueue(searchFor("t4", tth, 0, 8), {"b", "c"}, 30000) ==
+          "t4");
+    CHECK(describe(dedup.due(30000, hubs, hubs)) == Strings{"t4:b,c"});
+    CHECK(dedup.enqueue(searchFor("t5", tth, 0, 8), {"b"}, 90000) == "t5");
+    // Non-TTH searches are never merged
+    CHECK(dedup.enqueue(searchFor("p2", "plain"), {"a"}, 90000) == "p2");
+    CHECK(dedup.size() == 2);
+}
+
+// =========================================================================
+// QueueStore
+// =========================================================================
+
+QueueItemInfo queueItem(const std::string& target, int64_t downloaded = 0) {
+    QueueItemInfo q;
+    q.target = target;
+    q.filename = target.substr(target.rfind('/') + 1);
+    q.size = 1000;
+    q.downloadedBytes = downloaded;
+    return q;
+}
+
+/// A client-side copy kept current the documented way.
+struct QueueMirror {
+    std::map<std::string, int64_t> items;     // target → downloadedBytes
+    uint64_t revision = 0;
+
+    bool resync(const QueueStore& store) {
+        QueueChanges ch;
+        store.changesSince(revision, ch);
+        if (ch.fullResync) items.clear();
+        for (const auto& t : ch.removed) items.erase(t);
+        for (const auto& q : ch.updated) items[q.target] = q.downloadedBytes;
+        revision = ch.revision;
+        return ch.fullResync;
+    }
+
+    bool matches(const QueueStore& store) const {
+        std::vector<QueueItemInfo> all;
+        store.appendAll(all);
+        std::map<std::string, int64_t> expect;
+        for (const auto& q : all) expect[q.target] = q.downloadedBytes;
+        return items == expect;
+    }
+};
+
+void testQueueStore() {
+    QueueStore store;
+    store.reset({queueItem("/dl/c"), queueItem("/dl/a"), queueItem("/dl/b")});
+    CHECK(store.size() == 3);
+
+    QueueMirror mirror;
+    CHECK(mirror.resync(store));                // first sync is always full
+    CHECK(mirror.matches(store));
+
+    // An unchanged upsert (SourcesUpdated noise) is not a revision
+    uint64_t rev = store.revision();
+    store.upsert(queueItem("/dl/a"));
+    CHECK(store.revision() == rev);
+    QueueChanges none;
+    store.changesSince(rev, none);
+    CHECK(!none.fullResync && none.updated.empty() && none.removed.empty());
+
+    // Adds, changes, removals and a remove + re-add all come through
+    store.upsert(queueItem("/dl/d"));
+    store.upsert(queueItem("/dl/a", 500));
+    CHECK(store.erase("/dl/b"));
+    CHECK(!store.erase("/dl/b"));
+    CHECK(store.erase("/dl/c"));
+    store.upsert(queueItem("/dl/c", 7));
+    QueueChanges delta;
+    store.changesSince(mirror.revision, delta);
+    CHECK(!delta.fullResync);
+    CHECK(delta.updated.size() == 3);           // d, a, and c again
+    CHECK(delta.removed.size() == 2);
+    CHECK(!mirror.resync(store));
+    CHECK(mirror.matches(store));
+    CHECK(mirror.items["/dl/c"] == 7 && mirror.items["/dl/a"] == 500);
+
+    // A revision from the future (another store) gets everything
+    QueueChanges future;
+    store.changesSince(store.revision() + 10, future);
+    CHECK(future.fullResync && future.updated.size() == store.size());
+
+    // Pages follow target order
+    QueuePage page;
+    store.page(1, 2, page);
+    CHECK(page.total == 3 && page.revision == store.revision());
+    CHECK(page.items.size() == 2 && page.items[0].target == "/dl/c" &&
+          page.items[1].target == "/dl/d");
+    store.page(3, 10, page);
+    CHECK(page.items.empty() && page.total == 3);
+
+    // A client that fell behind the removal log resyncs in full
+    std::vector<QueueItemInfo> many;
+    for (size_t i = 0; i <= QueueStore::MAX_REMOVAL_LOG; ++i) {
+        many.push_back(queueItem("/bulk/" + std::to_string(i)));
+    }
+    for (auto& q : many) store.upsert(q);
+    CHECK(!mirror.resync(store));
+    CHECK(mirror.matches(store));
+    uint64_t behind = mirror.revision;
+    for (auto& q : many) store.erase(q.target);
+    QueueChanges lost;
+    store.changesSince(behind, lost);
+    CHECK(lost.fullResync);
+    CHECK(mirror.resync(store));
+    CHECK(mirror.matches(store) && mirror.items.size() == 3);
+
+    // clear() does the same for every earlier revision
+    uint64_t beforeClear = store.revision();
+    store.clear();
+    QueueChanges cleared;
+    store.changesSince(beforeClear, cleared);
+    CHECK(cleared.fullResync && cleared.updated.empty());
+    CHECK(store.revision() > beforeClear);
+}
+
+// =========================================================================
+// UserStore
+// =========================================================================
+
+UserInfo hubUser(const std::string& nick, int64_t share, uint8_t cidByte = 0) {
+    UserInfo ui;
+    ui.nick = nick;
+    ui.description = "shared desc";
+    ui.connection = "100";
+    ui.shareSize = share;
+    if (cidByte) {
+        UserStore::RawCID cid;
+        cid.fill(cidByte);
+        ui.cid = UserStore::encodeCID(cid);
+    }
+    return ui;
+}
+
+/// Follows a UserStore through changesSince(), as getHubUserChanges()
+/// callers do.
+struct UserMirror {
+    std::map<std::string, int64_t> shares;    // nick → shareSize
+    uint64_t revision = 0;
+
+    bool resync(const UserStore& store) {
+        UserChanges ch;
+        store.changesSince(revision, ch);
+        if (ch.fullResync) shares.clear();
+        for (const auto& n : ch.removed) shares.erase(n);
+        for (const auto& u : ch.updated) shares[u.nick] = u.shareSize;
+        revision = ch.revision;
+        return ch.fullResync;
+    }
+
+    bool matches(const UserStore& store) const {
+        std::vector<UserInfo> all;
+        store.appendAll(all);
+        std::map<std::string, int64_t> expect;
+        for (const auto& u : all) expect[u.nick] = u.shareSize;
+        return shares == expect;
+    }
+};
+
+void testUserStore() {
+    UserStore store;
+    for (int i = 0; i < 10; ++i) {
+        store.upsert(hubUser("user" + std::to_string(i), 100,
+                             static_cast<uint8_t>(i + 1)));
+    }
+    CHECK(store.size() == 10 && store.totalShare() == 1000);
+
+    UserInfo ui;
+    CHECK(store.get("user3", ui));
+    CHECK(ui.description == "shared desc" && ui.connection == "100" &&
+          ui.shareSize == 100 && ui.cid == hubUser("x", 0, 4).cid);
+    CHECK(!store.get("nobody", ui));
+
+    UserMirror mirror;
+    CHECK(mirror.resync(store));
+    CHECK(mirror.matches(store));
+
+    // Leave, rejoin, info change, and a newcomer reusing a freed slot
+    CHECK(store.erase("user1"));
+    CHECK(!store.erase("user1"));
+    CHECK(store.erase("user2"));
+    store.upsert(hubUser("user2", 250, 3));
+    store.upsert(hubUser("user5", 999, 6));
+    store.upsert(hubUser("fresh", 1, 42));
+    UserChanges delta;
+    store.changesSince(mirror.revision, delta);
+    CHECK(!delta.fullResync);
+    CHECK(delta.removed.size() == 2 && delta.updated.size() == 3);
+    CHECK(!mirror.resync(store));
+    CHECK(mirror.matches(store));
+    CHECK(store.totalShare() == 1000 - 100 - 100 + 250 - 100 + 999 + 1);
+
+    UserChanges idle;
+    store.changesSince(mirror.revision, idle);
+    CHECK(!idle.fullResync && idle.updated.empty() && idle.removed.empty());
+
+    // The CID index follows renames of the CID and removals
+    UserStore::RawCID cid;
+    cid.fill(42);
+    const std::string* nick = store.nickForCID(cid);
+    CHECK(nick && *nick == "fresh");
+    store.upsert(hubUser("fresh", 1, 43));
+    CHECK(store.nickForCID(cid) == nullptr);
+    cid.fill(43);
+    nick = store.nickForCID(cid);
+    CHECK(nick && *nick == "fresh");
+    store.erase("fresh");
+    CHECK(store.nickForCID(cid) == nullptr);
+    CHECK(!mirror.resync(store) && mirror.matches(store));
+
+    // A client behind the removal log resyncs in full, and clear() does
+    // the same for every revision handed out before it
+    uint64_t behind = mirror.revision;
+    for (size_t i = 0; i <= UserStore::MAX_REMOVAL_LOG; ++i) {
+        store.upsert(hubUser("bulk" + std::to_string(i), 1));
+    }
+    for (size_t i = 0; i <= UserStore::MAX_REMOVAL_LOG; ++i) {
+        store.erase("bulk" + std::to_string(i));
+    }
+    UserChanges lost;
+    store.changesSince(behind, lost);
+    CHECK(lost.fullResync && lost.updated.size() == store.size());
+    CHECK(mirror.resync(store) && mirror.matches(store));
+
+    uint64_t beforeClear = store.revision();
+    store.clear();
+    CHECK(store.empty() && store.totalShare() == 0);
+    CHECK(store.revision() > beforeClear);
+    CHECK(mirror.resync(store) && mirror.shares.empty());
+
+    // CID text must be canonical base32 of 24 bytes
+    UserStore::RawCID raw;
+    CHECK(!UserStore::decodeCID("", raw));
+    CHECK(!UserStore::decodeCID(std::string(39, '!'), raw));
+    CHECK(UserStore::decodeCID(hubUser("x", 0, 9).cid, raw) && raw[0] == 9);
+}
+
+// =========================================================================
+// Driver
+// =========================================================================
+
+struct Group {
+    const char* name;
+    void (*run)();
+};
+
+const Group GROUPS[] = {
+    {"tth_index", testTTHIndex},
+    {"chat_log", testChatLog},
+    {"search_scheduler", testSearchScheduler},
+    {"queue_store", testQueueStore},
+    {"user_store", testUserStore},
+};
+
+} // namespace
+
+} // namespace eiskaltdcpp_py
+
+int main(int argc, char** argv) {
+    using namespace eiskaltdcpp_py;
+
+    std::vector<const Group*> selected;
+    for (int i = 1; i < argc; ++i) {
+        const Group* match = nullptr;
+        for (const auto& g : GROUPS) {
+            if (std::strcmp(g.name, argv[i]) == 0) match = &g;
+        }
+        if (!match) {
+            std::fprintf(stderr, "unknown test group: %s\n", argv[i]);
+            return 2;
+        }
+        selected.push_back(match);
+    }
+    if (selected.empty()) {
+        for (const auto& g : GROUPS) selected.push_back(&g);
+    }
+
+    for (const Group* g : selected) {
+        int before = g_failures;
+        g->run();
+        std::printf("%-16s %s\n", g->name,
+                    g_failures == before ? "ok" : "FAILED");
+    }
+    return g_failures == 0 ? 0 : 1;
+}
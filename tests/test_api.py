@@ -44,12 +44,15 @@ class MockDCClient:
 
     def __init__(self) -> None:
         self.is_initialized = True
+        self.init_phase = "ready"
+        self.init_step = ""
         self.version = "2.4.2-test"
         self._hubs: list[dict] = []
         self._users: dict[str, list[dict]] = {}
         self._chat_history: dict[str, list[str]] = {}
         self._search_results: list[dict] = []
         self._queue: list[dict] = []
+        self._queued_searches: list[dict] = []
         self._shares: list[dict] = []
         self._settings: dict[str, str] = {}
         self._share_size = 0
@@ -69,6 +72,13 @@ class MockDCClient:
     def is_connected(self, url: str) -> bool:
         return any(h["url"] == url for h in self._hubs)
 
+    def get_hub_memory_stats(self) -> list:
+        return [
+            _DictObj({"hubUrl": h["url"], "hubId": i + 1, "userCount": 0,
+                      "chatLines": 0, "totalBytes": 1024})
+            for i, h in enumerate(self._hubs)
+        ]
+
     # Chat methods
     def send_message(self, hub_url: str, message: str) -> None:
         self._chat_history.setdefault(hub_url, []).append(message)
@@ -79,6 +89,19 @@ class MockDCClient:
     def get_chat_history(self, hub_url: str, max_lines: int = 100) -> list[str]:
         return self._chat_history.get(hub_url, [])[:max_lines]
 
+    def get_chat_history_since(self, hub_url: str, since: int = 0,
+                               max_entries: int = 0):
+        lines = self._chat_history.get(hub_url, [])
+        entries = [
+            _DictObj({"seq": i + 1, "timestamp": 0, "nick": "", "text": t,
+                      "thirdPerson": False, "isPrivate": False})
+            for i, t in enumerate(lines) if i + 1 > since
+        ]
+        if max_entries:
+            entries = entries[:max_entries]
+        last = entries[-1].seq if entries else len(lines)
+        return _DictObj({"entries": entries, "lastSeq": last, "gap": False})
+
     # User methods
     def get_users(self, hub_url: str) -> list:
         return [_DictObj(u) for u in self._users.get(hub_url, [])]
@@ -88,6 +111,28 @@ class MockDCClient:
                size: int = 0, hub_url: str = "") -> bool:
         return len(self._hubs) > 0
 
+    def queue_search(self, query: str, file_type: int = 0,
+                     size_mode: int = 0, size: int = 0, hub_url: str = "",
+                     priority: int = 0) -> str:
+        if not self._hubs:
+            return ""
+        token = f"q{len(self._queued_searches) + 1}"
+        self._queued_searches.append({
+            "token": token, "query": query, "fileType": file_type,
+            "priority": priority,
+            "pendingHubs": [h["url"] for h in self._hubs], "sentHubs": 0,
+        })
+        return token
+
+    def cancel_queued_search(self, token: str) -> bool:
+        before = len(self._queued_searches)
+        self._queued_searches = [q for q in self._queued_searches
+                                 if q["token"] != token]
+        return len(self._queued_searches) < before
+
+    def list_queued_searches(self) -> list:
+        return [_DictObj(q) for q in self._queued_searches]
+
     def get_search_results(self, hub_url: str = "") -> list:
         return [_DictObj(r) for r in self._search_results]
 
@@ -118,6 +163,12 @@ class MockDCClient:
     def list_queue(self) -> list:
         return [_DictObj(q) for q in self._queue]
 
+    def list_queue_page(self, offset: int = 0, limit: int = 0):
+        items = self.list_queue()
+        end = offset + limit if limit else None
+        return _DictObj({"items": items[offset:end], "total": len(items),
+                         "revision": 0})
+
     def clear_queue(self) -> None:
         self._queue.clear()
 
@@ -139,6 +190,9 @@ class MockDCClient:
     def refresh_share(self) -> None:
         pass
 
+    def refresh_share_dir(self, real_path: str) -> bool:
+        return any(real_path.startswith(s["realPath"]) for s in self._shares)
+
     @property
     def share_size(self) -> int:
         return self._share_size
@@ -151,13 +205,31 @@ class MockDCClient:
     def get_setting(self, name: str) -> str:
         return self._settings.get(name, "")
 
-    def set_setting(self, name: str, value: str) -> None:
+    def set_setting(self, name: str, value: str) -> bool:
         self._settings[name] = value
+        return True
+
+    def get_settings(self, names) -> dict:
+        return {n: self._settings[n] for n in names if n in self._settings}
+
+    def set_settings(self, values) -> int:
+        self._settings.update(values)
+        return len(values)
 
     def start_networking(self) -> None:
         pass
 
     # Transfer/hash methods
+    @property
+    def status_snapshot(self) -> Any:
+        return _DictObj({
+            "seq": 1, "timestamp": 0, "hubs": len(self._hubs),
+            "connectedHubs": len(self._hubs), "users": 0,
+            "shareSize": self._share_size, "sharedFiles": self._shared_files,
+            "queueItems": len(self._queue), "activeTransfers": 1,
+            "transfers": self.transfer_stats, "hashing": self.hash_status,
+        })
+
     @property
     def transfer_stats(self) -> Any:
         return _DictObj({
@@ -165,6 +237,14 @@ class MockDCClient:
             "downloaded": 1048576, "uploaded": 524288,
         })
 
+    @property
+    def active_transfers(self) -> list:
+        return [_DictObj({
+            "filename": "/downloads/big.iso", "nick": "peer",
+            "hubUrl": "dchub://test:411", "size": 4096, "pos": 1024,
+            "speed": 2048, "isDownload": True,
+        })]
+
     @property
     def hash_status(self) -> Any:
         return _DictObj({
@@ -176,6 +256,23 @@ class MockDCClient:
     def pause_hashing(self, pause: bool = True) -> None:
         self._hashing_paused = pause
 
+    def get_metrics(self) -> dict:
+        latency = {"count": 3, "sum": 0.00002, "max": 0.00001,
+                   "buckets": [(1e-06, 1), (2e-06, 2), (float("inf"), 3)]}
+        return {
+            "events": {"chat_message": {"raised": 7, "skipped": 1,
+                                        "callbacks": 3,
+                                        "callback_latency": latency}},
+            "locks": {"DCBridge::m_mutex": {"acquisitions": 10,
+                                            "contended": 0,
+                                            "wait": latency}},
+            "ring": {"capacity": 0, "depth": 0, "queued": 0,
+                     "dropped": 0, "polled": 0},
+            "pending_user_events": 0, "held_coalesced_events": 0,
+            "search_results": 4, "queue_items": 2,
+            "pending_file_list_loads": 0, "hubs": len(self._hubs),
+        }
+
     # Mock _sync_client for routes that access it directly
     @property
     def _sync_client(self) -> "MockDCClient":
@@ -581,6 +678,20 @@ class TestHubEndpoints:
         assert data["total"] >= 1
         assert any("hub1" in h["url"] for h in data["hubs"])
 
+    def test_hub_memory(self, app, admin_token, readonly_token):
+        app.post(
+            "/api/hubs/connect",
+            json={"url": "dchub://mem.example.com:411"},
+            headers=auth_header(admin_token),
+        )
+        resp = app.get("/api/hubs/memory", headers=auth_header(readonly_token))
+        assert resp.status_code == 200
+        data = resp.json()
+        hub = next(h for h in data["hubs"] if "mem" in h["url"])
+        assert hub["hub_id"] >= 1
+        assert hub["total_bytes"] == 1024
+        assert data["total_bytes"] >= 1024
+
     def test_list_hubs_unauthenticated(self, app):
         resp = app.get("/api/hubs")
         assert resp.status_code == 401
@@ -673,6 +784,20 @@ class TestChatEndpoints:
         assert data["hub_url"] == url
         assert len(data["messages"]) == 2
 
+    def test_get_chat_history_since(self, app, mock_client, readonly_token):
+        url = "dchub://hub.example.com:411"
+        mock_client._chat_history[url] = ["one", "two", "three"]
+        resp = app.get(
+            "/api/chat/history/since",
+            params={"hub_url": url, "since": 1},
+            headers=auth_header(readonly_token),
+        )
+        assert resp.status_code == 200
+        data = resp.json()
+        assert [e["text"] for e in data["entries"]] == ["two", "three"]
+        assert data["last_seq"] == 3
+        assert data["gap"] is False
+
     def test_send_empty_message(self, app, admin_token):
         resp = app.post(
             "/api/chat/message",
@@ -718,6 +843,36 @@ class TestSearchEndpoints:
         )
         assert resp.status_code == 403
 
+    def test_queue_search(self, app, admin_token, readonly_token,
+                          mock_client):
+        mock_client._hubs.append({"url": "dchub://hub.example.com:411",
+                                   "name": "Test", "connected": True,
+                                   "userCount": 10})
+        resp = app.post(
+            "/api/search",
+            json={"query": "TTH:ABC", "file_type": 8, "queued": True,
+                  "priority": 5},
+            headers=auth_header(admin_token),
+        )
+        assert resp.status_code == 200
+        token = resp.json()["token"]
+        assert token
+
+        resp = app.get("/api/search/queue",
+                       headers=auth_header(readonly_token))
+        assert resp.status_code == 200
+        queued = resp.json()
+        assert queued[0]["token"] == token
+        assert queued[0]["priority"] == 5
+        assert queued[0]["pending_hubs"] == ["dchub://hub.example.com:411"]
+
+        resp = app.delete(f"/api/search/queue/{token}",
+                          headers=auth_header(admin_token))
+        assert resp.status_code == 200
+        resp = app.delete(f"/api/search/queue/{token}",
+                          headers=auth_header(admin_token))
+        assert resp.status_code == 404
+
     def test_get_search_results(self, app, readonly_token, mock_client):
         mock_client._search_results = [
             {"hubUrl": "dchub://hub.example.com", "file": "test.txt",
@@ -800,6 +955,23 @@ class TestQueueEndpoints:
         data = resp.json()
         assert data["total"] >= 1
 
+    def test_list_queue_paged(self, app, mock_client, readonly_token):
+        for i in range(5):
+            mock_client._queue.append({
+                "target": f"/downloads/page{i}.bin",
+                "size": i, "downloadedBytes": 0, "priority": 3, "tth": "",
+            })
+        resp = app.get(
+            "/api/queue?offset=1&limit=2",
+            headers=auth_header(readonly_token),
+        )
+        assert resp.status_code == 200
+        data = resp.json()
+        assert data["total"] == 5
+        assert [q["target"] for q in data["items"]] == [
+            "/downloads/page1.bin", "/downloads/page2.bin",
+        ]
+
     def test_remove_from_queue(self, app, admin_token, mock_client):
         mock_client._queue.append({
             "target": "/downloads/removeme.bin",
@@ -872,6 +1044,25 @@ class TestShareEndpoints:
         resp = app.post("/api/shares/refresh", headers=auth_header(admin_token))
         assert resp.status_code == 200
 
+    def test_refresh_share_dir(self, app, admin_token):
+        app.post(
+            "/api/shares",
+            json={"real_path": "/srv/media/", "virtual_name": "Media"},
+            headers=auth_header(admin_token),
+        )
+        resp = app.post(
+            "/api/shares/refresh",
+            params={"path": "/srv/media/films"},
+            headers=auth_header(admin_token),
+        )
+        assert resp.status_code == 200
+        resp = app.post(
+            "/api/shares/refresh",
+            params={"path": "/elsewhere"},
+            headers=auth_header(admin_token),
+        )
+        assert resp.status_code == 404
+
     def test_refresh_share_readonly_denied(self, app, readonly_token):
         resp = app.post("/api/shares/refresh", headers=auth_header(readonly_token))
         assert resp.status_code == 403
@@ -919,6 +1110,18 @@ class TestSettingsEndpoints:
         assert resp.status_code == 200
         assert mock_client._settings["Nick"] == "Bot1"
         assert mock_client._settings["Description"] == "Test bot"
+        assert "Updated 2 of 2" in resp.json()["message"]
+
+    def test_get_settings(self, app, readonly_token, mock_client):
+        mock_client._settings.update({"Nick": "TestBot",
+                                      "Description": "Test bot"})
+        resp = app.get(
+            "/api/settings?names=Nick&names=Description&names=Bogus",
+            headers=auth_header(readonly_token),
+        )
+        assert resp.status_code == 200
+        assert resp.json()["settings"] == {"Nick": "TestBot",
+                                           "Description": "Test bot"}
 
     def test_reload_config(self, app, admin_token):
         resp = app.post("/api/settings/reload", headers=auth_header(admin_token))
@@ -949,6 +1152,31 @@ class TestStatusEndpoints:
         assert data["initialized"] is True
         assert "uptime_seconds" in data
 
+    def test_system_status_uses_snapshot(self, app, admin_token,
+                                         readonly_token, mock_client):
+        app.post(
+            "/api/hubs/connect",
+            json={"url": "dchub://snap.example.com:411"},
+            headers=auth_header(admin_token),
+        )
+        resp = app.get("/api/status", headers=auth_header(readonly_token))
+        data = resp.json()
+        assert data["connected_hubs"] == mock_client.status_snapshot.connectedHubs
+        assert data["share_size"] == mock_client.share_size
+
+    def test_system_status_while_loading(self, app, readonly_token,
+                                         mock_client):
+        mock_client.is_initialized = False
+        mock_client.init_phase = "loading"
+        mock_client.init_step = "Hash database"
+        resp = app.get("/api/status", headers=auth_header(readonly_token))
+        assert resp.status_code == 200
+        data = resp.json()
+        assert data["initialized"] is False
+        assert data["init_phase"] == "loading"
+        assert data["init_step"] == "Hash database"
+        assert data["connected_hubs"] == 0
+
     def test_system_status_unauthenticated(self, app):
         resp = app.get("/api/status")
         assert resp.status_code == 401
@@ -960,6 +1188,17 @@ class TestStatusEndpoints:
         assert data["download_speed"] == 1024
         assert data["upload_speed"] == 512
 
+    def test_active_transfers(self, app, readonly_token):
+        resp = app.get(
+            "/api/status/transfers/active",
+            headers=auth_header(readonly_token),
+        )
+        assert resp.status_code == 200
+        data = resp.json()
+        assert data["total"] == 1
+        assert data["transfers"][0]["pos"] == 1024
+        assert data["transfers"][0]["hub_url"] == "dchub://test:411"
+
     def test_hashing_status(self, app, readonly_token):
         resp = app.get("/api/status/hashing", headers=auth_header(readonly_token))
         assert resp.status_code == 200
@@ -967,6 +1206,22 @@ class TestStatusEndpoints:
         assert data["files_left"] == 5
         assert data["is_paused"] is False
 
+    def test_metrics_prometheus(self, app, readonly_token):
+        resp = app.get("/api/status/metrics", headers=auth_header(readonly_token))
+        assert resp.status_code == 200
+        assert resp.headers["content-type"].startswith("text/plain")
+        body = resp.text
+        assert "# TYPE eiskaltdcpp_events_raised_total counter" in body
+        assert 'eiskaltdcpp_events_raised_total{event="chat_message"} 7' in body
+        assert ('eiskaltdcpp_event_callback_duration_seconds_bucket'
+                '{event="chat_message",le="+Inf"} 3') in body
+        assert 'eiskaltdcpp_lock_acquisitions_total{lock="DCBridge::m_mutex"} 10' in body
+        assert "eiskaltdcpp_search_results 4" in body
+
+    def test_metrics_unauthenticated(self, app):
+        resp = app.get("/api/status/metrics")
+        assert resp.status_code == 401
+
     def test_pause_hashing(self, app, admin_token, mock_client):
         resp = app.post(
             "/api/status/hashing/pause",
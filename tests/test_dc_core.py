@@ -10,7 +10,11 @@ Concurrency-safe: all tests use unique temporary directories via pytest's
 tmp_path fixture. No hardcoded paths or shared filesystem state, so
 multiple test runs can execute in parallel on the same machine.
 """
+import bz2
+import json
 import os
+import random
+import subprocess
 import sys
 import tempfile
 import threading
@@ -75,8 +79,12 @@ class TestSwigModuleImport:
         """All data struct types are exported."""
         types = [
             "HubInfo", "UserInfo", "SearchResultInfo", "QueueItemInfo",
-            "TransferInfo", "ShareDirInfo", "HashStatus", "FileListEntry",
-            "TransferStats",
+            "QueuedSearchInfo", "TransferInfo", "ShareDirInfo", "HashStatus", "FileListEntry",
+            "TransferStats", "BridgeEvent", "EventQueueStats", "UserChanges",
+            "SearchResultSnapshot", "TTHSource", "QueuePage", "QueueChanges",
+            "QueueAddItem", "EventPolicyStats", "HubMemoryStats", "HubLimits",
+            "LatencyStats", "EventMetrics", "LockMetrics", "BridgeMetrics",
+            "FileListWalker", "FileListSearchPage", "StatusSnapshot",
         ]
         for t in types:
             assert hasattr(dc_core, t), f"Missing type: {t}"
@@ -84,9 +92,12 @@ class TestSwigModuleImport:
     def test_vector_templates_exist(self):
         """SWIG template instantiations for vector types are available."""
         templates = [
-            "StringVector", "UserInfoVector", "SearchResultVector",
-            "QueueItemVector", "HubInfoVector", "ShareDirVector",
-            "FileListEntryVector", "TransferInfoVector",
+            "StringVector", "StringMap", "UserInfoVector",
+            "SearchResultVector", "QueueItemVector", "QueuedSearchVector",
+            "HubInfoVector", "ShareDirVector",
+            "FileListEntryVector", "TransferInfoVector", "BridgeEventVector",
+            "TTHSourceVector", "QueueAddItemVector", "EventPolicyStatsVector",
+            "UInt64Vector", "EventMetricsVector", "LockMetricsVector",
         ]
         for t in templates:
             assert hasattr(dc_core, t), f"Missing template: {t}"
@@ -109,23 +120,62 @@ class TestDCBridgeCreation:
         bridge = dc_core.DCBridge()
         assert not bridge.isInitialized()
 
+    def test_init_phase_uninitialized(self):
+        """A new bridge is in INIT_NONE; shutdown() keeps it there."""
+        bridge = dc_core.DCBridge()
+        assert bridge.getInitPhase() == dc_core.INIT_NONE
+        assert bridge.getInitStep() == ""
+        bridge.shutdown()
+        assert bridge.getInitPhase() == dc_core.INIT_NONE
+        assert len({dc_core.INIT_NONE, dc_core.INIT_LOADING,
+                    dc_core.INIT_READY, dc_core.INIT_FAILED}) == 4
+
     def test_bridge_methods_exist(self):
         """Key methods exist on DCBridge."""
         methods = [
             "initialize", "shutdown", "isInitialized",
-            "setCallback",
+            "initializeAsync", "getInitPhase", "getInitStep",
+            "setCallback", "setDispatchMode", "getDispatchMode",
+            "pollEvents", "getEventFd", "getEventQueueStats",
+            "setUserEventCoalescing", "getUserEventCoalescing",
+            "setEventPolicy", "getEventPolicy", "getEventPolicyStats",
+            "resetEventPolicies", "setEventMask", "getEventMask",
             "connectHub", "disconnectHub", "listHubs", "isHubConnected",
+            "getHubMemoryStats", "setHubLimits", "getHubLimits",
+            "getMetrics",
             "sendMessage", "sendPM", "getChatHistory",
+            "getChatHistorySince", "setChatHistoryCapacity",
+            "getChatHistoryCapacity",
+            "enableChatLog", "disableChatLog", "isChatLogEnabled",
+            "flushChatLog", "queryChatLog",
             "getHubUsers", "getUserInfo",
+            "getHubUserRevision", "getHubUserChanges",
             "search", "getSearchResults", "clearSearchResults",
+            "startSearch", "getSearchResultCount", "listSearches",
+            "queueSearch", "cancelQueuedSearch", "listQueuedSearches",
+            "setSearchInterval", "getSearchInterval",
+            "forgetSearch", "setSearchLimits", "getSearchSnapshot",
             "addToQueue", "addMagnet", "removeFromQueue",
             "setPriority", "listQueue", "clearQueue",
+            "listQueuePage", "getQueueRevision", "getQueueChanges",
+            "addToQueueBatch", "addMagnetBatch", "removeFromQueueBatch",
+            "setPriorityBatch",
             "requestFileList", "openFileList", "browseFileList",
+            "walkFileList", "searchFileLists",
+            "openFileListAsync", "setFileListLoadThreads",
+            "getPendingFileListLoads", "downloadFilesFromList",
+            "matchAllLists", "findSources", "refreshTTHIndex",
             "closeFileList", "closeAllFileLists",
             "addShareDir", "removeShareDir", "listShare",
-            "refreshShare", "getShareSize", "getSharedFileCount",
-            "getTransferStats", "getHashStatus", "pauseHashing",
+            "refreshShare", "refreshShareDir", "getShareSize",
+            "getSharedFileCount",
+            "getTransferStats", "getActiveTransfers", "getStatusSnapshot",
+            "setTransferProgressInterval", "getTransferProgressInterval",
+            "getHashStatus", "pauseHashing",
+            "setHashSpeedLimit", "getHashSpeedLimit",
+            "setHashProgressInterval", "getHashProgressInterval",
             "getSetting", "setSetting", "reloadConfig",
+            "getSettings", "setSettings", "saveSettings",
             "getVersion",
         ]
         bridge = dc_core.DCBridge()
@@ -138,6 +188,191 @@ class TestDCBridgeCreation:
         assert isinstance(ver, str)
         assert len(ver) > 0
 
+    def test_search_store_uninitialized(self):
+        """Search store accessors are safe before initialize()."""
+        bridge = dc_core.DCBridge()
+        assert bridge.startSearch("test") == ""
+        assert bridge.getSearchResultCount("") == 0
+        assert len(bridge.getSearchResults("", 0, 10)) == 0
+        assert len(bridge.listSearches()) == 0
+
+    def test_search_scheduler_uninitialized(self):
+        """Queued searches need a hub; the interval is adjustable."""
+        bridge = dc_core.DCBridge()
+        assert bridge.queueSearch("test", 0, 0, 0, "", 5) == ""
+        assert bridge.cancelQueuedSearch("nope") is False
+        assert len(bridge.listQueuedSearches()) == 0
+        default = bridge.getSearchInterval()
+        assert default == 10
+        try:
+            bridge.setSearchInterval(30)
+            assert bridge.getSearchInterval() == 30
+        finally:
+            bridge.setSearchInterval(default)
+
+    def test_file_list_loader_uninitialized(self):
+        """Background file-list loading refuses work before initialize()."""
+        bridge = dc_core.DCBridge()
+        assert bridge.openFileListAsync("nick.ABC.xml.bz2") is False
+        assert bridge.getPendingFileListLoads() == 0
+        bridge.setFileListLoadThreads(2)
+        assert bridge.downloadFilesFromList(
+            "nick.ABC.xml.bz2", ["/a/b.txt", "/c"], "") == 0
+
+    def test_tth_index_uninitialized(self):
+        """TTH index queries are empty before initialize()."""
+        bridge = dc_core.DCBridge()
+        tth = "LWPNACQDBZRYXW3VHJVCJ64QBZNGHOHHHZWCLNQ"
+        assert len(bridge.findSources([tth, "not-a-tth"])) == 0
+        assert bridge.matchAllLists() == 0
+        assert bridge.refreshTTHIndex() == 0
+
+    def test_queue_mirror_uninitialized(self):
+        """Queue reads are empty before initialize()."""
+        bridge = dc_core.DCBridge()
+        assert len(bridge.listQueue()) == 0
+        page = bridge.listQueuePage(0, 50)
+        assert page.total == 0
+        assert len(page.items) == 0
+        assert bridge.getQueueRevision() == 0
+        changes = bridge.getQueueChanges(0)
+        assert changes.revision == 0
+        assert len(changes.updated) == 0
+        assert len(changes.removed) == 0
+
+    def test_chat_history_uninitialized(self):
+        """Chat reads are empty before initialize(); capacity round-trips."""
+        bridge = dc_core.DCBridge()
+        assert len(bridge.getChatHistory("dchub://nowhere:411", 10)) == 0
+        page = bridge.getChatHistorySince("dchub://nowhere:411", 7)
+        assert page.lastSeq == 7
+        assert not page.gap
+        assert len(page.entries) == 0
+        assert bridge.getChatHistoryCapacity() == 500
+        bridge.setChatHistoryCapacity(50)
+        assert bridge.getChatHistoryCapacity() == 50
+        bridge.setChatHistoryCapacity(500)
+
+    def test_hub_limits_uninitialized(self):
+        """No hub memory before initialize(); hub limits round-trip."""
+        bridge = dc_core.DCBridge()
+        assert len(bridge.getHubMemoryStats()) == 0
+        bridge.setHubLimits(2000, 100, 500)
+        limits = bridge.getHubLimits()
+        assert limits.maxUsers == 2000
+        assert limits.maxChatLines == 100
+        assert limits.maxResults == 500
+        assert bridge.getChatHistoryCapacity() == 100
+        bridge.setHubLimits(0, 500, 0)
+        assert bridge.getHubLimits().maxUsers == 0
+
+    def test_file_list_walk_uninitialized(self):
+        """Paged browse and walk of an unknown list come back empty."""
+        bridge = dc_core.DCBridge()
+        assert len(bridge.browseFileList("nope", "/", 10, 5)) == 0
+        walker = bridge.walkFileList("nope")
+        assert walker.done()
+        assert len(walker.next(100)) == 0
+        assert list(walker) == []
+
+    def test_status_snapshot_uninitialized(self):
+        """No snapshot is published before the first timer tick."""
+        bridge = dc_core.DCBridge()
+        snap = bridge.getStatusSnapshot()
+        assert snap.seq == 0
+        assert snap.connectedHubs == 0
+        assert snap.transfers.downloadSpeed == 0
+
+    def test_hash_controls_uninitialized(self):
+        """Share/hash controls are safe before initialize()."""
+        bridge = dc_core.DCBridge()
+        assert bridge.refreshShareDir("/nonexistent") is False
+        assert bridge.getHashSpeedLimit() == 0
+        bridge.setHashProgressInterval(2000)
+        assert bridge.getHashProgressInterval() == 2000
+        bridge.setHashProgressInterval(0)
+
+    def test_search_file_lists_uninitialized(self):
+        """searchFileLists() with nothing open returns an empty page."""
+        bridge = dc_core.DCBridge()
+        page = bridge.searchFileLists("beatles", 0, 0, 0, 0, 10)
+        assert page.total == 0
+        assert len(page.hits) == 0
+
+    def test_file_list_entry_tth(self):
+        """FileListEntry.tth is readable without a raw TTH."""
+        entry = dc_core.FileListEntry()
+        assert entry.tth == ""
+        assert entry.path == ""
+
+    def test_metrics_uninitialized(self):
+        """getMetrics() works before initialize() and covers every event."""
+        bridge = dc_core.DCBridge()
+        m = bridge.getMetrics()
+        assert len(m.events) == dc_core.EVENT_TYPE_COUNT
+        for i, e in enumerate(m.events):
+            assert e.type == i
+            assert len(e.callbackLatency.buckets) == \
+                dc_core.LatencyStats.BUCKET_COUNT
+        assert "DCBridge::m_mutex" in [lk.name for lk in m.locks]
+        assert m.hubs == 0
+
+    def test_chat_log_open_close(self, tmp_path):
+        """The chat log opens an explicit directory and reads back empty."""
+        bridge = dc_core.DCBridge()
+        assert not bridge.enableChatLog()   # no config dir yet
+        log_dir = tmp_path / "chatlog"
+        assert bridge.enableChatLog(str(log_dir))
+        try:
+            assert bridge.isChatLogEnabled()
+            assert (log_dir / "chat-00000001.dclog").exists()
+            bridge.flushChatLog()
+            assert len(bridge.queryChatLog()) == 0
+        finally:
+            bridge.disableChatLog()
+        assert not bridge.isChatLogEnabled()
+        assert len(bridge.queryChatLog("", 0, 0, 10)) == 0
+
+    def test_active_transfers_uninitialized(self):
+        """No transfers before initialize(); the interval round-trips."""
+        bridge = dc_core.DCBridge()
+        assert len(bridge.getActiveTransfers()) == 0
+        try:
+            bridge.setTransferProgressInterval(2000)
+            assert bridge.getTransferProgressInterval() == 2000
+            bridge.setTransferProgressInterval(-5)
+            assert bridge.getTransferProgressInterval() == 0
+        finally:
+            bridge.setTransferProgressInterval(0)
+
+    def test_queue_batches_uninitialized(self):
+        """Batch queue calls are no-ops before initialize()."""
+        bridge = dc_core.DCBridge()
+        item = dc_core.QueueAddItem()
+        item.directory = "/tmp"
+        item.name = "f.bin"
+        item.size = 1
+        item.tth = "LWPNACQDBZRYXW3VHJVCJ64QBZNGHOHHHZWCLNQ"
+        items = dc_core.QueueAddItemVector()
+        items.append(item)
+        assert bridge.addToQueueBatch(items) == 0
+        assert bridge.addMagnetBatch(["magnet:?xt=urn:tree:tiger:X"]) == 0
+        assert bridge.removeFromQueueBatch(["/tmp/f.bin"]) == 0
+        assert bridge.setPriorityBatch(["/tmp/f.bin"], 5) == 0
+
+    def test_empty_search_snapshot(self):
+        """An unknown token gives an empty, well-behaved snapshot."""
+        bridge = dc_core.DCBridge()
+        snap = bridge.getSearchSnapshot("nope")
+        assert len(snap) == 0
+        assert list(snap) == []
+        assert snap[0:10] == []
+        with pytest.raises(IndexError):
+            snap[0]
+        cols = snap.columns()
+        assert len(cols["size"]) == 0
+        assert cols["tth"] == b""
+
     def test_context_manager_support(self):
         """DCBridge supports __enter__/__exit__."""
         bridge = dc_core.DCBridge()
@@ -192,6 +427,22 @@ class TestBridgeSettings:
         bridge.setSetting("Nick", "my-test-nick")
         assert bridge.getSetting("Nick") == "my-test-nick"
 
+    def test_settings_batch(self, bridge):
+        """setSettings applies known names once; getSettings reads them."""
+        applied = bridge.setSettings({
+            "Description": "batch-bot", "Slots": "4",
+            "Slots-bogus": "1", "MinUploadSpeed": "not-a-number",
+        })
+        assert applied == 2
+        got = bridge.getSettings(["Description", "Slots", "Slots-bogus"])
+        assert dict(got) == {"Description": "batch-bot", "Slots": "4"}
+        bridge.saveSettings()
+
+    def test_set_setting_rejects_bad_value(self, bridge):
+        """Integer settings do not take non-numeric values."""
+        assert bridge.setSetting("Slots", "lots") is False
+        assert bridge.setSetting("NonExistentSetting99", "1") is False
+
     def test_unknown_setting_returns_empty(self, bridge):
         """getSetting returns empty string for unknown setting names."""
         val = bridge.getSetting("NonExistentSetting99")
@@ -210,6 +461,116 @@ class TestBridgeSettings:
         assert bridge.isInitialized()
 
 
+# ============================================================================
+# File list loading tests
+# ============================================================================
+
+# Runs in its own interpreter: dcpp's singletons allow one startup() per
+# process, and TestBridgeSettings already owns this one's.
+FILE_LIST_CHILD = r"""
+import json, sys, threading
+from eiskaltdcpp import dc_core
+
+class Loaded(dc_core.DCClientCallback):
+    def __init__(self):
+        super().__init__()
+        self.done = threading.Event()
+        self.result = None
+
+    def onFileListLoaded(self, fileListId, success, error):
+        self.result = (success, error)
+        self.done.set()
+
+def tree(bridge, list_id):
+    return sorted((e.path, e.size, e.tth, e.isDirectory)
+                  for e in bridge.walkFileList(list_id))
+
+def load_async(bridge, cb, list_id):
+    cb.done.clear()
+    assert bridge.openFileListAsync(list_id)
+    assert cb.done.wait(30), "onFileListLoaded never fired"
+    return cb.result
+
+bridge = dc_core.DCBridge()
+assert bridge.initialize(sys.argv[1])
+cb = Loaded()
+bridge.setCallback(cb)
+assert bridge.setSetting("MaxFilelistSize", "1")
+list_id, bomb_id = sys.argv[2].split(",")
+out = {}
+out["async_ok"], _ = load_async(bridge, cb, list_id)
+out["async"] = tree(bridge, list_id)
+bridge.closeFileList(list_id)
+out["blocking_ok"] = bridge.openFileList(list_id)
+out["blocking"] = tree(bridge, list_id)
+bridge.closeFileList(list_id)
+out["bomb_ok"], out["bomb_error"] = load_async(bridge, cb, bomb_id)
+out["bomb"] = tree(bridge, bomb_id)
+bridge.setCallback(None)
+bridge.shutdown()
+print(json.dumps(out))
+"""
+
+LIST_CID = "LWPNACQDBZRYXW3VHJVCJ64QBZNGHOHHHZWCLNQ"
+
+
+def file_list_xml(dirs, files_per_dir, seed=1):
+    """A FileListing with pseudo-random TTHs, so bz2 cannot shrink it
+    to nothing."""
+    rng = random.Random(seed)
+    alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"
+    out = ['<?xml version="1.0" encoding="utf-8" standalone="yes"?>',
+           f'<FileListing Version="1" CID="{LIST_CID}" Base="/" '
+           'Generator="pytest">']
+    for d in range(dirs):
+        out.append(f'<Directory Name="dir{d:04}">')
+        for f in range(files_per_dir):
+            tth = "".join(rng.choice(alphabet) for _ in range(39))
+            out.append(f'<File Name="file{f:05} {rng.random():.12f}.bin" '
+                       f'Size="{rng.randrange(1, 1 << 40)}" TTH="{tth}"/>')
+        out.append("</Directory>")
+    out.append("</FileListing>")
+    return "\n".join(out).encode()
+
+
+class TestFileListLoading:
+    """openFileListAsync() against real .xml.bz2 lists."""
+
+    def test_async_matches_blocking(self, unique_config_dir):
+        """The async reader inflates a bz2 list exactly as loadFile() does,
+        and counts inflated bytes against MaxFilelistSize."""
+        lists = unique_config_dir / "FileLists"
+        lists.mkdir()
+        list_id = f"alice.{LIST_CID}.xml.bz2"
+        # Several 64 KiB reads, well under the 1 MiB limit set below
+        xml = file_list_xml(20, 200)
+        assert 256 * 1024 < len(xml) < 1024 * 1024
+        (lists / list_id).write_bytes(bz2.compress(xml))
+        # A few KiB on disk that inflate past 1 MiB
+        bomb_id = f"bob.{LIST_CID}.xml.bz2"
+        bomb = file_list_xml(1, 1) + b" " * (3 * 1024 * 1024)
+        (lists / bomb_id).write_bytes(bz2.compress(bomb))
+        assert (lists / bomb_id).stat().st_size < 64 * 1024
+
+        env = dict(os.environ)
+        if BUILD_DIR.exists():
+            env["PYTHONPATH"] = os.pathsep.join(
+                filter(None, [str(BUILD_DIR), env.get("PYTHONPATH")]))
+        proc = subprocess.run(
+            [sys.executable, "-c", FILE_LIST_CHILD,
+             str(unique_config_dir) + "/", f"{list_id},{bomb_id}"],
+            capture_output=True, text=True, timeout=120, env=env)
+        assert proc.returncode == 0, proc.stderr
+        out = json.loads(proc.stdout.strip().splitlines()[-1])
+
+        assert out["async_ok"] and out["blocking_ok"]
+        assert len(out["async"]) == 20 + 20 * 200
+        assert out["async"] == out["blocking"]
+        assert out["bomb_ok"] is False
+        assert "MaxFilelistSize" in out["bomb_error"]
+        assert out["bomb"] == []
+
+
 # ============================================================================
 # Data type tests
 # ============================================================================
@@ -252,6 +613,7 @@ class TestDataTypes:
         assert hasattr(info, "hubName")
         assert hasattr(info, "nick")
         assert hasattr(info, "isDirectory")
+        assert hasattr(info, "token")
 
     def test_queue_item_fields(self):
         """QueueItemInfo has expected fields."""
@@ -272,6 +634,22 @@ class TestDataTypes:
         assert hasattr(stats, "downloadCount")
         assert hasattr(stats, "uploadCount")
 
+    def test_user_changes_fields(self):
+        """UserChanges carries a revision plus updated / removed lists."""
+        changes = dc_core.UserChanges()
+        assert changes.revision == 0
+        assert not changes.fullResync
+        assert len(changes.updated) == 0
+        assert len(changes.removed) == 0
+
+    def test_hub_user_changes_unknown_hub(self):
+        """An unknown hub reports revision 0 and no changes."""
+        bridge = dc_core.DCBridge()
+        assert bridge.getHubUserRevision("dchub://nowhere:411") == 0
+        changes = bridge.getHubUserChanges("dchub://nowhere:411", 0)
+        assert changes.revision == 0
+        assert len(changes.updated) == 0
+
     def test_hub_info_str(self):
         """HubInfo has __str__ representation."""
         info = dc_core.HubInfo()
@@ -350,17 +728,124 @@ class TestEventCallback:
             "onNickTaken", "onHubFull",
             "onChatMessage", "onPrivateMessage", "onStatusMessage",
             "onUserConnected", "onUserDisconnected", "onUserUpdated",
+            "onUsersUpdatedBatch", "onUsersConnectedBatch",
+            "onUsersRemovedBatch",
             "onSearchResult",
             "onQueueItemAdded", "onQueueItemFinished", "onQueueItemRemoved",
+            "onQueueItemsAddedBatch", "onQueueItemsRemovedBatch",
             "onDownloadStarting", "onDownloadComplete", "onDownloadFailed",
-            "onUploadStarting", "onUploadComplete",
-            "onHashProgress",
+            "onUploadStarting", "onUploadComplete", "onTransferProgress",
+            "onFileListProgress", "onFileListLoaded",
+            "onHashProgress", "onCoreReady",
         ]
         cb = dc_core.DCClientCallback()
         for method in callback_methods:
             assert hasattr(cb, method), f"Missing callback: {method}"
 
 
+# ============================================================================
+# Queued dispatch tests
+# ============================================================================
+
+class TestQueuedDispatch:
+    """Tests for the bounded event ring (DISPATCH_QUEUED)."""
+
+    def test_event_type_constants(self):
+        """EventType tags are exported and distinct."""
+        names = [n for n in dir(dc_core) if n.startswith("EVENT_")]
+        assert "EVENT_CHAT_MESSAGE" in names
+        assert "EVENT_SEARCH_RESULT" in names
+        values = [getattr(dc_core, n) for n in names if n != "EVENT_TYPE_COUNT"]
+        assert len(values) == len(set(values))
+
+    def test_bridge_event_fields(self):
+        """BridgeEvent has the generic record fields."""
+        ev = dc_core.BridgeEvent()
+        for field in ("type", "seq", "hubUrl", "nick", "text", "extra",
+                      "size", "value", "pos", "freeSlots", "totalSlots",
+                      "flag"):
+            assert hasattr(ev, field), f"Missing field: {field}"
+
+    def test_event_mask(self):
+        """The event mask round-trips and defaults to everything."""
+        bridge = dc_core.DCBridge()
+        try:
+            assert bridge.getEventMask() == (1 << 64) - 1
+            chat_only = ((1 << dc_core.EVENT_CHAT_MESSAGE) |
+                         (1 << dc_core.EVENT_PRIVATE_MESSAGE))
+            bridge.setEventMask(chat_only)
+            assert bridge.getEventMask() == chat_only
+        finally:
+            bridge.setEventMask((1 << 64) - 1)
+
+    def test_event_policies(self):
+        """Policies are validated, reported per type and reset."""
+        bridge = dc_core.DCBridge()
+        try:
+            assert bridge.setEventPolicy(dc_core.EVENT_CHAT_MESSAGE,
+                                         dc_core.POLICY_RATE_LIMIT, 5)
+            assert not bridge.setEventPolicy(dc_core.EVENT_CHAT_MESSAGE,
+                                             dc_core.POLICY_RATE_LIMIT, 0)
+            assert not bridge.setEventPolicy(dc_core.EVENT_TYPE_COUNT,
+                                             dc_core.POLICY_DROP)
+            assert not bridge.setEventPolicy(dc_core.EVENT_CHAT_MESSAGE, 99)
+            assert not bridge.setEventPolicy(dc_core.EVENT_CORE_READY,
+                                             dc_core.POLICY_DROP)
+            assert bridge.setEventPolicy(dc_core.EVENT_SEARCH_RESULT,
+                                         dc_core.POLICY_DROP)
+            stats = bridge.getEventPolicyStats()
+            assert len(stats) == dc_core.EVENT_TYPE_COUNT
+            chat = stats[dc_core.EVENT_CHAT_MESSAGE]
+            assert chat.policy == dc_core.POLICY_RATE_LIMIT
+            assert chat.ratePerSecond == 5
+            assert (bridge.getEventPolicy(dc_core.EVENT_SEARCH_RESULT)
+                    == dc_core.POLICY_DROP)
+        finally:
+            bridge.resetEventPolicies()
+        assert all(s.policy == dc_core.POLICY_DELIVER and s.dropped == 0
+                   for s in bridge.getEventPolicyStats())
+
+    def test_event_fd(self):
+        """The wakeup descriptor is stable and idle while nothing is queued."""
+        import select
+        bridge = dc_core.DCBridge()
+        fd = bridge.getEventFd()
+        assert fd >= 0
+        assert bridge.getEventFd() == fd
+        bridge.pollEvents(0)
+        readable, _, _ = select.select([fd], [], [], 0)
+        assert readable == []
+
+    def test_poll_empty(self):
+        """pollEvents returns nothing when no events were queued."""
+        bridge = dc_core.DCBridge()
+        assert len(bridge.pollEvents(100)) == 0
+
+    def test_switch_mode(self):
+        """Queued mode allocates the ring and reports its capacity."""
+        bridge = dc_core.DCBridge()
+        try:
+            bridge.setDispatchMode(dc_core.DISPATCH_QUEUED, 1000)
+            assert bridge.getDispatchMode() == dc_core.DISPATCH_QUEUED
+            stats = bridge.getEventQueueStats()
+            assert stats.capacity >= 1000
+            assert stats.dropped == 0
+        finally:
+            bridge.setDispatchMode(dc_core.DISPATCH_DIRECT)
+        assert bridge.getDispatchMode() == dc_core.DISPATCH_DIRECT
+
+    def test_user_event_coalescing_toggle(self):
+        """User-event coalescing is opt-in and can be switched off again."""
+        bridge = dc_core.DCBridge()
+        assert not bridge.getUserEventCoalescing()
+        try:
+            bridge.setUserEventCoalescing(True)
+            assert bridge.getUserEventCoalescing()
+        finally:
+            bridge.setUserEventCoalescing(False)
+        assert not bridge.getUserEventCoalescing()
+
+
 # ============================================================================
 # Thread safety tests
 # ============================================================================
@@ -474,14 +959,63 @@ class TestDCClientWrapper:
             "hub_nick_taken", "hub_full",
             "chat_message", "private_message", "status_message",
             "user_connected", "user_disconnected", "user_updated",
+            "users_updated", "users_connected", "users_removed",
             "search_result",
             "queue_item_added", "queue_item_finished", "queue_item_removed",
+            "queue_items_added", "queue_items_removed",
             "download_starting", "download_complete", "download_failed",
-            "upload_starting", "upload_complete",
-            "hash_progress",
+            "upload_starting", "upload_complete", "transfer_progress",
+            "file_list_progress", "file_list_loaded",
+            "hash_progress", "core_ready",
         }
         assert expected == EVENT_TYPES
 
+    def test_dc_client_init_phase(self, unique_config_dir):
+        """init_phase is 'none' and wait_ready times out before a start."""
+        from eiskaltdcpp.dc_client import DCClient
+        client = DCClient(str(unique_config_dir))
+        assert client.init_phase == "none"
+        assert client.init_step == ""
+        assert client.wait_ready(0) is False
+
+    def test_dc_client_event_policy(self, unique_config_dir):
+        """set_event_policy maps names and rejects bad input."""
+        from eiskaltdcpp.dc_client import DCClient
+        client = DCClient(str(unique_config_dir))
+        try:
+            client.set_event_policy("chat_message", "rate_limit", 10)
+            client.set_event_policy("status_message", "drop")
+            stats = client.event_policy_stats
+            assert stats["chat_message"]["policy"] == "rate_limit"
+            assert stats["chat_message"]["rate"] == 10
+            assert stats["status_message"]["policy"] == "drop"
+            with pytest.raises(ValueError):
+                client.set_event_policy("nonexistent_event", "drop")
+            with pytest.raises(ValueError):
+                client.set_event_policy("chat_message", "ignore")
+            with pytest.raises(ValueError):
+                client.set_event_policy("chat_message", "rate_limit")
+        finally:
+            client.reset_event_policies()
+        assert client.event_policy_stats["chat_message"]["policy"] == "deliver"
+
+    def test_event_mask_helpers(self):
+        """event_mask maps names (batches share bits); overrides are found."""
+        from eiskaltdcpp.dc_client import callback_event_mask, event_mask
+        assert event_mask(["chat_message"]) == 1 << dc_core.EVENT_CHAT_MESSAGE
+        assert (event_mask(["users_updated"])
+                == event_mask(["user_updated"]))
+        assert (event_mask(["users_connected"])
+                == event_mask(["user_connected"]))
+        with pytest.raises(ValueError):
+            event_mask(["nonexistent_event"])
+
+        class ChatBot(dc_core.DCClientCallback):
+            def onChatMessage(self, hubUrl, nick, message, thirdPerson):
+                pass
+
+        assert callback_event_mask(ChatBot()) == event_mask(["chat_message"])
+
     def test_dc_client_on_decorator(self, unique_config_dir):
         """The @client.on('event') decorator pattern works."""
         from eiskaltdcpp.dc_client import DCClient